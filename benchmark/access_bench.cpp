@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "bench.hpp"
+#include <cstdint>
+#include <vector>
+#include <lean/checked.hpp>
+#include <lean/memory.hpp>
+#include <lean/optional.hpp>
+#include <lean/variant.hpp>
+
+// Checked accessors, whose throw paths are kept cold, compared with their
+// unchecked counterparts.
+
+namespace
+{
+
+constexpr std::size_t size = 1024;
+
+} // anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    bench::runner runner(argc, argv);
+
+    std::vector<lean::optional<int>> optionals(size, lean::optional<int>(1));
+
+    runner.run("optional.value",
+               [&optionals] (std::size_t iterations) {
+                   int total = 0;
+                   for (std::size_t i = 0; i < iterations; ++i)
+                       total += optionals[i % size].value();
+                   bench::do_not_optimize(total);
+               });
+
+    runner.run("optional.dereference",
+               [&optionals] (std::size_t iterations) {
+                   int total = 0;
+                   for (std::size_t i = 0; i < iterations; ++i)
+                       total += *optionals[i % size];
+                   bench::do_not_optimize(total);
+               });
+
+    std::vector<lean::variant<int, float>> variants(size, lean::variant<int, float>(1));
+
+    runner.run("variant.get",
+               [&variants] (std::size_t iterations) {
+                   int total = 0;
+                   for (std::size_t i = 0; i < iterations; ++i)
+                       total += lean::get<int>(variants[i % size]);
+                   bench::do_not_optimize(total);
+               });
+
+    runner.run("variant.get_if",
+               [&variants] (std::size_t iterations) {
+                   int total = 0;
+                   for (std::size_t i = 0; i < iterations; ++i)
+                       total += *lean::get_if<int>(&variants[i % size]);
+                   bench::do_not_optimize(total);
+               });
+
+    std::vector<std::int32_t> numbers(size, 1);
+
+    runner.run("add.checked",
+               [&numbers] (std::size_t iterations) {
+                   std::int32_t total = 0;
+                   for (std::size_t i = 0; i < iterations; ++i)
+                       total = lean::add<lean::checked>(total & 0xFFFF, numbers[i % size]);
+                   bench::do_not_optimize(total);
+               });
+
+    runner.run("add.unchecked",
+               [&numbers] (std::size_t iterations) {
+                   std::int32_t total = 0;
+                   for (std::size_t i = 0; i < iterations; ++i)
+                       total = lean::add<lean::unchecked>(total & 0xFFFF, numbers[i % size]);
+                   bench::do_not_optimize(total);
+               });
+
+    lean::inplace_storage<16 * sizeof(int), alignof(int)> storage;
+    for (std::size_t index = 0; index < 16; ++index)
+        storage.at<int, lean::unchecked>(index) = 1;
+
+    runner.run("inplace_storage.at.checked",
+               [&storage] (std::size_t iterations) {
+                   int total = 0;
+                   for (std::size_t i = 0; i < iterations; ++i)
+                       total += storage.at<int, lean::checked>(i % 16);
+                   bench::do_not_optimize(total);
+               });
+
+    runner.run("inplace_storage.at.unchecked",
+               [&storage] (std::size_t iterations) {
+                   int total = 0;
+                   for (std::size_t i = 0; i < iterations; ++i)
+                       total += storage.at<int, lean::unchecked>(i % 16);
+                   bench::do_not_optimize(total);
+               });
+
+    return runner.finish();
+}
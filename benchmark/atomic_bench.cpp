@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "bench.hpp"
+#include <lean/atomic.hpp>
+
+// Built with lean-core and with LEAN_HEADER_ONLY
+
+int main(int argc, char *argv[])
+{
+    bench::runner runner(argc, argv);
+
+#if LEAN_CXX >= LEAN_LIB_ATOMIC_WAIT
+
+    lean::atomic<int> shared{ 0 };
+
+    // Notification without waiters
+    runner.run("atomic.notify_one",
+               [&shared] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       shared.store(int(i), std::memory_order_release);
+                       shared.notify_one();
+                   }
+               });
+
+    runner.run("atomic.notify_all",
+               [&shared] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       shared.store(int(i), std::memory_order_release);
+                       shared.notify_all();
+                   }
+               });
+
+    // Value already differs, so wait returns without blocking
+    runner.run("atomic.wait_changed",
+               [&shared] (std::size_t iterations) {
+                   shared.store(1);
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       shared.wait(0);
+                       bench::clobber_memory();
+                   }
+               });
+
+#endif
+
+    return runner.finish();
+}
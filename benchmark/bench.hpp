@@ -0,0 +1,623 @@
+#ifndef LEAN_BENCH_HPP
+#define LEAN_BENCH_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Microbenchmark harness
+//
+// A benchmark is a callable that performs an operation a given number of
+// times. The runner warms it up, chooses the number of iterations so each
+// sample spans many clock ticks, and reports percentiles of the time per
+// operation. Where hardware counters are available, the number of retired
+// instructions per operation is reported as well.
+//
+//   int main(int argc, char *argv[])
+//   {
+//       bench::runner runner(argc, argv);
+//       runner.run("name", [] (std::size_t iterations) {
+//           for (std::size_t i = 0; i < iterations; ++i)
+//               bench::do_not_optimize(operation());
+//       });
+//       return runner.finish();
+//   }
+//
+// Quantities other than time, such as memory footprint, are reported with
+// runner.report(name, value, unit).
+//
+// Options:
+//
+//   --json FILE     Writes results to FILE.
+//   --compare FILE  Prints the change in median, and the instructions per
+//                   operation, against results in FILE.
+//   --filter TEXT   Only runs benchmarks whose name contains TEXT.
+//   --samples N     Number of timed samples (default 1000).
+//   --cpu N         Pins the thread to CPU N, or -1 to not pin (Linux). The
+//                   default is the CPU the runner starts on.
+//   --clock NAME    Uses "tsc" (default on x86) or "steady".
+//
+// Samples above the third quartile plus three interquartile ranges are
+// rejected as interruptions before percentiles are computed.
+//
+// Threads created by a benchmark inherit the CPU affinity of the runner.
+// Threads that must run on other CPUs call bench::unpin_thread().
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+# include <linux/perf_event.h>
+# include <sched.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# define LEAN_BENCH_HAS_PERF 1
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# include <x86intrin.h>
+# define LEAN_BENCH_HAS_TSC 1
+#endif
+
+namespace bench
+{
+
+//-----------------------------------------------------------------------------
+// Optimization barriers
+
+#if defined(__GNUC__)
+
+//! @brief Forces value to be computed and stored in memory.
+
+template <typename T>
+void do_not_optimize(T&& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+//! @brief Forces pending writes to memory to be completed.
+
+inline void clobber_memory()
+{
+    asm volatile("" : : : "memory");
+}
+
+#else
+
+template <typename T>
+void do_not_optimize(T&& value)
+{
+    static const void * volatile sink;
+    sink = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+inline void clobber_memory()
+{
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+#endif
+
+//! @brief Allows the calling thread to run on any CPU.
+
+inline void unpin_thread()
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        CPU_SET(cpu, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Results
+
+struct result
+{
+    std::string name;
+    std::size_t iterations;
+    std::size_t samples;
+    std::size_t rejected;
+    // Nanoseconds per operation
+    double min;
+    double mean;
+    double p50;
+    double p99;
+    double p999;
+    // Retired instructions per operation, or negative if unavailable
+    double instructions;
+};
+
+struct metric
+{
+    std::string name;
+    double value;
+    std::string unit;
+};
+
+namespace detail
+{
+
+inline std::uint64_t steady_ticks() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#if defined(LEAN_BENCH_HAS_TSC)
+
+// Fences keep the timed instructions between the two readings
+
+inline std::uint64_t tsc_start() noexcept
+{
+    _mm_lfence();
+    auto result = __rdtsc();
+    _mm_lfence();
+    return result;
+}
+
+inline std::uint64_t tsc_stop() noexcept
+{
+    unsigned int aux;
+    auto result = __rdtscp(&aux);
+    _mm_lfence();
+    return result;
+}
+
+#endif
+
+// Counts instructions retired in user space by the calling thread
+class instruction_counter
+{
+public:
+    instruction_counter() noexcept
+    {
+#if defined(LEAN_BENCH_HAS_PERF)
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+    }
+
+    instruction_counter(const instruction_counter&) = delete;
+    instruction_counter& operator=(const instruction_counter&) = delete;
+
+    ~instruction_counter()
+    {
+#if defined(LEAN_BENCH_HAS_PERF)
+        if (valid())
+            close(descriptor);
+#endif
+    }
+
+    bool valid() const noexcept
+    {
+        return descriptor >= 0;
+    }
+
+    void start() noexcept
+    {
+#if defined(LEAN_BENCH_HAS_PERF)
+        ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    std::uint64_t stop() noexcept
+    {
+        std::uint64_t count = 0;
+#if defined(LEAN_BENCH_HAS_PERF)
+        ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(descriptor, &count, sizeof(count)) != sizeof(count))
+            count = 0;
+#endif
+        return count;
+    }
+
+private:
+    int descriptor = -1;
+};
+
+// Nearest-rank percentile of sorted data
+inline double percentile(const std::vector<double>& sorted, double fraction)
+{
+    auto rank = static_cast<std::size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::max<std::size_t>(rank, 1) - 1];
+}
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+// runner
+
+class runner
+{
+public:
+    runner(int argc, char *argv[])
+    {
+#if defined(LEAN_BENCH_HAS_TSC)
+        use_tsc = true;
+#endif
+#if defined(__linux__)
+        cpu = sched_getcpu();
+#endif
+        for (int i = 1; i < argc; ++i)
+        {
+            const char *option = argv[i];
+            const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value)
+            {
+                usage(argv[0]);
+            }
+            else if (!std::strcmp(option, "--json"))
+                json_path = value;
+            else if (!std::strcmp(option, "--compare"))
+                compare_path = value;
+            else if (!std::strcmp(option, "--filter"))
+                filter = value;
+            else if (!std::strcmp(option, "--samples"))
+                sample_count = std::max(std::atoi(value), 1);
+            else if (!std::strcmp(option, "--cpu"))
+                cpu = std::atoi(value);
+            else if (!std::strcmp(option, "--clock"))
+                use_tsc = use_tsc && std::strcmp(value, "steady");
+            else
+                usage(argv[0]);
+            ++i;
+        }
+        pin();
+        calibrate();
+        std::printf("clock: %s (%.3f ticks/ns, overhead %.1f ns), cpu: %d\n",
+                    clock_name(), ticks_per_ns, overhead / ticks_per_ns, cpu);
+        std::printf("%-40s %10s %10s %10s %10s %9s %9s\n",
+                    "benchmark (ns/op)", "min", "p50", "p99", "p999", "rejected", "instr");
+    }
+
+    //! @brief Measures function(iterations).
+
+    template <typename F>
+    void run(const std::string& name, F&& function)
+    {
+        if (name.find(filter) == std::string::npos)
+            return;
+
+        // Warmup while doubling the iterations until a sample spans at
+        // least 10 microseconds.
+        const double sample_ticks = 10000.0 * ticks_per_ns;
+        const double warmup_ticks = 50000000.0 * ticks_per_ns;
+        std::size_t iterations = 1;
+        double elapsed = 0.0;
+        for (;;)
+        {
+            double ticks = measure(function, iterations);
+            elapsed += ticks;
+            if (ticks >= sample_ticks)
+                break;
+            iterations *= 2;
+        }
+        while (elapsed < warmup_ticks)
+        {
+            elapsed += measure(function, iterations);
+        }
+
+        std::vector<double> samples;
+        samples.reserve(sample_count);
+        for (int i = 0; i < sample_count; ++i)
+        {
+            double ticks = std::max(measure(function, iterations) - overhead, 0.0);
+            samples.push_back(ticks / ticks_per_ns / iterations);
+        }
+        std::sort(samples.begin(), samples.end());
+
+        const double q1 = detail::percentile(samples, 0.25);
+        const double q3 = detail::percentile(samples, 0.75);
+        const double fence = q3 + 3.0 * (q3 - q1);
+        const std::size_t total = samples.size();
+        samples.erase(std::upper_bound(samples.begin(), samples.end(), fence), samples.end());
+
+        result entry;
+        entry.name = name;
+        entry.iterations = iterations;
+        entry.samples = samples.size();
+        entry.rejected = total - samples.size();
+        entry.min = samples.front();
+        double sum = 0.0;
+        for (auto sample : samples)
+            sum += sample;
+        entry.mean = sum / samples.size();
+        entry.p50 = detail::percentile(samples, 0.5);
+        entry.p99 = detail::percentile(samples, 0.99);
+        entry.p999 = detail::percentile(samples, 0.999);
+        entry.instructions = count_instructions(function, iterations);
+
+        std::printf("%-40s %10.2f %10.2f %10.2f %10.2f %9zu",
+                    entry.name.c_str(), entry.min, entry.p50, entry.p99, entry.p999, entry.rejected);
+        if (entry.instructions < 0.0)
+            std::printf(" %9s\n", "-");
+        else
+            std::printf(" %9.1f\n", entry.instructions);
+        results.push_back(std::move(entry));
+    }
+
+    //! @brief Reports a quantity other than time.
+
+    void report(const std::string& name, double value, const std::string& unit)
+    {
+        if (name.find(filter) == std::string::npos)
+            return;
+        std::printf("%-40s %10.0f %s\n", name.c_str(), value, unit.c_str());
+        metrics.push_back({ name, value, unit });
+    }
+
+    //! @brief Writes and compares results.
+    //!
+    //! Returns the exit code for main.
+
+    int finish()
+    {
+        if (!json_path.empty() && !write_json())
+        {
+            std::fprintf(stderr, "cannot write %s\n", json_path.c_str());
+            return EXIT_FAILURE;
+        }
+        if (!compare_path.empty() && !compare())
+        {
+            std::fprintf(stderr, "cannot read %s\n", compare_path.c_str());
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    const std::vector<result>& get_results() const noexcept
+    {
+        return results;
+    }
+
+private:
+    [[noreturn]] static void usage(const char *program)
+    {
+        std::fprintf(stderr,
+                     "usage: %s [--json FILE] [--compare FILE] [--filter TEXT]"
+                     " [--samples N] [--cpu N] [--clock tsc|steady]\n",
+                     program);
+        std::exit(EXIT_FAILURE);
+    }
+
+    const char *clock_name() const noexcept
+    {
+        return use_tsc ? "tsc" : "steady";
+    }
+
+    std::uint64_t start() const noexcept
+    {
+#if defined(LEAN_BENCH_HAS_TSC)
+        if (use_tsc)
+            return detail::tsc_start();
+#endif
+        return detail::steady_ticks();
+    }
+
+    std::uint64_t stop() const noexcept
+    {
+#if defined(LEAN_BENCH_HAS_TSC)
+        if (use_tsc)
+            return detail::tsc_stop();
+#endif
+        return detail::steady_ticks();
+    }
+
+    template <typename F>
+    double measure(F& function, std::size_t iterations)
+    {
+        auto begin = start();
+        function(iterations);
+        auto end = stop();
+        return double(end - begin);
+    }
+
+    // Fewest instructions of several runs, less the counter overhead
+    template <typename F>
+    double count_instructions(F& function, std::size_t iterations)
+    {
+        if (!counter.valid())
+            return -1.0;
+        std::uint64_t fewest = UINT64_MAX;
+        for (int i = 0; i < 10; ++i)
+        {
+            counter.start();
+            function(iterations);
+            fewest = std::min(fewest, counter.stop());
+        }
+        const double count = double(fewest) - double(counter_overhead);
+        return std::max(count, 0.0) / iterations;
+    }
+
+    void pin()
+    {
+#if defined(__linux__)
+        if (cpu < 0)
+            return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0)
+        {
+            std::fprintf(stderr, "cannot pin to cpu %d\n", cpu);
+            cpu = -1;
+        }
+#else
+        cpu = -1;
+#endif
+    }
+
+    // Measures tick rate against the steady clock, and the cost of an
+    // empty measurement.
+    void calibrate()
+    {
+        if (use_tsc)
+        {
+            auto steady_begin = detail::steady_ticks();
+            auto begin = start();
+            while (detail::steady_ticks() - steady_begin < 20000000)
+            {
+            }
+            auto end = stop();
+            auto steady_end = detail::steady_ticks();
+            ticks_per_ns = double(end - begin) / double(steady_end - steady_begin);
+        }
+        else
+        {
+            ticks_per_ns = 1.0;
+        }
+
+        auto empty = [] (std::size_t) {};
+        overhead = measure(empty, 1);
+        for (int i = 0; i < 1000; ++i)
+        {
+            overhead = std::min(overhead, measure(empty, 1));
+        }
+        if (counter.valid())
+        {
+            counter_overhead = UINT64_MAX;
+            for (int i = 0; i < 100; ++i)
+            {
+                counter.start();
+                empty(1);
+                counter_overhead = std::min(counter_overhead, counter.stop());
+            }
+        }
+    }
+
+    static std::string escape(const std::string& text)
+    {
+        std::string output;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                output += '\\';
+            output += c;
+        }
+        return output;
+    }
+
+    // One benchmark per line, so results can be compared line by line
+    bool write_json() const
+    {
+        std::FILE *file = std::fopen(json_path.c_str(), "w");
+        if (!file)
+            return false;
+        std::fprintf(file,
+                     "{\n  \"clock\": \"%s\",\n  \"ticks_per_ns\": %.6f,\n  \"cpu\": %d,\n  \"benchmarks\": [\n",
+                     clock_name(), ticks_per_ns, cpu);
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& entry = results[i];
+            std::fprintf(file,
+                         "    {\"name\": \"%s\", \"iterations\": %zu, \"samples\": %zu, \"rejected\": %zu,"
+                         " \"min\": %.3f, \"mean\": %.3f, \"p50\": %.3f, \"p99\": %.3f, \"p999\": %.3f,"
+                         " \"instructions\": %.1f}%s\n",
+                         escape(entry.name).c_str(), entry.iterations, entry.samples, entry.rejected,
+                         entry.min, entry.mean, entry.p50, entry.p99, entry.p999, entry.instructions,
+                         (i + 1 < results.size()) ? "," : "");
+        }
+        std::fprintf(file, "  ],\n  \"metrics\": [\n");
+        for (std::size_t i = 0; i < metrics.size(); ++i)
+        {
+            const auto& entry = metrics[i];
+            std::fprintf(file,
+                         "    {\"name\": \"%s\", \"value\": %.0f, \"unit\": \"%s\"}%s\n",
+                         escape(entry.name).c_str(), entry.value, escape(entry.unit).c_str(),
+                         (i + 1 < metrics.size()) ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+
+    bool compare() const
+    {
+        std::FILE *file = std::fopen(compare_path.c_str(), "r");
+        if (!file)
+            return false;
+        std::printf("\n%-40s %10s %10s %9s %9s %9s\n",
+                    "benchmark (p50 ns/op)", "baseline", "current", "change", "instr was", "instr now");
+        char line[1024];
+        while (std::fgets(line, sizeof(line), file))
+        {
+            const char *name = std::strstr(line, "\"name\": \"");
+            const char *median = std::strstr(line, "\"p50\": ");
+            if (!name || !median)
+                continue;
+            name += std::strlen("\"name\": \"");
+            const char *name_end = std::strstr(name, "\", ");
+            if (!name_end)
+                continue;
+            const std::string key(name, name_end);
+            const double baseline = std::atof(median + std::strlen("\"p50\": "));
+            const char *instructions = std::strstr(line, "\"instructions\": ");
+            const double baseline_instructions = instructions
+                ? std::atof(instructions + std::strlen("\"instructions\": "))
+                : -1.0;
+            for (const auto& entry : results)
+            {
+                if (escape(entry.name) != key)
+                    continue;
+                std::printf("%-40s %10.2f %10.2f %+8.1f%%",
+                            entry.name.c_str(), baseline, entry.p50,
+                            (baseline > 0.0) ? 100.0 * (entry.p50 - baseline) / baseline : 0.0);
+                if ((baseline_instructions < 0.0) || (entry.instructions < 0.0))
+                    std::printf(" %9s %9s\n", "-", "-");
+                else
+                    std::printf(" %9.1f %9.1f\n", baseline_instructions, entry.instructions);
+            }
+        }
+        std::fclose(file);
+        return true;
+    }
+
+private:
+    std::string json_path;
+    std::string compare_path;
+    std::string filter;
+    int sample_count = 1000;
+    int cpu = -1;
+    bool use_tsc = false;
+    double ticks_per_ns = 1.0;
+    double overhead = 0.0;
+    detail::instruction_counter counter;
+    std::uint64_t counter_overhead = 0;
+    std::vector<result> results;
+    std::vector<metric> metrics;
+};
+
+} // namespace bench
+
+#undef LEAN_BENCH_HAS_TSC
+#undef LEAN_BENCH_HAS_PERF
+
+#endif // LEAN_BENCH_HPP
@@ -0,0 +1,89 @@
+###############################################################################
+#
+# Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+#
+# Distributed under the Boost Software License, Version 1.0.
+#    (See accompanying file LICENSE_1_0.txt or copy at
+#          http://www.boost.org/LICENSE_1_0.txt)
+#
+###############################################################################
+
+# Generates a translation unit for the compile-time benchmark.
+#
+#   cmake -DKIND=<kind> -DCOUNT=<count> -DOUTPUT=<file> -P generate.cmake
+#
+# function_type, function_arguments and invoke_result instantiate COUNT
+# distinct signatures. type_max_with, type_contains and type_element are
+# queried with packs of COUNT distinct types, which measures their recursion
+# depth.
+# baseline only includes the headers.
+
+foreach(variable KIND COUNT OUTPUT)
+  if (NOT DEFINED ${variable})
+    message(FATAL_ERROR "${variable} is not defined")
+  endif()
+endforeach()
+
+set(content "// Generated by generate.cmake (${KIND}, ${COUNT})
+
+#include <type_traits>
+#include <lean/detail/invoke_traits.hpp>
+#include <lean/function_traits.hpp>
+#include <lean/type_traits.hpp>
+
+template <int N> struct tag { char data[N + 8]; };
+template <typename...> struct pack {};
+
+")
+
+math(EXPR last "${COUNT} - 1")
+
+if (KIND STREQUAL "baseline")
+
+elseif (KIND STREQUAL "function_type")
+  foreach(index RANGE ${last})
+    string(APPEND content "static_assert(std::is_same<lean::function_type_t<tag<${index}>(tag<${index}>, int) const &>, tag<${index}>(tag<${index}>, int) const &>::value, \"\");\n")
+  endforeach()
+
+elseif (KIND STREQUAL "function_arguments")
+  foreach(index RANGE ${last})
+    string(APPEND content "static_assert(std::is_same<lean::function_arguments_t<pack, tag<${index}>(tag<${index}>, int)>, pack<tag<${index}>, int>>::value, \"\");\n")
+  endforeach()
+
+elseif (KIND STREQUAL "invoke_result")
+  foreach(index RANGE ${last})
+    string(APPEND content "static_assert(std::is_same<lean::v1::invoke_result_t<tag<${index}> (*)(tag<${index}>, int), tag<${index}>, int>, tag<${index}>>::value, \"\");\n")
+  endforeach()
+
+elseif (KIND STREQUAL "type_max_with" OR KIND STREQUAL "type_contains" OR KIND STREQUAL "type_element")
+  set(types "tag<0>")
+  foreach(index RANGE 1 ${last})
+    string(APPEND types ", tag<${index}>")
+  endforeach()
+  if (KIND STREQUAL "type_max_with")
+    string(APPEND content "static_assert(std::is_same<lean::type_max_with_t<lean::type_sizeof, ${types}>, tag<${last}>>::value, \"\");\n")
+  elseif (KIND STREQUAL "type_element")
+    math(EXPR middle "${COUNT} / 2")
+    string(APPEND content "static_assert(std::is_same<lean::type_element_t<0, ${types}>, tag<0>>::value, \"\");\n")
+    string(APPEND content "static_assert(std::is_same<lean::type_element_t<${middle}, ${types}>, tag<${middle}>>::value, \"\");\n")
+    string(APPEND content "static_assert(std::is_same<lean::type_element_t<${last}, ${types}>, tag<${last}>>::value, \"\");\n")
+  else()
+    string(APPEND content "static_assert(lean::type_contains<tag<0>, ${types}>::value, \"\");\n")
+    string(APPEND content "static_assert(lean::type_contains<tag<${last}>, ${types}>::value, \"\");\n")
+    string(APPEND content "static_assert(!lean::type_contains<void, ${types}>::value, \"\");\n")
+  endif()
+
+else()
+  message(FATAL_ERROR "Unknown kind ${KIND}")
+endif()
+
+string(APPEND content "\nint main()\n{\n    return 0;\n}\n")
+
+# Avoid touching unchanged files
+if (EXISTS ${OUTPUT})
+  file(READ ${OUTPUT} existing)
+  if (existing STREQUAL content)
+    return()
+  endif()
+endif()
+file(WRITE ${OUTPUT} "${content}")
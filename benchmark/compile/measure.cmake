@@ -0,0 +1,81 @@
+###############################################################################
+#
+# Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+#
+# Distributed under the Boost Software License, Version 1.0.
+#    (See accompanying file LICENSE_1_0.txt or copy at
+#          http://www.boost.org/LICENSE_1_0.txt)
+#
+###############################################################################
+
+# Compiles each source and records time and memory.
+#
+# Memory is the maximum resident set size when GNU time is available, and
+# otherwise the GCC garbage-collected memory from -ftime-report.
+
+cmake_minimum_required(VERSION 3.8)
+
+foreach(variable COMPILER COMPILER_ID STANDARD INCLUDE SOURCES WORK_DIR OUTPUT)
+  if (NOT DEFINED ${variable})
+    message(FATAL_ERROR "${variable} is not defined")
+  endif()
+endforeach()
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+set(report "source,seconds,memory_kb\n")
+foreach(source ${SOURCES})
+  get_filename_component(name ${source} NAME_WE)
+  set(object ${WORK_DIR}/${name}.o)
+  set(command ${COMPILER} -std=c++${STANDARD} -I${INCLUDE} -c ${source} -o ${object})
+  if (COMPILER_ID MATCHES "Clang")
+    list(APPEND command -ftime-trace)
+  endif()
+
+  set(seconds "")
+  set(memory "")
+  if (TIME)
+    set(usage ${WORK_DIR}/${name}.time)
+    execute_process(
+      COMMAND ${TIME} -f "%e %M" -o ${usage} ${command}
+      RESULT_VARIABLE result
+      ERROR_VARIABLE errors)
+    if (result EQUAL 0)
+      file(READ ${usage} usage)
+      string(REGEX MATCH "([0-9.]+) ([0-9]+)" usage "${usage}")
+      set(seconds ${CMAKE_MATCH_1})
+      set(memory ${CMAKE_MATCH_2})
+    endif()
+  elseif (COMPILER_ID STREQUAL "GNU")
+    execute_process(
+      COMMAND ${command} -ftime-report
+      RESULT_VARIABLE result
+      ERROR_VARIABLE errors)
+    if (result EQUAL 0)
+      # TOTAL : user system wall memory
+      string(REGEX MATCH "TOTAL *: *[0-9.]+ *[0-9.]+ *([0-9.]+) *([0-9]+)([kM])" total "${errors}")
+      set(seconds ${CMAKE_MATCH_1})
+      set(memory ${CMAKE_MATCH_2})
+      if (CMAKE_MATCH_3 STREQUAL "M")
+        math(EXPR memory "${memory} * 1024")
+      endif()
+    endif()
+  else()
+    string(TIMESTAMP start "%s")
+    execute_process(
+      COMMAND ${command}
+      RESULT_VARIABLE result
+      ERROR_VARIABLE errors)
+    string(TIMESTAMP stop "%s")
+    math(EXPR seconds "${stop} - ${start}")
+  endif()
+
+  if (NOT result EQUAL 0)
+    message(FATAL_ERROR "Compilation of ${source} failed:\n${errors}")
+  endif()
+  message(STATUS "${name}: ${seconds} s, ${memory} kB")
+  string(APPEND report "${name},${seconds},${memory}\n")
+endforeach()
+
+file(WRITE ${OUTPUT} "${report}")
+message(STATUS "Results written to ${OUTPUT}")
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "bench.hpp"
+#include <string>
+#include <lean/expected.hpp>
+
+// Error reporting with expected compared with exceptions at different error
+// rates.
+
+namespace
+{
+
+LEAN_ATTRIBUTE_NOINLINE
+lean::expected<int, int> parse_expected(std::size_t input, std::size_t period)
+{
+    if (input % period == 0)
+        return lean::make_unexpected(int(input));
+    return int(input);
+}
+
+LEAN_ATTRIBUTE_NOINLINE
+int parse_exception(std::size_t input, std::size_t period)
+{
+    if (input % period == 0)
+        throw int(input);
+    return int(input);
+}
+
+void error_rate(bench::runner& runner, std::size_t period)
+{
+    const std::string suffix = ".error_1_in_" + std::to_string(period);
+
+    runner.run("expected" + suffix,
+               [period] (std::size_t iterations) {
+                   int total = 0;
+                   for (std::size_t i = 1; i <= iterations; ++i)
+                   {
+                       auto result = parse_expected(i, period);
+                       total += result ? *result : result.error();
+                   }
+                   bench::do_not_optimize(total);
+               });
+
+    runner.run("exception" + suffix,
+               [period] (std::size_t iterations) {
+                   int total = 0;
+                   for (std::size_t i = 1; i <= iterations; ++i)
+                   {
+                       try
+                       {
+                           total += parse_exception(i, period);
+                       }
+                       catch (int error)
+                       {
+                           total += error;
+                       }
+                   }
+                   bench::do_not_optimize(total);
+               });
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    bench::runner runner(argc, argv);
+
+    // Period 1 fails every call, and a large period almost never fails
+    for (std::size_t period : { std::size_t(1000000000), std::size_t(1000), std::size_t(100), std::size_t(10), std::size_t(2), std::size_t(1) })
+    {
+        error_rate(runner, period);
+    }
+
+    return runner.finish();
+}
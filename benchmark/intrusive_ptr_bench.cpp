@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "bench.hpp"
+#include <memory>
+#include <thread>
+#include <lean/intrusive_ptr.hpp>
+
+// Reference counting of intrusive_ptr compared with std::shared_ptr
+
+namespace
+{
+
+struct shared_node
+{
+    int value = 0;
+};
+
+template <typename Policy>
+struct intrusive_node : lean::ref_counted<intrusive_node<Policy>, Policy>
+{
+    int value = 0;
+};
+
+template <typename Pointer>
+void copy(bench::runner& runner, const char *name, const Pointer& pointer)
+{
+    runner.run(name,
+               [&pointer] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       Pointer other = pointer;
+                       bench::do_not_optimize(other);
+                   }
+               });
+}
+
+template <typename F>
+void make(bench::runner& runner, const char *name, F&& factory)
+{
+    runner.run(name,
+               [&factory] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       auto pointer = factory();
+                       bench::do_not_optimize(pointer);
+                   }
+               });
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    bench::runner runner(argc, argv);
+
+    // std::shared_ptr uses plain increments until the process has started
+    // a thread, so start one to compare thread-safe counting.
+    std::thread([] {}).join();
+
+    using safe_node = intrusive_node<lean::thread_safe>;
+    using unsafe_node = intrusive_node<lean::thread_unsafe>;
+
+    copy(runner, "intrusive_ptr.copy.thread_safe", lean::make_intrusive<safe_node>());
+    copy(runner, "intrusive_ptr.copy.thread_unsafe", lean::make_intrusive<unsafe_node>());
+    copy(runner, "shared_ptr.copy", std::make_shared<shared_node>());
+
+    make(runner, "intrusive_ptr.make.thread_safe", [] { return lean::make_intrusive<safe_node>(); });
+    make(runner, "intrusive_ptr.make.thread_unsafe", [] { return lean::make_intrusive<unsafe_node>(); });
+    make(runner, "shared_ptr.make", [] { return std::make_shared<shared_node>(); });
+
+    return runner.finish();
+}
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "bench.hpp"
+#include <lean/latency_histogram.hpp>
+
+int main(int argc, char *argv[])
+{
+    bench::runner runner(argc, argv);
+
+    lean::latency_histogram histogram;
+
+    runner.run("latency_histogram.record",
+               [&histogram] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       histogram.record(i * 37);
+                   }
+               });
+
+    lean::latency_histogram other;
+    runner.run("latency_histogram.merge",
+               [&histogram, &other] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       other.merge(histogram);
+                   }
+               });
+
+    runner.run("latency_histogram.percentile",
+               [&histogram] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       bench::do_not_optimize(histogram.percentile(99.0));
+                   }
+               });
+
+    runner.run("latency_histogram.serialize",
+               [&histogram] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       bench::do_not_optimize(histogram.serialize());
+                   }
+               });
+
+    return runner.finish();
+}
@@ -0,0 +1,219 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "bench.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <lean/epoch.hpp>
+#include <lean/hazard_pointer.hpp>
+
+// Read-mostly map with concurrent readers
+//
+// Writers copy the map, update the copy, and publish it. The replaced map
+// is retired to the reclamation domain. The timed thread looks up keys while
+// other readers do the same on other CPUs, and a writer publishes a new map
+// every 100 microseconds. A mutex-protected map updated in place is the
+// baseline.
+//
+// The reported time is per lookup on the timed thread, so flat results
+// across reader counts mean that the read side scales.
+
+namespace
+{
+
+using map_type = std::unordered_map<std::uint32_t, std::uint32_t>;
+
+constexpr std::uint32_t key_count = 1024;
+constexpr std::chrono::microseconds write_interval(100);
+
+map_type make_map()
+{
+    map_type result;
+    for (std::uint32_t key = 0; key < key_count; ++key)
+        result.emplace(key, key);
+    return result;
+}
+
+struct epoch_map
+{
+    epoch_map()
+        : current(new map_type(make_map()))
+    {
+    }
+
+    ~epoch_map()
+    {
+        delete current.load();
+    }
+
+    struct reader
+    {
+        explicit reader(epoch_map& map)
+            : map(map)
+        {
+        }
+
+        std::uint32_t find(std::uint32_t key)
+        {
+            auto guard = map.domain.pin();
+            return map.current.load(std::memory_order_acquire)->find(key)->second;
+        }
+
+        epoch_map& map;
+    };
+
+    void update(std::uint32_t key)
+    {
+        auto replacement = new map_type(*current.load(std::memory_order_acquire));
+        ++(*replacement)[key];
+        domain.retire(current.exchange(replacement, std::memory_order_acq_rel));
+    }
+
+    lean::epoch_domain domain;
+    std::atomic<map_type *> current;
+};
+
+struct hazard_pointer_map
+{
+    hazard_pointer_map()
+        : current(new map_type(make_map()))
+    {
+    }
+
+    ~hazard_pointer_map()
+    {
+        delete current.load();
+    }
+
+    struct reader
+    {
+        explicit reader(hazard_pointer_map& map)
+            : map(map),
+              hazard(map.domain.make_hazard_pointer())
+        {
+        }
+
+        std::uint32_t find(std::uint32_t key)
+        {
+            auto result = hazard.protect(map.current)->find(key)->second;
+            hazard.reset_protection();
+            return result;
+        }
+
+        hazard_pointer_map& map;
+        lean::hazard_pointer_domain::hazard_pointer hazard;
+    };
+
+    void update(std::uint32_t key)
+    {
+        auto replacement = new map_type(*current.load(std::memory_order_acquire));
+        ++(*replacement)[key];
+        domain.retire(current.exchange(replacement, std::memory_order_acq_rel));
+    }
+
+    lean::hazard_pointer_domain domain;
+    std::atomic<map_type *> current;
+};
+
+struct mutex_map
+{
+    struct reader
+    {
+        explicit reader(mutex_map& map)
+            : map(map)
+        {
+        }
+
+        std::uint32_t find(std::uint32_t key)
+        {
+            std::lock_guard<std::mutex> lock(map.mutex);
+            return map.current.find(key)->second;
+        }
+
+        mutex_map& map;
+    };
+
+    void update(std::uint32_t key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++current[key];
+    }
+
+    std::mutex mutex;
+    map_type current = make_map();
+};
+
+template <typename Map>
+void run_lookup(bench::runner& runner, const std::string& prefix, unsigned int readers)
+{
+    Map map;
+    std::atomic<bool> stopped{ false };
+    std::vector<std::thread> threads;
+    for (unsigned int reader = 1; reader < readers; ++reader)
+    {
+        threads.emplace_back([&map, &stopped, reader] {
+            bench::unpin_thread();
+            typename Map::reader self(map);
+            std::uint32_t key = reader;
+            std::uint32_t total = 0;
+            while (!stopped.load(std::memory_order_relaxed))
+            {
+                total += self.find(key);
+                key = (key + 1) % key_count;
+            }
+            bench::do_not_optimize(total);
+        });
+    }
+    threads.emplace_back([&map, &stopped] {
+        bench::unpin_thread();
+        std::uint32_t key = 0;
+        while (!stopped.load(std::memory_order_relaxed))
+        {
+            map.update(key);
+            key = (key + 1) % key_count;
+            std::this_thread::sleep_for(write_interval);
+        }
+    });
+
+    typename Map::reader self(map);
+    runner.run(prefix + ".lookup/readers:" + std::to_string(readers),
+               [&self] (std::size_t iterations) {
+                   std::uint32_t total = 0;
+                   for (std::size_t i = 0; i < iterations; ++i)
+                       total += self.find(static_cast<std::uint32_t>(i % key_count));
+                   bench::do_not_optimize(total);
+               });
+
+    stopped = true;
+    for (auto& thread : threads)
+        thread.join();
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    bench::runner runner(argc, argv);
+
+    for (unsigned int readers : { 1U, 2U, 4U, 8U })
+    {
+        run_lookup<epoch_map>(runner, "epoch", readers);
+        run_lookup<hazard_pointer_map>(runner, "hazard_pointer", readers);
+        run_lookup<mutex_map>(runner, "mutex", readers);
+    }
+
+    return runner.finish();
+}
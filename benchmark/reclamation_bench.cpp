@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "bench.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <lean/epoch.hpp>
+#include <lean/hazard_pointer.hpp>
+
+// Read-side and retire costs of epoch_domain and hazard_pointer_domain, and
+// the memory held by retired objects while a reader is stalled.
+
+namespace
+{
+
+struct node
+{
+    int value = 0;
+};
+
+// Counts objects that have not been deleted
+struct tracked_node
+{
+    tracked_node() noexcept
+    {
+        live.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~tracked_node()
+    {
+        live.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    static std::atomic<std::size_t> live;
+    char payload[64];
+};
+
+std::atomic<std::size_t> tracked_node::live{ 0 };
+
+constexpr std::size_t stalled_retire_count = 100000;
+
+// A reader enters its critical section, or protects the current object, and
+// stalls while the writer replaces and retires objects. Reports the number
+// and size of retired objects that could not be deleted.
+
+template <typename Domain, typename Reader>
+void report_stalled_reader(bench::runner& runner, const std::string& prefix, Reader reader)
+{
+    Domain domain;
+    std::atomic<tracked_node *> head{ new tracked_node };
+    std::atomic<bool> stalled{ false };
+    std::atomic<bool> resumed{ false };
+
+    std::thread thread([&] {
+        reader(domain, head, stalled, resumed);
+    });
+    while (!stalled.load())
+        std::this_thread::yield();
+
+    for (std::size_t i = 0; i < stalled_retire_count; ++i)
+    {
+        domain.retire(head.exchange(new tracked_node));
+    }
+    domain.reclaim();
+    // The published object is not retired
+    const std::size_t pending = tracked_node::live.load() - 1;
+    runner.report(prefix + ".stalled_reader.pending", double(pending), "objects");
+    runner.report(prefix + ".stalled_reader.footprint", double(pending * sizeof(tracked_node)), "bytes");
+
+    resumed = true;
+    thread.join();
+    delete head.load();
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    bench::runner runner(argc, argv);
+
+    node initial;
+    std::atomic<node *> head{ &initial };
+
+    runner.run("baseline.load_acquire",
+               [&head] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       bench::do_not_optimize(head.load(std::memory_order_acquire)->value);
+                   }
+               });
+
+    {
+        lean::epoch_domain domain;
+        // Allocate the thread record outside the measurements
+        domain.pin();
+
+        runner.run("epoch.pin",
+                   [&] (std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                       {
+                           auto guard = domain.pin();
+                           bench::do_not_optimize(head.load(std::memory_order_acquire)->value);
+                       }
+                   });
+
+        runner.run("epoch.pin_nested",
+                   [&] (std::size_t iterations) {
+                       auto outer = domain.pin();
+                       for (std::size_t i = 0; i < iterations; ++i)
+                       {
+                           auto guard = domain.pin();
+                           bench::do_not_optimize(head.load(std::memory_order_acquire)->value);
+                       }
+                   });
+
+        runner.run("epoch.retire",
+                   [&] (std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                       {
+                           domain.retire(new node);
+                       }
+                   });
+    }
+
+    {
+        lean::hazard_pointer_domain domain;
+
+        runner.run("hazard_pointer.protect",
+                   [&] (std::size_t iterations) {
+                       auto hazard = domain.make_hazard_pointer();
+                       for (std::size_t i = 0; i < iterations; ++i)
+                       {
+                           bench::do_not_optimize(hazard.protect(head)->value);
+                           hazard.reset_protection();
+                       }
+                   });
+
+        runner.run("hazard_pointer.make",
+                   [&] (std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                       {
+                           auto hazard = domain.make_hazard_pointer();
+                           bench::do_not_optimize(hazard);
+                       }
+                   });
+
+        runner.run("hazard_pointer.retire",
+                   [&] (std::size_t iterations) {
+                       for (std::size_t i = 0; i < iterations; ++i)
+                       {
+                           domain.retire(new node);
+                       }
+                   });
+    }
+
+    report_stalled_reader<lean::epoch_domain>(
+        runner,
+        "epoch",
+        [] (lean::epoch_domain& domain,
+            std::atomic<tracked_node *>&,
+            std::atomic<bool>& stalled,
+            std::atomic<bool>& resumed) {
+            auto guard = domain.pin();
+            stalled = true;
+            while (!resumed.load())
+                std::this_thread::yield();
+        });
+
+    report_stalled_reader<lean::hazard_pointer_domain>(
+        runner,
+        "hazard_pointer",
+        [] (lean::hazard_pointer_domain& domain,
+            std::atomic<tracked_node *>& head,
+            std::atomic<bool>& stalled,
+            std::atomic<bool>& resumed) {
+            auto hazard = domain.make_hazard_pointer();
+            bench::do_not_optimize(hazard.protect(head)->payload[0]);
+            stalled = true;
+            while (!resumed.load())
+                std::this_thread::yield();
+        });
+
+    return runner.finish();
+}
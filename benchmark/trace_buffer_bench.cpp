@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "bench.hpp"
+#include <lean/trace_buffer.hpp>
+
+// Cost of recording an event on the producer thread
+
+int main(int argc, char *argv[])
+{
+    bench::runner runner(argc, argv);
+
+#if LEAN_CXX >= LEAN_LIB_ATOMIC_WAIT
+
+    lean::trace_buffer buffer(1 << 16);
+
+    // Ring drained between samples, so records are never dropped
+    runner.run("trace_buffer.record",
+               [&buffer] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       if ((i & 0xFFFF) == 0xFFFF)
+                           buffer.drain([] (const lean::trace_record&) {});
+                       buffer.instant(1, i);
+                   }
+                   buffer.drain([] (const lean::trace_record&) {});
+               });
+
+    // Ring full, so every record is dropped
+    while (buffer.instant(2))
+    {
+    }
+    runner.run("trace_buffer.record_full",
+               [&buffer] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       buffer.instant(2, i);
+                   }
+               });
+
+    runner.run("trace_buffer.now",
+               [] (std::size_t iterations) {
+                   for (std::size_t i = 0; i < iterations; ++i)
+                   {
+                       bench::do_not_optimize(lean::trace_buffer::now());
+                   }
+               });
+
+#endif
+
+    return runner.finish();
+}
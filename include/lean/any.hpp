@@ -11,6 +11,7 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <lean/detail/config.hpp>
 #include <lean/memory.hpp>
 #include <lean/utility.hpp>
 #include <lean/type_traits.hpp>
@@ -182,7 +183,9 @@ protected:
             return static_cast<const T*>(self.pointer);
         }
 
+        // Allocation is kept out of line from callers
         template <typename... Args>
+        LEAN_ATTRIBUTE_NOINLINE LEAN_ATTRIBUTE_COLD
         static void create(storage_type& self, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args...>::value)
         {
             self.pointer = new (std::nothrow_t{}) T{ std::forward<Args>(args)... };
@@ -204,17 +207,20 @@ protected:
     struct overload<T,
                     enable_if_t<(sizeof(T) <= sizeof(storage.buffer)) && is_trivially_move_constructible<T>::value>>
     {
+        LEAN_ATTRIBUTE_ALWAYS_INLINE
         static T* cast(storage_type& self) noexcept
         {
             return reinterpret_cast<T*>(addressof(self.buffer));
         }
 
+        LEAN_ATTRIBUTE_ALWAYS_INLINE
         static const T* cast(const storage_type& self) noexcept
         {
             return reinterpret_cast<const T*>(addressof(self.buffer));
         }
 
         template <typename... Args>
+        LEAN_ATTRIBUTE_ALWAYS_INLINE
         static void create(storage_type& self, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args...>::value)
         {
             construct_at(cast(self), std::forward<Args>(args)...);
@@ -289,6 +295,13 @@ T * any_cast(unique_any *self) noexcept
 
 } // namespace v1
 
+//-----------------------------------------------------------------------------
+// Storage is either a pointer or a trivially movable in-place value
+
+template <>
+struct is_trivially_relocatable<v1::unique_any>
+    : public std::true_type {};
+
 using v1::unique_any;
 using v1::any_cast;
 
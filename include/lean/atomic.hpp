@@ -12,6 +12,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <atomic>
+#include <type_traits>
 #include <lean/detail/config.hpp>
 
 #if __cpp_lib_atomic_wait >= 201907L
@@ -24,8 +25,6 @@
 # define LEAN_LIB_ATOMIC_WAIT LEAN_CXX_NEVER
 #endif
 
-#if LEAN_CXX >= LEAN_LIB_ATOMIC_WAIT
-
 namespace lean
 {
 namespace v1
@@ -58,13 +57,44 @@ struct atomic_counter
         return value.fetch_sub(1, std::memory_order_acq_rel);
     }
 
+    // Reference counting
+    //
+    // A new reference can only be created from an existing one, so the
+    // increment needs no ordering. The decrement releases all accesses
+    // through the dropped reference, and the last owner acquires them
+    // before destroying the object.
+
+    void increment() noexcept {
+        value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Returns true when the count drops to zero
+    bool decrement() noexcept {
+        if (value.fetch_sub(1, std::memory_order_release) == 1)
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return true;
+        }
+        return false;
+    }
+
+    T load() const noexcept {
+        return value.load(std::memory_order_relaxed);
+    }
+
 private:
-    std::atomic<T> value;
+    std::atomic<T> value{ 0 };
 };
 
 } // namespace detail
 
 } // namespace v1
+} // namespace lean
+
+#if LEAN_CXX >= LEAN_LIB_ATOMIC_WAIT
+
+namespace lean
+{
 
 using v1::atomic;
 using v1::atomic_notify_one;
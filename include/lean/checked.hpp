@@ -11,28 +11,278 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <limits>
+#include <stdexcept>
+#include <system_error> // std::errc
 #include <type_traits>
 #include <lean/detail/config.hpp>
+#include <lean/detail/checked_policy.hpp>
+#include <lean/expected.hpp>
+#include <lean/throw.hpp>
+#include <lean/type_traits.hpp>
 
-// Invocation policy
+// Checked arithmetic
 
 namespace lean
 {
 namespace v1
 {
+namespace detail
+{
+
+template <typename T>
+bool add_overflow(T lhs, T rhs, T& result) noexcept
+{
+#if defined(__GNUC__)
+    return __builtin_add_overflow(lhs, rhs, &result);
+#else
+    if ((rhs > 0)
+        ? (lhs > std::numeric_limits<T>::max() - rhs)
+        : (lhs < std::numeric_limits<T>::min() - rhs))
+        return true;
+    result = T(lhs + rhs);
+    return false;
+#endif
+}
+
+template <typename T>
+bool sub_overflow(T lhs, T rhs, T& result) noexcept
+{
+#if defined(__GNUC__)
+    return __builtin_sub_overflow(lhs, rhs, &result);
+#else
+    if ((rhs > 0)
+        ? (lhs < std::numeric_limits<T>::min() + rhs)
+        : (lhs > std::numeric_limits<T>::max() + rhs))
+        return true;
+    result = T(lhs - rhs);
+    return false;
+#endif
+}
+
+template <typename T>
+bool mul_overflow(T lhs, T rhs, T& result) noexcept
+{
+#if defined(__GNUC__)
+    return __builtin_mul_overflow(lhs, rhs, &result);
+#else
+    if ((lhs != 0) && (rhs != 0))
+    {
+        const bool overflow = (lhs > 0)
+            ? ((rhs > 0)
+               ? (lhs > std::numeric_limits<T>::max() / rhs)
+               : (rhs < std::numeric_limits<T>::min() / lhs))
+            : ((rhs > 0)
+               ? (lhs < std::numeric_limits<T>::min() / rhs)
+               : (lhs < std::numeric_limits<T>::max() / rhs));
+        if (overflow)
+            return true;
+    }
+    result = T(lhs * rhs);
+    return false;
+#endif
+}
+
+template <typename T>
+constexpr bool is_negative(T value, std::true_type) noexcept
+{
+    return value < T(0);
+}
+
+template <typename T>
+constexpr bool is_negative(T, std::false_type) noexcept
+{
+    return false;
+}
+
+template <typename T>
+constexpr bool is_negative(T value) noexcept
+{
+    return is_negative(value, std::is_signed<T>{});
+}
+
+template <typename T, typename U>
+bool narrow_overflow(U value, T& result) noexcept
+{
+    result = static_cast<T>(value);
+    return (static_cast<U>(result) != value) || (is_negative(result) != is_negative(value));
+}
+
+// Reports the outcome of a checked operation according to the policy
+
+template <typename Policy, typename T, typename = void>
+struct checked_outcome
+{
+    using result_type = T;
 
-struct unchecked {};
+    static result_type success(T value) noexcept
+    {
+        return value;
+    }
 
-template <typename>
-struct is_checked_policy : std::true_type {};
+    static result_type failure(const char *what)
+    {
+        throw_exception<std::overflow_error>(what);
+        return T{};
+    }
+};
+
+template <typename T>
+struct checked_outcome<checked_expected, T>
+{
+    using result_type = expected<T, std::errc>;
+
+    static result_type success(T value) noexcept
+    {
+        return value;
+    }
+
+    static result_type failure(const char *) noexcept
+    {
+        return make_unexpected(std::errc::result_out_of_range);
+    }
+};
+
+template <typename Policy, typename T>
+struct checked_outcome<Policy, T, enable_if_t<!is_checked_policy<Policy>::value>>
+{
+    using result_type = T;
+};
 
-template <>
-struct is_checked_policy<unchecked> : std::false_type {};
+template <typename Policy, typename T>
+using checked_result_t = typename checked_outcome<Policy, T>::result_type;
+
+template <typename Policy, typename T>
+using enable_unchecked_t = enable_if_t<std::is_integral<T>::value && !is_checked_policy<Policy>::value, int>;
+
+template <typename Policy, typename T>
+using enable_checked_t = enable_if_t<std::is_integral<T>::value && is_checked_policy<Policy>::value, int>;
+
+} // namespace detail
+
+//! @brief Adds integers.
+//!
+//! The checked policies use the overflow builtins where available. Checked
+//! overflow throws std::overflow_error or returns std::errc::result_out_of_range
+//! depending on the policy.
+//!
+//! The unchecked policy compiles to a plain addition, and overflow is
+//! undefined behavior for signed integers.
+//!
+//! Example:
+//!
+//!   auto total = lean::add(count, extra); // default_policy
+//!   auto total = lean::add<lean::unchecked>(count, extra);
+//!   if (auto total = lean::add<lean::checked_expected>(count, extra)) ...
+
+template <typename Policy = default_policy,
+          typename T,
+          detail::enable_unchecked_t<Policy, T> = 0>
+constexpr T add(T lhs, T rhs) noexcept
+{
+    return T(lhs + rhs);
+}
+
+template <typename Policy = default_policy,
+          typename T,
+          detail::enable_checked_t<Policy, T> = 0>
+auto add(T lhs, T rhs) -> detail::checked_result_t<Policy, T>
+{
+    using outcome = detail::checked_outcome<Policy, T>;
+    T result;
+    if (LEAN_UNLIKELY(detail::add_overflow(lhs, rhs, result)))
+        return outcome::failure("addition overflow");
+    return outcome::success(result);
+}
+
+//! @brief Subtracts integers.
+//!
+//! Overflow is handled like lean::add.
+
+template <typename Policy = default_policy,
+          typename T,
+          detail::enable_unchecked_t<Policy, T> = 0>
+constexpr T sub(T lhs, T rhs) noexcept
+{
+    return T(lhs - rhs);
+}
+
+template <typename Policy = default_policy,
+          typename T,
+          detail::enable_checked_t<Policy, T> = 0>
+auto sub(T lhs, T rhs) -> detail::checked_result_t<Policy, T>
+{
+    using outcome = detail::checked_outcome<Policy, T>;
+    T result;
+    if (LEAN_UNLIKELY(detail::sub_overflow(lhs, rhs, result)))
+        return outcome::failure("subtraction overflow");
+    return outcome::success(result);
+}
+
+//! @brief Multiplies integers.
+//!
+//! Overflow is handled like lean::add.
+
+template <typename Policy = default_policy,
+          typename T,
+          detail::enable_unchecked_t<Policy, T> = 0>
+constexpr T mul(T lhs, T rhs) noexcept
+{
+    return T(lhs * rhs);
+}
+
+template <typename Policy = default_policy,
+          typename T,
+          detail::enable_checked_t<Policy, T> = 0>
+auto mul(T lhs, T rhs) -> detail::checked_result_t<Policy, T>
+{
+    using outcome = detail::checked_outcome<Policy, T>;
+    T result;
+    if (LEAN_UNLIKELY(detail::mul_overflow(lhs, rhs, result)))
+        return outcome::failure("multiplication overflow");
+    return outcome::success(result);
+}
+
+//! @brief Converts integer to another integer type.
+//!
+//! Checked conversion fails if the value cannot be represented by T.
+//!
+//! The unchecked policy compiles to a plain cast.
+//!
+//! Example:
+//!
+//!   auto size = lean::narrow<std::uint32_t>(buffer.size());
+
+template <typename T,
+          typename Policy = default_policy,
+          typename U,
+          detail::enable_unchecked_t<Policy, U> = 0,
+          enable_if_t<std::is_integral<T>::value, int> = 0>
+constexpr T narrow(U value) noexcept
+{
+    return static_cast<T>(value);
+}
+
+template <typename T,
+          typename Policy = default_policy,
+          typename U,
+          detail::enable_checked_t<Policy, U> = 0,
+          enable_if_t<std::is_integral<T>::value, int> = 0>
+auto narrow(U value) -> detail::checked_result_t<Policy, T>
+{
+    using outcome = detail::checked_outcome<Policy, T>;
+    T result;
+    if (LEAN_UNLIKELY(detail::narrow_overflow(value, result)))
+        return outcome::failure("narrowing overflow");
+    return outcome::success(result);
+}
 
 } // namespace v1
 
-using v1::unchecked;
-using v1::is_checked_policy;
+using v1::add;
+using v1::sub;
+using v1::mul;
+using v1::narrow;
 
 } // namespace lean
 
@@ -0,0 +1,65 @@
+#ifndef LEAN_DETAIL_CHECKED_POLICY_HPP
+#define LEAN_DETAIL_CHECKED_POLICY_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <type_traits>
+#include <lean/detail/config.hpp>
+
+// Invocation policy
+
+namespace lean
+{
+namespace v1
+{
+
+//! @brief Policy without checks.
+//!
+//! Violating a precondition is undefined behavior.
+
+struct unchecked {};
+
+//! @brief Policy that throws on failure.
+
+struct checked {};
+
+//! @brief Policy that returns failures as expected<T, std::errc>.
+
+struct checked_expected {};
+
+template <typename>
+struct is_checked_policy : std::true_type {};
+
+template <>
+struct is_checked_policy<unchecked> : std::false_type {};
+
+//! @brief Policy used when none is given.
+//!
+//! Define LEAN_UNCHECKED to disable checks by default, for example in
+//! release builds. The definition must be the same in all translation units.
+
+#if defined(LEAN_UNCHECKED)
+using default_policy = unchecked;
+#else
+using default_policy = checked;
+#endif
+
+} // namespace v1
+
+using v1::unchecked;
+using v1::checked;
+using v1::checked_expected;
+using v1::is_checked_policy;
+using v1::default_policy;
+
+} // namespace lean
+
+#endif // LEAN_DETAIL_CHECKED_POLICY_HPP
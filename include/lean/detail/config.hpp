@@ -49,6 +49,66 @@ static_assert(LEAN_CXX >= LEAN_CXX11, "Requires C++11");
 
 #define LEAN_IF_CONSTEXPR(x) if LEAN_CONSTEXPR_CXX17 (x)
 
+// Exceptions
+//
+// LEAN_NO_EXCEPTIONS is defined when compiled without exception support, or
+// it can be defined explicitly.
+//
+// LEAN_TRY and LEAN_CATCH_ALL replace try and catch (...) so the handler is
+// discarded without exceptions. LEAN_RETHROW must only be used within the
+// handler.
+
+#if !defined(LEAN_NO_EXCEPTIONS)
+# if !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+#  define LEAN_NO_EXCEPTIONS 1
+# endif
+#endif
+
+#if defined(LEAN_NO_EXCEPTIONS)
+# define LEAN_TRY if (true)
+# define LEAN_CATCH_ALL else
+# define LEAN_RETHROW ((void)0)
+#else
+# define LEAN_TRY try
+# define LEAN_CATCH_ALL catch (...)
+# define LEAN_RETHROW throw
+#endif
+
+// Header-only
+//
+// Define LEAN_HEADER_ONLY to place the platform definitions in the headers
+// instead of lean-core. The library need not be linked, and the fast paths
+// can be inlined into callers. LEAN_DECL marks such definitions.
+
+#if defined(LEAN_HEADER_ONLY)
+# define LEAN_DECL inline
+#else
+# define LEAN_DECL
+#endif
+
+// Wait statistics
+//
+// Define LEAN_WAIT_STATISTICS to count system calls, spurious wake-ups, wait
+// durations, and notifications without waiters in the futex backend of
+// lean::atomic. See <lean/wait_statistics.hpp>.
+//
+// This changes the layout of lean::atomic, so it must be defined for all
+// translation units, including lean-core.
+
+#if !defined(LEAN_WAIT_STATISTICS)
+# define LEAN_WAIT_STATISTICS 0
+#endif
+
+// Optimization hints
+//
+// Define LEAN_OPTIMIZATION_HINTS as 0 to expand the cold, always-inline, and
+// branch prediction hints below to nothing. Used to measure the effect of the
+// hints.
+
+#if !defined(LEAN_OPTIMIZATION_HINTS)
+# define LEAN_OPTIMIZATION_HINTS 1
+#endif
+
 // Warnings
 //
 // Uses C99 _Pragma()
@@ -85,4 +145,37 @@ static_assert(LEAN_CXX >= LEAN_CXX11, "Requires C++11");
 # define LEAN_ATTRIBUTE_NOINLINE
 #endif
 
+// Function is always inlined. Only use on inline functions.
+
+#if !LEAN_OPTIMIZATION_HINTS
+# define LEAN_ATTRIBUTE_ALWAYS_INLINE
+#elif defined(__GNUC__)
+# define LEAN_ATTRIBUTE_ALWAYS_INLINE [[gnu::always_inline]]
+#elif defined(_MSC_VER)
+# define LEAN_ATTRIBUTE_ALWAYS_INLINE __forceinline
+#else
+# define LEAN_ATTRIBUTE_ALWAYS_INLINE
+#endif
+
+// Function is rarely called, so it is optimized for size and placed apart
+// from hot code. Paths leading to the call are treated as unlikely.
+
+#if LEAN_OPTIMIZATION_HINTS && defined(__GNUC__)
+# define LEAN_ATTRIBUTE_COLD [[gnu::cold]]
+#else
+# define LEAN_ATTRIBUTE_COLD
+#endif
+
+// Branch prediction
+//
+// if (LEAN_UNLIKELY(error)) { ... }
+
+#if LEAN_OPTIMIZATION_HINTS && defined(__GNUC__)
+# define LEAN_LIKELY(x) __builtin_expect(!!(x), 1)
+# define LEAN_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+# define LEAN_LIKELY(x) (!!(x))
+# define LEAN_UNLIKELY(x) (!!(x))
+#endif
+
 #endif // LEAN_DETAIL_CONFIG_HPP
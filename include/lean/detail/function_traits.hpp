@@ -20,1313 +20,1111 @@ namespace v1
 namespace detail
 {
 
-template <typename>
-struct function_traits;
+// A function type is decomposed into return type, arguments, and a bitmask
+// of its qualifiers. Qualified function types are rebuilt from the bitmask
+// on demand, so a query only instantiates the type it asks for.
 
-template <typename R, typename... Args>
-struct function_traits<R(Args...)>
+using function_flags = unsigned int;
+
+constexpr function_flags function_const = 1U << 0;
+constexpr function_flags function_volatile = 1U << 1;
+constexpr function_flags function_lvalue_reference = 1U << 2;
+constexpr function_flags function_rvalue_reference = 1U << 3;
+constexpr function_flags function_ellipsis = 1U << 4;
+constexpr function_flags function_noexcept = 1U << 5;
+
+//-----------------------------------------------------------------------------
+// function_builder
+//
+// Specialized on the qualifier bitmask, so each specialization is shared by
+// all signatures with the same qualifiers.
+
+template <function_flags>
+struct function_builder;
+
+template <>
+struct function_builder<0>
 {
-    using return_type = R;
-    using arguments = prototype<Args...>;
+    template <typename R, typename... Args>
+    using type = R(Args...);
+};
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
+template <>
+struct function_builder<function_lvalue_reference>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) &;
+};
 
-    using add_const = R(Args...) const;
-    using add_volatile = R(Args...) volatile;
-    using add_lvalue_reference = R(Args...) &;
-    using add_rvalue_reference = R(Args...) &&;
-    using add_ellipsis = R(Args..., ...);
+template <>
+struct function_builder<function_rvalue_reference>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) &&;
+};
 
-    using remove_const = R(Args...);
-    using remove_volatile = R(Args...);
-    using remove_reference = R(Args...);
-    using remove_ellipsis = R(Args...);
+template <>
+struct function_builder<function_const>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) const;
+};
 
-    template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...);
+template <>
+struct function_builder<function_const | function_lvalue_reference>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) const &;
 };
 
-template <typename R, typename... Args>
-struct function_traits<R(Args...) const>
+template <>
+struct function_builder<function_const | function_rvalue_reference>
 {
-    using return_type = R;
-    using arguments = prototype<Args...>;
+    template <typename R, typename... Args>
+    using type = R(Args...) const &&;
+};
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
+template <>
+struct function_builder<function_volatile>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) volatile;
+};
 
-    using add_const = R(Args...) const;
-    using add_volatile = R(Args...) const volatile;
-    using add_lvalue_reference = R(Args...) const &;
-    using add_rvalue_reference = R(Args...) const &&;
-    using add_ellipsis = R(Args..., ...) const;
+template <>
+struct function_builder<function_volatile | function_lvalue_reference>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) volatile &;
+};
 
-    using remove_const = R(Args...);
-    using remove_volatile = R(Args...) const;
-    using remove_reference = R(Args...) const;
-    using remove_ellipsis = R(Args...) const;
+template <>
+struct function_builder<function_volatile | function_rvalue_reference>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) volatile &&;
+};
 
-    template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const;
+template <>
+struct function_builder<function_const | function_volatile>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) const volatile;
 };
 
-template <typename R, typename... Args>
-struct function_traits<R(Args...) const &>
+template <>
+struct function_builder<function_const | function_volatile | function_lvalue_reference>
 {
-    using return_type = R;
-    using arguments = prototype<Args...>;
+    template <typename R, typename... Args>
+    using type = R(Args...) const volatile &;
+};
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
+template <>
+struct function_builder<function_const | function_volatile | function_rvalue_reference>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) const volatile &&;
+};
 
-    using add_const = R(Args...) const &;
-    using add_volatile = R(Args...) const volatile &;
-    using add_lvalue_reference = R(Args...) const &;
-    using add_rvalue_reference = R(Args...) const &&;
-    using add_ellipsis = R(Args..., ...) const &;
+// Ellipsis
 
-    using remove_const = R(Args...) &;
-    using remove_volatile = R(Args...) const &;
-    using remove_reference = R(Args...) const;
-    using remove_ellipsis = R(Args...) const &;
+template <>
+struct function_builder<function_ellipsis>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...);
+};
 
-    template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const &;
+template <>
+struct function_builder<function_lvalue_reference | function_ellipsis>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) &;
 };
 
-template <typename R, typename... Args>
-struct function_traits<R(Args...) const &&>
+template <>
+struct function_builder<function_rvalue_reference | function_ellipsis>
 {
-    using return_type = R;
-    using arguments = prototype<Args...>;
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) &&;
+};
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::false_type;
+template <>
+struct function_builder<function_const | function_ellipsis>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const;
+};
 
-    using add_const = R(Args...) const &&;
-    using add_volatile = R(Args...) const volatile &&;
-    using add_lvalue_reference = R(Args...) const &;
-    using add_rvalue_reference = R(Args...) const &&;
-    using add_ellipsis = R(Args..., ...) const &&;
+template <>
+struct function_builder<function_const | function_lvalue_reference | function_ellipsis>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const &;
+};
 
-    using remove_const = R(Args...) &&;
-    using remove_volatile = R(Args...) const &&;
-    using remove_reference = R(Args...) const;
-    using remove_ellipsis = R(Args...) const &&;
+template <>
+struct function_builder<function_const | function_rvalue_reference | function_ellipsis>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const &&;
+};
 
-    template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const &&;
+template <>
+struct function_builder<function_volatile | function_ellipsis>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) volatile;
+};
+
+template <>
+struct function_builder<function_volatile | function_lvalue_reference | function_ellipsis>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) volatile &;
 };
 
+template <>
+struct function_builder<function_volatile | function_rvalue_reference | function_ellipsis>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) volatile &&;
+};
+
+template <>
+struct function_builder<function_const | function_volatile | function_ellipsis>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const volatile;
+};
+
+template <>
+struct function_builder<function_const | function_volatile | function_lvalue_reference | function_ellipsis>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const volatile &;
+};
+
+template <>
+struct function_builder<function_const | function_volatile | function_rvalue_reference | function_ellipsis>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const volatile &&;
+};
+
+#if __cpp_noexcept_function_type >= 201510L
+
+template <>
+struct function_builder<function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) noexcept;
+};
+
+template <>
+struct function_builder<function_lvalue_reference | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) & noexcept;
+};
+
+template <>
+struct function_builder<function_rvalue_reference | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) && noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) const noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_lvalue_reference | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) const & noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_rvalue_reference | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) const && noexcept;
+};
+
+template <>
+struct function_builder<function_volatile | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) volatile noexcept;
+};
+
+template <>
+struct function_builder<function_volatile | function_lvalue_reference | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) volatile & noexcept;
+};
+
+template <>
+struct function_builder<function_volatile | function_rvalue_reference | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) volatile && noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_volatile | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) const volatile noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_volatile | function_lvalue_reference | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) const volatile & noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_volatile | function_rvalue_reference | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args...) const volatile && noexcept;
+};
+
+template <>
+struct function_builder<function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) noexcept;
+};
+
+template <>
+struct function_builder<function_lvalue_reference | function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) & noexcept;
+};
+
+template <>
+struct function_builder<function_rvalue_reference | function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) && noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_lvalue_reference | function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const & noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_rvalue_reference | function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const && noexcept;
+};
+
+template <>
+struct function_builder<function_volatile | function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) volatile noexcept;
+};
+
+template <>
+struct function_builder<function_volatile | function_lvalue_reference | function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) volatile & noexcept;
+};
+
+template <>
+struct function_builder<function_volatile | function_rvalue_reference | function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) volatile && noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_volatile | function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const volatile noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_volatile | function_lvalue_reference | function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const volatile & noexcept;
+};
+
+template <>
+struct function_builder<function_const | function_volatile | function_rvalue_reference | function_ellipsis | function_noexcept>
+{
+    template <typename R, typename... Args>
+    using type = R(Args..., ...) const volatile && noexcept;
+};
+
+#endif
+
+//-----------------------------------------------------------------------------
+// function_traits
+
+template <typename>
+struct function_traits;
+
 template <typename R, typename... Args>
-struct function_traits<R(Args...) const volatile>
+struct function_traits<R(Args...)>
 {
+    static constexpr function_flags flags = 0;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
+
+    template <typename RR, typename... RArgs>
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
+};
+
+template <typename R, typename... Args>
+struct function_traits<R(Args...) &>
+{
+    static constexpr function_flags flags = function_lvalue_reference;
 
-    using add_const = R(Args...) const volatile;
-    using add_volatile = R(Args...) const volatile;
-    using add_lvalue_reference = R(Args...) const volatile &;
-    using add_rvalue_reference = R(Args...) const volatile &&;
-    using add_ellipsis = R(Args..., ...) const volatile;
+    using return_type = R;
+    using arguments = prototype<Args...>;
 
-    using remove_const = R(Args...) volatile;
-    using remove_volatile = R(Args...) const;
-    using remove_reference = R(Args...) const volatile;
-    using remove_ellipsis = R(Args...) const volatile;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const volatile;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args...) const volatile &>
+struct function_traits<R(Args...) &&>
 {
+    static constexpr function_flags flags = function_rvalue_reference;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
+
+    template <typename RR, typename... RArgs>
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
+};
+
+template <typename R, typename... Args>
+struct function_traits<R(Args...) const>
+{
+    static constexpr function_flags flags = function_const;
 
-    using add_const = R(Args...) const volatile &;
-    using add_volatile = R(Args...) const volatile &;
-    using add_lvalue_reference = R(Args...) const volatile &;
-    using add_rvalue_reference = R(Args...) const volatile &&;
-    using add_ellipsis = R(Args..., ...) const volatile &;
+    using return_type = R;
+    using arguments = prototype<Args...>;
 
-    using remove_const = R(Args...) volatile &;
-    using remove_volatile = R(Args...) const &;
-    using remove_reference = R(Args...) const volatile;
-    using remove_ellipsis = R(Args...) const volatile &;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const volatile &;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args...) const volatile &&>
+struct function_traits<R(Args...) const &>
 {
+    static constexpr function_flags flags = function_const | function_lvalue_reference;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::false_type;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
+
+    template <typename RR, typename... RArgs>
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
+};
+
+template <typename R, typename... Args>
+struct function_traits<R(Args...) const &&>
+{
+    static constexpr function_flags flags = function_const | function_rvalue_reference;
 
-    using add_const = R(Args...) const volatile &&;
-    using add_volatile = R(Args...) const volatile &&;
-    using add_lvalue_reference = R(Args...) const volatile &;
-    using add_rvalue_reference = R(Args...) const volatile &&;
-    using add_ellipsis = R(Args..., ...) const volatile &&;
+    using return_type = R;
+    using arguments = prototype<Args...>;
 
-    using remove_const = R(Args...) volatile &&;
-    using remove_volatile = R(Args...) const &&;
-    using remove_reference = R(Args...) const volatile;
-    using remove_ellipsis = R(Args...) const volatile &&;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const volatile &&;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args...) volatile>
 {
+    static constexpr function_flags flags = function_volatile;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const volatile;
-    using add_volatile = R(Args...) volatile;
-    using add_lvalue_reference = R(Args...) volatile &;
-    using add_rvalue_reference = R(Args...) volatile &&;
-    using add_ellipsis = R(Args..., ...) volatile;
-
-    using remove_const = R(Args...) volatile;
-    using remove_volatile = R(Args...);
-    using remove_reference = R(Args...) volatile;
-    using remove_ellipsis = R(Args...) volatile;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) volatile;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args...) volatile &>
 {
+    static constexpr function_flags flags = function_volatile | function_lvalue_reference;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const volatile &;
-    using add_volatile = R(Args...) volatile &;
-    using add_lvalue_reference = R(Args...) volatile &;
-    using add_rvalue_reference = R(Args...) volatile &&;
-    using add_ellipsis = R(Args..., ...) volatile &;
-
-    using remove_const = R(Args...) volatile &;
-    using remove_volatile = R(Args...) &;
-    using remove_reference = R(Args...) volatile;
-    using remove_ellipsis = R(Args...) volatile &;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) volatile &;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args...) volatile &&>
 {
+    static constexpr function_flags flags = function_volatile | function_rvalue_reference;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const volatile &&;
-    using add_volatile = R(Args...) volatile &&;
-    using add_lvalue_reference = R(Args...) volatile &;
-    using add_rvalue_reference = R(Args...) volatile &&;
-    using add_ellipsis = R(Args..., ...) volatile &&;
-
-    using remove_const = R(Args...) volatile &&;
-    using remove_volatile = R(Args...) &&;
-    using remove_reference = R(Args...) volatile;
-    using remove_ellipsis = R(Args...) volatile &&;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) volatile &&;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args...) &>
+struct function_traits<R(Args...) const volatile>
 {
+    static constexpr function_flags flags = function_const | function_volatile;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const &;
-    using add_volatile = R(Args...) volatile &;
-    using add_lvalue_reference = R(Args...) &;
-    using add_rvalue_reference = R(Args...) &&;
-    using add_ellipsis = R(Args..., ...) &;
-
-    using remove_const = R(Args...) &;
-    using remove_volatile = R(Args...) &;
-    using remove_reference = R(Args...);
-    using remove_ellipsis = R(Args...) &;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) &;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args...) &&>
+struct function_traits<R(Args...) const volatile &>
 {
+    static constexpr function_flags flags = function_const | function_volatile | function_lvalue_reference;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const &&;
-    using add_volatile = R(Args...) volatile &&;
-    using add_lvalue_reference = R(Args...) &;
-    using add_rvalue_reference = R(Args...) &&;
-    using add_ellipsis = R(Args..., ...) &&;
-
-    using remove_const = R(Args...) &&;
-    using remove_volatile = R(Args...) &&;
-    using remove_reference = R(Args...);
-    using remove_ellipsis = R(Args...) &&;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) &&;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
-// Ellipsis
-
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...)>
+struct function_traits<R(Args...) const volatile &&>
 {
+    static constexpr function_flags flags = function_const | function_volatile | function_rvalue_reference;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const;
-    using add_volatile = R(Args..., ...) volatile;
-    using add_lvalue_reference = R(Args..., ...) &;
-    using add_rvalue_reference = R(Args..., ...) &&;
-    using add_ellipsis = R(Args..., ...);
-
-    using remove_const = R(Args..., ...);
-    using remove_volatile = R(Args..., ...);
-    using remove_reference = R(Args..., ...);
-    using remove_ellipsis = R(Args...);
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...);
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
+// Ellipsis
+
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const>
+struct function_traits<R(Args..., ...)>
 {
+    static constexpr function_flags flags = function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const;
-    using add_volatile = R(Args..., ...) const volatile;
-    using add_lvalue_reference = R(Args..., ...) const &;
-    using add_rvalue_reference = R(Args..., ...) const &&;
-    using add_ellipsis = R(Args..., ...) const;
-
-    using remove_const = R(Args..., ...);
-    using remove_volatile = R(Args..., ...) const;
-    using remove_reference = R(Args..., ...) const;
-    using remove_ellipsis = R(Args...) const;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const &>
+struct function_traits<R(Args..., ...) &>
 {
+    static constexpr function_flags flags = function_lvalue_reference | function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const &;
-    using add_volatile = R(Args..., ...) const volatile &;
-    using add_lvalue_reference = R(Args..., ...) const &;
-    using add_rvalue_reference = R(Args..., ...) const &&;
-    using add_ellipsis = R(Args..., ...) const &;
-
-    using remove_const = R(Args..., ...) &;
-    using remove_volatile = R(Args..., ...) const &;
-    using remove_reference = R(Args..., ...) const;
-    using remove_ellipsis = R(Args...) const &;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const &;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const &&>
+struct function_traits<R(Args..., ...) &&>
 {
+    static constexpr function_flags flags = function_rvalue_reference | function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const &&;
-    using add_volatile = R(Args..., ...) const volatile &&;
-    using add_lvalue_reference = R(Args..., ...) const &;
-    using add_rvalue_reference = R(Args..., ...) const &&;
-    using add_ellipsis = R(Args..., ...) const &&;
-
-    using remove_const = R(Args..., ...) &&;
-    using remove_volatile = R(Args..., ...) const &&;
-    using remove_reference = R(Args..., ...) const;
-    using remove_ellipsis = R(Args...) const &&;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const &&;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const volatile>
+struct function_traits<R(Args..., ...) const>
 {
+    static constexpr function_flags flags = function_const | function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile;
-    using add_volatile = R(Args..., ...) const volatile;
-    using add_lvalue_reference = R(Args..., ...) const volatile &;
-    using add_rvalue_reference = R(Args..., ...) const volatile &&;
-    using add_ellipsis = R(Args..., ...) const volatile;
-
-    using remove_const = R(Args..., ...) volatile;
-    using remove_volatile = R(Args..., ...) const;
-    using remove_reference = R(Args..., ...) const volatile;
-    using remove_ellipsis = R(Args...) const volatile;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const volatile;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const volatile &>
+struct function_traits<R(Args..., ...) const &>
 {
+    static constexpr function_flags flags = function_const | function_lvalue_reference | function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile &;
-    using add_volatile = R(Args..., ...) const volatile &;
-    using add_lvalue_reference = R(Args..., ...) const volatile &;
-    using add_rvalue_reference = R(Args..., ...) const volatile &&;
-    using add_ellipsis = R(Args..., ...) const volatile &;
-
-    using remove_const = R(Args..., ...) volatile &;
-    using remove_volatile = R(Args..., ...) const &;
-    using remove_reference = R(Args..., ...) const volatile;
-    using remove_ellipsis = R(Args...) const volatile &;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const volatile &;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const volatile &&>
+struct function_traits<R(Args..., ...) const &&>
 {
+    static constexpr function_flags flags = function_const | function_rvalue_reference | function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile &&;
-    using add_volatile = R(Args..., ...) const volatile &&;
-    using add_lvalue_reference = R(Args..., ...) const volatile &;
-    using add_rvalue_reference = R(Args..., ...) const volatile &&;
-    using add_ellipsis = R(Args..., ...) const volatile &&;
-
-    using remove_const = R(Args..., ...) volatile &&;
-    using remove_volatile = R(Args..., ...) const &&;
-    using remove_reference = R(Args..., ...) const volatile;
-    using remove_ellipsis = R(Args...) const volatile &&;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const volatile &&;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args..., ...) volatile>
 {
+    static constexpr function_flags flags = function_volatile | function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile;
-    using add_volatile = R(Args..., ...) volatile;
-    using add_lvalue_reference = R(Args..., ...) volatile &;
-    using add_rvalue_reference = R(Args..., ...) volatile &&;
-    using add_ellipsis = R(Args..., ...) volatile;
-
-    using remove_const = R(Args..., ...) volatile;
-    using remove_volatile = R(Args..., ...);
-    using remove_reference = R(Args..., ...) volatile;
-    using remove_ellipsis = R(Args...) volatile;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) volatile;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args..., ...) volatile &>
 {
+    static constexpr function_flags flags = function_volatile | function_lvalue_reference | function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile &;
-    using add_volatile = R(Args..., ...) volatile &;
-    using add_lvalue_reference = R(Args..., ...) volatile &;
-    using add_rvalue_reference = R(Args..., ...) volatile &&;
-    using add_ellipsis = R(Args..., ...) volatile &;
-
-    using remove_const = R(Args..., ...) volatile &;
-    using remove_volatile = R(Args..., ...) &;
-    using remove_reference = R(Args..., ...) volatile;
-    using remove_ellipsis = R(Args...) volatile &;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) volatile &;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args..., ...) volatile &&>
 {
+    static constexpr function_flags flags = function_volatile | function_rvalue_reference | function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile &&;
-    using add_volatile = R(Args..., ...) volatile &&;
-    using add_lvalue_reference = R(Args..., ...) volatile &;
-    using add_rvalue_reference = R(Args..., ...) volatile &&;
-    using add_ellipsis = R(Args..., ...) volatile &&;
-
-    using remove_const = R(Args..., ...) volatile &&;
-    using remove_volatile = R(Args..., ...) &&;
-    using remove_reference = R(Args..., ...) volatile;
-    using remove_ellipsis = R(Args...) volatile &&;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) volatile &&;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) &>
+struct function_traits<R(Args..., ...) const volatile>
 {
+    static constexpr function_flags flags = function_const | function_volatile | function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const &;
-    using add_volatile = R(Args..., ...) volatile &;
-    using add_lvalue_reference = R(Args..., ...) &;
-    using add_rvalue_reference = R(Args..., ...) &&;
-    using add_ellipsis = R(Args..., ...) &;
-
-    using remove_const = R(Args..., ...) &;
-    using remove_volatile = R(Args..., ...) &;
-    using remove_reference = R(Args..., ...);
-    using remove_ellipsis = R(Args...) &;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) &;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) &&>
+struct function_traits<R(Args..., ...) const volatile &>
 {
+    static constexpr function_flags flags = function_const | function_volatile | function_lvalue_reference | function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const &&;
-    using add_volatile = R(Args..., ...) volatile &&;
-    using add_lvalue_reference = R(Args..., ...) &;
-    using add_rvalue_reference = R(Args..., ...) &&;
-    using add_ellipsis = R(Args..., ...) &&;
-
-    using remove_const = R(Args..., ...) &&;
-    using remove_volatile = R(Args..., ...) &&;
-    using remove_reference = R(Args..., ...);
-    using remove_ellipsis = R(Args...) &&;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) &&;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
-#if __cpp_noexcept_function_type >= 201510L
-
 template <typename R, typename... Args>
-struct function_traits<R(Args...) noexcept>
+struct function_traits<R(Args..., ...) const volatile &&>
 {
+    static constexpr function_flags flags = function_const | function_volatile | function_rvalue_reference | function_ellipsis;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const noexcept;
-    using add_volatile = R(Args...) volatile noexcept;
-    using add_lvalue_reference = R(Args...) & noexcept;
-    using add_rvalue_reference = R(Args...) && noexcept;
-    using add_ellipsis = R(Args..., ...) noexcept;
-
-    using remove_const = R(Args...) noexcept;
-    using remove_volatile = R(Args...) noexcept;
-    using remove_reference = R(Args...) noexcept;
-    using remove_ellipsis = R(Args...) noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
+#if __cpp_noexcept_function_type >= 201510L
+
 template <typename R, typename... Args>
-struct function_traits<R(Args...) const noexcept>
+struct function_traits<R(Args...) noexcept>
 {
+    static constexpr function_flags flags = function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const noexcept;
-    using add_volatile = R(Args...) const volatile noexcept;
-    using add_lvalue_reference = R(Args...) const & noexcept;
-    using add_rvalue_reference = R(Args...) const && noexcept;
-    using add_ellipsis = R(Args..., ...) const noexcept;
-
-    using remove_const = R(Args...) noexcept;
-    using remove_volatile = R(Args...) const noexcept;
-    using remove_reference = R(Args...) const noexcept;
-    using remove_ellipsis = R(Args...) const noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args...) const & noexcept>
+struct function_traits<R(Args...) & noexcept>
 {
+    static constexpr function_flags flags = function_lvalue_reference | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const & noexcept;
-    using add_volatile = R(Args...) const volatile & noexcept;
-    using add_lvalue_reference = R(Args...) const & noexcept;
-    using add_rvalue_reference = R(Args...) const && noexcept;
-    using add_ellipsis = R(Args..., ...) const & noexcept;
-
-    using remove_const = R(Args...) & noexcept;
-    using remove_volatile = R(Args...) const & noexcept;
-    using remove_reference = R(Args...) const noexcept;
-    using remove_ellipsis = R(Args...) const & noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const & noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args...) const && noexcept>
+struct function_traits<R(Args...) && noexcept>
 {
+    static constexpr function_flags flags = function_rvalue_reference | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const && noexcept;
-    using add_volatile = R(Args...) const volatile && noexcept;
-    using add_lvalue_reference = R(Args...) const & noexcept;
-    using add_rvalue_reference = R(Args...) const && noexcept;
-    using add_ellipsis = R(Args..., ...) const && noexcept;
-
-    using remove_const = R(Args...) && noexcept;
-    using remove_volatile = R(Args...) const && noexcept;
-    using remove_reference = R(Args...) const noexcept;
-    using remove_ellipsis = R(Args...) const && noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const && noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args...) const volatile noexcept>
+struct function_traits<R(Args...) const noexcept>
 {
+    static constexpr function_flags flags = function_const | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const volatile noexcept;
-    using add_volatile = R(Args...) const volatile noexcept;
-    using add_lvalue_reference = R(Args...) const volatile & noexcept;
-    using add_rvalue_reference = R(Args...) const volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) const volatile noexcept;
-
-    using remove_const = R(Args...) volatile noexcept;
-    using remove_volatile = R(Args...) const noexcept;
-    using remove_reference = R(Args...) const volatile noexcept;
-    using remove_ellipsis = R(Args...) const volatile noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const volatile noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args...) const volatile & noexcept>
+struct function_traits<R(Args...) const & noexcept>
 {
+    static constexpr function_flags flags = function_const | function_lvalue_reference | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const volatile & noexcept;
-    using add_volatile = R(Args...) const volatile & noexcept;
-    using add_lvalue_reference = R(Args...) const volatile & noexcept;
-    using add_rvalue_reference = R(Args...) const volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) const volatile & noexcept;
-
-    using remove_const = R(Args...) volatile & noexcept;
-    using remove_volatile = R(Args...) const & noexcept;
-    using remove_reference = R(Args...) const volatile noexcept;
-    using remove_ellipsis = R(Args...) const volatile & noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const volatile & noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args...) const volatile && noexcept>
+struct function_traits<R(Args...) const && noexcept>
 {
+    static constexpr function_flags flags = function_const | function_rvalue_reference | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const volatile && noexcept;
-    using add_volatile = R(Args...) const volatile && noexcept;
-    using add_lvalue_reference = R(Args...) const volatile & noexcept;
-    using add_rvalue_reference = R(Args...) const volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) const volatile && noexcept;
-
-    using remove_const = R(Args...) volatile && noexcept;
-    using remove_volatile = R(Args...) const && noexcept;
-    using remove_reference = R(Args...) const volatile noexcept;
-    using remove_ellipsis = R(Args...) const volatile && noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) const volatile && noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args...) volatile noexcept>
 {
+    static constexpr function_flags flags = function_volatile | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const volatile noexcept;
-    using add_volatile = R(Args...) volatile noexcept;
-    using add_lvalue_reference = R(Args...) volatile & noexcept;
-    using add_rvalue_reference = R(Args...) volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) volatile noexcept;
-
-    using remove_const = R(Args...) volatile noexcept;
-    using remove_volatile = R(Args...) noexcept;
-    using remove_reference = R(Args...) volatile noexcept;
-    using remove_ellipsis = R(Args...) volatile noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) volatile noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args...) volatile & noexcept>
 {
+    static constexpr function_flags flags = function_volatile | function_lvalue_reference | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const volatile & noexcept;
-    using add_volatile = R(Args...) volatile & noexcept;
-    using add_lvalue_reference = R(Args...) volatile & noexcept;
-    using add_rvalue_reference = R(Args...) volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) volatile & noexcept;
-
-    using remove_const = R(Args...) volatile & noexcept;
-    using remove_volatile = R(Args...) & noexcept;
-    using remove_reference = R(Args...) volatile noexcept;
-    using remove_ellipsis = R(Args...) volatile & noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) volatile & noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args...) volatile && noexcept>
 {
+    static constexpr function_flags flags = function_volatile | function_rvalue_reference | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const volatile && noexcept;
-    using add_volatile = R(Args...) volatile && noexcept;
-    using add_lvalue_reference = R(Args...) volatile & noexcept;
-    using add_rvalue_reference = R(Args...) volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) volatile && noexcept;
-
-    using remove_const = R(Args...) volatile && noexcept;
-    using remove_volatile = R(Args...) && noexcept;
-    using remove_reference = R(Args...) volatile noexcept;
-    using remove_ellipsis = R(Args...) volatile && noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) volatile && noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args...) & noexcept>
+struct function_traits<R(Args...) const volatile noexcept>
 {
+    static constexpr function_flags flags = function_const | function_volatile | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const & noexcept;
-    using add_volatile = R(Args...) volatile & noexcept;
-    using add_lvalue_reference = R(Args...) & noexcept;
-    using add_rvalue_reference = R(Args...) && noexcept;
-    using add_ellipsis = R(Args..., ...) & noexcept;
-
-    using remove_const = R(Args...) & noexcept;
-    using remove_volatile = R(Args...) & noexcept;
-    using remove_reference = R(Args...) noexcept;
-    using remove_ellipsis = R(Args...) & noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) & noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args...) && noexcept>
+struct function_traits<R(Args...) const volatile & noexcept>
 {
+    static constexpr function_flags flags = function_const | function_volatile | function_lvalue_reference | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::false_type;
-
-    using add_const = R(Args...) const && noexcept;
-    using add_volatile = R(Args...) volatile && noexcept;
-    using add_lvalue_reference = R(Args...) & noexcept;
-    using add_rvalue_reference = R(Args...) && noexcept;
-    using add_ellipsis = R(Args..., ...) && noexcept;
-
-    using remove_const = R(Args...) && noexcept;
-    using remove_volatile = R(Args...) && noexcept;
-    using remove_reference = R(Args...) noexcept;
-    using remove_ellipsis = R(Args...) && noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs...) && noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
-// Ellipsis
-
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) noexcept>
+struct function_traits<R(Args...) const volatile && noexcept>
 {
+    static constexpr function_flags flags = function_const | function_volatile | function_rvalue_reference | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const noexcept;
-    using add_volatile = R(Args..., ...) volatile noexcept;
-    using add_lvalue_reference = R(Args..., ...) & noexcept;
-    using add_rvalue_reference = R(Args..., ...) && noexcept;
-    using add_ellipsis = R(Args..., ...) noexcept;
-
-    using remove_const = R(Args..., ...) noexcept;
-    using remove_volatile = R(Args..., ...) noexcept;
-    using remove_reference = R(Args..., ...) noexcept;
-    using remove_ellipsis = R(Args...) noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const noexcept>
+struct function_traits<R(Args..., ...) noexcept>
 {
+    static constexpr function_flags flags = function_ellipsis | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const noexcept;
-    using add_volatile = R(Args..., ...) const volatile noexcept;
-    using add_lvalue_reference = R(Args..., ...) const & noexcept;
-    using add_rvalue_reference = R(Args..., ...) const && noexcept;
-    using add_ellipsis = R(Args..., ...) const noexcept;
-
-    using remove_const = R(Args..., ...) noexcept;
-    using remove_volatile = R(Args..., ...) const noexcept;
-    using remove_reference = R(Args..., ...) const noexcept;
-    using remove_ellipsis = R(Args...) const noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const & noexcept>
+struct function_traits<R(Args..., ...) & noexcept>
 {
+    static constexpr function_flags flags = function_lvalue_reference | function_ellipsis | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const & noexcept;
-    using add_volatile = R(Args..., ...) const volatile & noexcept;
-    using add_lvalue_reference = R(Args..., ...) const & noexcept;
-    using add_rvalue_reference = R(Args..., ...) const && noexcept;
-    using add_ellipsis = R(Args..., ...) const & noexcept;
-
-    using remove_const = R(Args..., ...) & noexcept;
-    using remove_volatile = R(Args..., ...) const & noexcept;
-    using remove_reference = R(Args..., ...) const noexcept;
-    using remove_ellipsis = R(Args...) const & noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const & noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const && noexcept>
+struct function_traits<R(Args..., ...) && noexcept>
 {
+    static constexpr function_flags flags = function_rvalue_reference | function_ellipsis | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const && noexcept;
-    using add_volatile = R(Args..., ...) const volatile && noexcept;
-    using add_lvalue_reference = R(Args..., ...) const & noexcept;
-    using add_rvalue_reference = R(Args..., ...) const && noexcept;
-    using add_ellipsis = R(Args..., ...) const && noexcept;
-
-    using remove_const = R(Args..., ...) && noexcept;
-    using remove_volatile = R(Args..., ...) const && noexcept;
-    using remove_reference = R(Args..., ...) const noexcept;
-    using remove_ellipsis = R(Args...) const && noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const && noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const volatile noexcept>
+struct function_traits<R(Args..., ...) const noexcept>
 {
+    static constexpr function_flags flags = function_const | function_ellipsis | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile noexcept;
-    using add_volatile = R(Args..., ...) const volatile noexcept;
-    using add_lvalue_reference = R(Args..., ...) const volatile & noexcept;
-    using add_rvalue_reference = R(Args..., ...) const volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) const volatile noexcept;
-
-    using remove_const = R(Args..., ...) volatile noexcept;
-    using remove_volatile = R(Args..., ...) const noexcept;
-    using remove_reference = R(Args..., ...) const volatile noexcept;
-    using remove_ellipsis = R(Args...) const volatile noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const volatile noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const volatile & noexcept>
+struct function_traits<R(Args..., ...) const & noexcept>
 {
+    static constexpr function_flags flags = function_const | function_lvalue_reference | function_ellipsis | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile & noexcept;
-    using add_volatile = R(Args..., ...) const volatile & noexcept;
-    using add_lvalue_reference = R(Args..., ...) const volatile & noexcept;
-    using add_rvalue_reference = R(Args..., ...) const volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) const volatile & noexcept;
-
-    using remove_const = R(Args..., ...) volatile & noexcept;
-    using remove_volatile = R(Args..., ...) const & noexcept;
-    using remove_reference = R(Args..., ...) const volatile noexcept;
-    using remove_ellipsis = R(Args...) const volatile & noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const volatile & noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) const volatile && noexcept>
+struct function_traits<R(Args..., ...) const && noexcept>
 {
+    static constexpr function_flags flags = function_const | function_rvalue_reference | function_ellipsis | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::true_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile && noexcept;
-    using add_volatile = R(Args..., ...) const volatile && noexcept;
-    using add_lvalue_reference = R(Args..., ...) const volatile & noexcept;
-    using add_rvalue_reference = R(Args..., ...) const volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) const volatile && noexcept;
-
-    using remove_const = R(Args..., ...) volatile && noexcept;
-    using remove_volatile = R(Args..., ...) const && noexcept;
-    using remove_reference = R(Args..., ...) const volatile noexcept;
-    using remove_ellipsis = R(Args...) const volatile && noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) const volatile && noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args..., ...) volatile noexcept>
 {
+    static constexpr function_flags flags = function_volatile | function_ellipsis | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile noexcept;
-    using add_volatile = R(Args..., ...) volatile noexcept;
-    using add_lvalue_reference = R(Args..., ...) volatile & noexcept;
-    using add_rvalue_reference = R(Args..., ...) volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) volatile noexcept;
-
-    using remove_const = R(Args..., ...) volatile noexcept;
-    using remove_volatile = R(Args..., ...) noexcept;
-    using remove_reference = R(Args..., ...) volatile noexcept;
-    using remove_ellipsis = R(Args...) volatile noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) volatile noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args..., ...) volatile & noexcept>
 {
+    static constexpr function_flags flags = function_volatile | function_lvalue_reference | function_ellipsis | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile & noexcept;
-    using add_volatile = R(Args..., ...) volatile & noexcept;
-    using add_lvalue_reference = R(Args..., ...) volatile & noexcept;
-    using add_rvalue_reference = R(Args..., ...) volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) volatile & noexcept;
-
-    using remove_const = R(Args..., ...) volatile & noexcept;
-    using remove_volatile = R(Args..., ...) & noexcept;
-    using remove_reference = R(Args..., ...) volatile noexcept;
-    using remove_ellipsis = R(Args...) volatile & noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) volatile & noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
 struct function_traits<R(Args..., ...) volatile && noexcept>
 {
+    static constexpr function_flags flags = function_volatile | function_rvalue_reference | function_ellipsis | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::true_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const volatile && noexcept;
-    using add_volatile = R(Args..., ...) volatile && noexcept;
-    using add_lvalue_reference = R(Args..., ...) volatile & noexcept;
-    using add_rvalue_reference = R(Args..., ...) volatile && noexcept;
-    using add_ellipsis = R(Args..., ...) volatile && noexcept;
-
-    using remove_const = R(Args..., ...) volatile && noexcept;
-    using remove_volatile = R(Args..., ...) && noexcept;
-    using remove_reference = R(Args..., ...) volatile noexcept;
-    using remove_ellipsis = R(Args...) volatile && noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) volatile && noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) & noexcept>
+struct function_traits<R(Args..., ...) const volatile noexcept>
 {
+    static constexpr function_flags flags = function_const | function_volatile | function_ellipsis | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::true_type;
-    using is_rvalue_reference = std::false_type;
-    using is_ellipsis = std::true_type;
-
-    using add_const = R(Args..., ...) const & noexcept;
-    using add_volatile = R(Args..., ...) volatile & noexcept;
-    using add_lvalue_reference = R(Args..., ...) & noexcept;
-    using add_rvalue_reference = R(Args..., ...) && noexcept;
-    using add_ellipsis = R(Args..., ...) & noexcept;
-
-    using remove_const = R(Args..., ...) & noexcept;
-    using remove_volatile = R(Args..., ...) & noexcept;
-    using remove_reference = R(Args..., ...) noexcept;
-    using remove_ellipsis = R(Args...) & noexcept;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) & noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 template <typename R, typename... Args>
-struct function_traits<R(Args..., ...) && noexcept>
+struct function_traits<R(Args..., ...) const volatile & noexcept>
 {
+    static constexpr function_flags flags = function_const | function_volatile | function_lvalue_reference | function_ellipsis | function_noexcept;
+
     using return_type = R;
     using arguments = prototype<Args...>;
 
-    using is_const = std::false_type;
-    using is_volatile = std::false_type;
-    using is_lvalue_reference = std::false_type;
-    using is_rvalue_reference = std::true_type;
-    using is_ellipsis = std::true_type;
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
-    using add_const = R(Args..., ...) const && noexcept;
-    using add_volatile = R(Args..., ...) volatile && noexcept;
-    using add_lvalue_reference = R(Args..., ...) & noexcept;
-    using add_rvalue_reference = R(Args..., ...) && noexcept;
-    using add_ellipsis = R(Args..., ...) && noexcept;
+    template <typename RR, typename... RArgs>
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
+};
+
+template <typename R, typename... Args>
+struct function_traits<R(Args..., ...) const volatile && noexcept>
+{
+    static constexpr function_flags flags = function_const | function_volatile | function_rvalue_reference | function_ellipsis | function_noexcept;
 
-    using remove_const = R(Args..., ...) && noexcept;
-    using remove_volatile = R(Args..., ...) && noexcept;
-    using remove_reference = R(Args..., ...) noexcept;
-    using remove_ellipsis = R(Args...) && noexcept;
+    using return_type = R;
+    using arguments = prototype<Args...>;
+
+    template <function_flags Add, function_flags Remove>
+    using requalify = typename function_builder<(flags & ~Remove) | Add>::template type<R, Args...>;
 
     template <typename RR, typename... RArgs>
-    using rebind = RR(RArgs..., ...) && noexcept;
+    using rebind = typename function_builder<flags>::template type<RR, RArgs...>;
 };
 
 #endif
 
+//-----------------------------------------------------------------------------
+// Qualifier queries
+
+template <typename T, function_flags Mask>
+using function_has_flags = bool_constant<(function_traits<T>::flags & Mask) != 0>;
+
+template <typename T, function_flags Add, function_flags Remove = 0>
+using function_requalify_t = typename function_traits<T>::template requalify<Add, Remove>;
+
 } // namespace detail
 } // namespace v1
 } // namespace lean
@@ -12,6 +12,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <lean/detail/type_traits.hpp>
+#include <lean/detail/function_traits.hpp>
 
 namespace lean
 {
@@ -83,533 +84,83 @@ struct function_object_probe<T C::*,
     using type = T;
 };
 
-template <typename T, typename R, typename A, typename = void>
-struct function_object_type_r
-{
-};
-
-template <typename T, typename R, typename A, typename = void>
-struct function_object_type_noexcept_r
-    : function_object_type_r<T, R, A>
-{
-};
-
-// Uses "is_same<T, cv-qual remove_cv_t<T>>" to avoid greedy matching, where
-// "const T" matches both "const A" and "const volatile A" leading to ambiguous
-// template matching.
-
-// mutable
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...)>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...)>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...) &>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) &>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...) &&>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) &&>>;
-};
-
-// const
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...) const>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...) const &>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const &>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...) const &&>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const &&>>;
-};
-
-// volatile
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...) volatile>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) volatile>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...) volatile &>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) volatile &>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...) volatile &&>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) volatile &&>>;
-};
-
-// const volatile
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...) const volatile>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const volatile>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...) const volatile &>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const volatile &>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args...) const volatile &&>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const volatile &&>>;
-};
-
-// mutable ellipsis
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...)>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...)>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...) &>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) &>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...) &&>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) &&>>;
-};
-
-// const ellipsis
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...) const>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...) const &>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const &>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...) const &&>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const &&>>;
-};
-
-// volatile ellipsis
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...) volatile>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) volatile>>;
-};
+// Call operator qualifiers matching the cv-qualifiers and value category of
+// the object.
 
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...) volatile &>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) volatile &>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...) volatile &&>>>>
+template <typename T>
+struct function_object_flags
+    : std::integral_constant<function_flags,
+                             (std::is_const<remove_reference_t<T>>::value ? function_const : 0U) |
+                             (std::is_volatile<remove_reference_t<T>>::value ? function_volatile : 0U) |
+                             (std::is_lvalue_reference<T>::value ? function_lvalue_reference : 0U) |
+                             (std::is_rvalue_reference<T>::value ? function_rvalue_reference : 0U)>
 {
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) volatile &&>>;
 };
 
-// const volatile ellipsis
+template <typename F, typename C>
+using function_object_member_t = F C::*;
 
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...) const volatile>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const volatile>>;
-};
+// The qualified call operator is built directly from the flags, so only the
+// candidates for the object are probed.
 
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&,
-                              R,
-                              prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...) const volatile &>>>>
+template <typename T, function_flags Flags, typename R, typename A, typename = void>
+struct function_object_member
 {
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const volatile &>>;
 };
 
-template <typename T, typename R, typename... Args>
-struct function_object_type_r<T&&,
+template <typename T, function_flags Flags, typename R, typename... Args>
+struct function_object_member<T,
+                              Flags,
                               R,
                               prototype<Args...>,
-                              void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                     type_t<function_object_probe<R (T::*)(Args..., ...) const volatile &&>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const volatile &&>>;
-};
-
-#if __cpp_noexcept_function_type >= 201510L
-
-// mutable noexcept
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) & noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) & noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) && noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) && noexcept>>;
-};
-
-// const noexcept
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) const noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) const & noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const & noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) const && noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const && noexcept>>;
-};
-
-// volatile noexcept
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) volatile noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) volatile noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) volatile & noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) volatile & noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) volatile && noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) volatile && noexcept>>;
-};
-
-// const volatile noexcept
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) const volatile noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const volatile noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) const volatile & noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const volatile & noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args...) const volatile && noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args...) const volatile && noexcept>>;
-};
-
-// mutable noexcept ellipsis
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) & noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) & noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) && noexcept>>>>
+                              void_t<type_t<function_object_probe<function_object_member_t<typename function_builder<Flags>::template type<R, Args...>,
+                                                                                           remove_cvref_t<T>>>>>>
+    : function_object_probe<function_object_member_t<typename function_builder<Flags>::template type<R, Args...>,
+                                                     remove_cvref_t<T>>>
 {
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) && noexcept>>;
 };
 
-// const noexcept ellipsis
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) const noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const noexcept>>;
-};
+// Non-variadic call operator is preferred over variadic.
 
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) const & noexcept>>>>
+template <typename T, function_flags Flags, typename R, typename A, typename = void>
+struct function_object_member_variadic
+    : function_object_member<T, Flags | function_ellipsis, R, A>
 {
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const & noexcept>>;
 };
 
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&&,
+template <typename T, function_flags Flags, typename R, typename A>
+struct function_object_member_variadic<T,
+                                       Flags,
                                        R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) const && noexcept>>>>
+                                       A,
+                                       void_t<type_t<function_object_member<T, Flags, R, A>>>>
+    : function_object_member<T, Flags, R, A>
 {
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const && noexcept>>;
 };
 
-// volatile noexcept ellipsis
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) volatile noexcept>>>>
+template <typename T, typename R, typename A>
+struct function_object_type_r
+    : function_object_member_variadic<T, function_object_flags<T>::value, R, A>
 {
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) volatile noexcept>>;
 };
 
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) volatile & noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) volatile & noexcept>>;
-};
+// noexcept call operator is preferred over potentially throwing.
 
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) volatile && noexcept>>>>
+template <typename T, typename R, typename A, typename = void>
+struct function_object_type_noexcept_r
+    : function_object_type_r<T, R, A>
 {
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) volatile && noexcept>>;
 };
 
-// const volatile noexcept ellipsis
+#if __cpp_noexcept_function_type >= 201510L
 
-template <typename T, typename R, typename... Args>
+template <typename T, typename R, typename A>
 struct function_object_type_noexcept_r<T,
                                        R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) const volatile noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const volatile noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) const volatile & noexcept>>>>
-{
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const volatile & noexcept>>;
-};
-
-template <typename T, typename R, typename... Args>
-struct function_object_type_noexcept_r<T&&,
-                                       R,
-                                       prototype<Args...>,
-                                       void_t<enable_if_t<is_same<T, const volatile remove_cv_t<T>>::value>,
-                                              type_t<function_object_probe<R (T::*)(Args..., ...) const volatile && noexcept>>>>
+                                       A,
+                                       void_t<type_t<function_object_member_variadic<T, function_object_flags<T>::value | function_noexcept, R, A>>>>
+    : function_object_member_variadic<T, function_object_flags<T>::value | function_noexcept, R, A>
 {
-    using type = type_t<function_object_probe<R (T::*)(Args..., ...) const volatile && noexcept>>;
 };
 
 #endif
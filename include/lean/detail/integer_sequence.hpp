@@ -0,0 +1,167 @@
+#ifndef LEAN_DETAIL_INTEGER_SEQUENCE_HPP
+#define LEAN_DETAIL_INTEGER_SEQUENCE_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef> // std::size_t
+#include <type_traits>
+#include <utility>
+
+// Kept apart from utility.hpp so type traits can use index sequences
+
+// Compiler builtins produce the sequence without recursive instantiations
+
+#if defined(__has_builtin)
+# if __has_builtin(__make_integer_seq)
+#  define LEAN_HAS_MAKE_INTEGER_SEQ 1
+# elif __has_builtin(__integer_pack)
+#  define LEAN_HAS_INTEGER_PACK 1
+# endif
+#elif defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 8)
+# define LEAN_HAS_INTEGER_PACK 1
+#endif
+
+namespace lean
+{
+
+//-----------------------------------------------------------------------------
+// integer_sequence
+
+#if __cpp_lib_integer_sequence >= 201304L
+
+using std::integer_sequence;
+using std::index_sequence;
+
+using std::make_integer_sequence;
+using std::make_index_sequence;
+
+using std::index_sequence_for;
+
+#else
+
+// Partly inspired by Boost::Mpl11
+
+template <typename T, T... Ints>
+struct integer_sequence
+{
+    using value_type = T;
+    static constexpr std::size_t size() noexcept { return sizeof...(Ints); }
+};
+
+template <std::size_t... Ints>
+using index_sequence = integer_sequence<std::size_t, Ints...>;
+
+namespace detail
+{
+
+// Sequences are built eight elements at a time: the sequence for N / 8 is
+// repeated eight times and the N % 8 remainder is appended from a table.
+// The nesting depth is log8(N) and every intermediate sequence is cached,
+// so make_integer_sequence<T, 2 * N> reuses most of the work for N.
+//
+// The offsets use sizeof... directly because a static data member is
+// evaluated once per element, which is much slower for long sequences.
+
+template <typename T, typename Seq, typename Tail>
+struct integer_sequence_octuple;
+
+template <typename T, T... Ints, T... Tail>
+struct integer_sequence_octuple<T, integer_sequence<T, Ints...>, integer_sequence<T, Tail...>>
+{
+    using type = integer_sequence<T,
+                                  Ints...,
+                                  (Ints + T(sizeof...(Ints)))...,
+                                  (Ints + 2 * T(sizeof...(Ints)))...,
+                                  (Ints + 3 * T(sizeof...(Ints)))...,
+                                  (Ints + 4 * T(sizeof...(Ints)))...,
+                                  (Ints + 5 * T(sizeof...(Ints)))...,
+                                  (Ints + 6 * T(sizeof...(Ints)))...,
+                                  (Ints + 7 * T(sizeof...(Ints)))...,
+                                  (Tail + 8 * T(sizeof...(Ints)))...>;
+};
+
+template <typename T, std::size_t>
+struct integer_sequence_tail;
+
+template <typename T>
+struct integer_sequence_tail<T, 0> { using type = integer_sequence<T>; };
+
+template <typename T>
+struct integer_sequence_tail<T, 1> { using type = integer_sequence<T, 0>; };
+
+template <typename T>
+struct integer_sequence_tail<T, 2> { using type = integer_sequence<T, 0, 1>; };
+
+template <typename T>
+struct integer_sequence_tail<T, 3> { using type = integer_sequence<T, 0, 1, 2>; };
+
+template <typename T>
+struct integer_sequence_tail<T, 4> { using type = integer_sequence<T, 0, 1, 2, 3>; };
+
+template <typename T>
+struct integer_sequence_tail<T, 5> { using type = integer_sequence<T, 0, 1, 2, 3, 4>; };
+
+template <typename T>
+struct integer_sequence_tail<T, 6> { using type = integer_sequence<T, 0, 1, 2, 3, 4, 5>; };
+
+template <typename T>
+struct integer_sequence_tail<T, 7> { using type = integer_sequence<T, 0, 1, 2, 3, 4, 5, 6>; };
+
+template <typename C>
+struct make_integer_sequence
+{
+    static_assert(C::value >= 0, "N cannot be negative");
+
+    using type = typename integer_sequence_octuple<
+        typename C::value_type,
+        typename make_integer_sequence<std::integral_constant<typename C::value_type, C::value / 8>>::type,
+        typename integer_sequence_tail<typename C::value_type, std::size_t(C::value % 8)>::type>::type;
+};
+
+template <typename T>
+struct make_integer_sequence<std::integral_constant<T, 0>>
+{
+    using type = integer_sequence<T>;
+};
+
+} // namespace detail
+
+#if defined(LEAN_HAS_MAKE_INTEGER_SEQ)
+
+template <typename T, T N>
+using make_integer_sequence = __make_integer_seq<integer_sequence, T, N>;
+
+#elif defined(LEAN_HAS_INTEGER_PACK)
+
+template <typename T, T N>
+using make_integer_sequence = integer_sequence<T, __integer_pack(N)...>;
+
+#else
+
+template <typename T, T N>
+using make_integer_sequence = typename detail::make_integer_sequence<std::integral_constant<T, N>>::type;
+
+#endif
+
+template <std::size_t N>
+using make_index_sequence = make_integer_sequence<std::size_t, N>;
+
+template <typename... T>
+using index_sequence_for = make_index_sequence<sizeof...(T)>;
+
+#endif
+
+} // namespace lean
+
+#undef LEAN_HAS_MAKE_INTEGER_SEQ
+#undef LEAN_HAS_INTEGER_PACK
+
+#endif // LEAN_DETAIL_INTEGER_SEQUENCE_HPP
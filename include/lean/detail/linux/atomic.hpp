@@ -11,12 +11,35 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef> // std::size_t
+#include <lean/new.hpp>
 #include <lean/detail/linux/futex.hpp>
 
+// Define LEAN_ATOMIC_PADDING to place the value and the futex counter on
+// separate cache lines, so waiters updating the counter do not interfere
+// with threads accessing the value.
+//
+// This increases the size of each atomic to twice the destructive
+// interference size.
+
+#if !defined(LEAN_ATOMIC_PADDING)
+# define LEAN_ATOMIC_PADDING 0
+#endif
+
 namespace lean
 {
 namespace v1
 {
+namespace detail
+{
+
+constexpr std::size_t atomic_futex_alignment = LEAN_ATOMIC_PADDING
+    ? hardware_destructive_interference_size
+    : alignof(futex);
+
+} // namespace detail
+
+class wait_counters;
 
 template <typename T>
 class atomic : public std::atomic<T>
@@ -30,9 +53,14 @@ public:
     void wait(value_type old,
               std::memory_order order = std::memory_order_seq_cst) const noexcept
     {
-        while (base::load(order) == old)
+        for (;;)
         {
-            if (!futex.wait())
+            // Counter is read before value, so a notification between the
+            // value check and the futex call is not lost
+            auto counter = futex.load(std::memory_order_acquire);
+            if (base::load(order) != old)
+                break;
+            if (LEAN_UNLIKELY(!futex.wait(counter)))
                 break;
         }
     }
@@ -47,8 +75,21 @@ public:
         futex.notify_all();
     }
 
+    //! @brief Counts waits and notifications on this atomic in counters.
+    //!
+    //! Has no effect without LEAN_WAIT_STATISTICS.
+
+    void set_wait_counters(wait_counters& counters) noexcept
+    {
+#if LEAN_WAIT_STATISTICS
+        futex.set_counters(&counters);
+#else
+        (void)counters;
+#endif
+    }
+
 private:
-    detail::futex futex;
+    alignas(detail::atomic_futex_alignment) detail::futex futex;
 };
 
 template <typename T>
@@ -13,6 +13,10 @@
 
 #include <cstdint> // std::uint32_t
 #include <atomic>
+#include <lean/detail/config.hpp>
+#if LEAN_WAIT_STATISTICS
+# include <lean/detail/wait_statistics.hpp>
+#endif
 
 namespace lean
 {
@@ -26,20 +30,52 @@ class futex
 public:
     using value_type = std::uint32_t;
 
-    bool wait() const noexcept;
+    // Returns the notification counter.
+    //
+    // Must be read before checking the wait condition to avoid missing
+    // notifications made after the check.
+    value_type load(std::memory_order = std::memory_order_seq_cst) const noexcept;
+
+    // Blocks until notified if the notification counter still is old.
+    //
+    // Returns false on unexpected errors.
+    LEAN_ATTRIBUTE_COLD
+    bool wait(value_type old) const noexcept;
+
+    // Increments the notification counter and wakes up waiters.
+    //
+    // The system call is skipped if there are no waiters.
     void notify_one() noexcept;
     void notify_all() noexcept;
 
+#if LEAN_WAIT_STATISTICS
+    // Counters used outside a wait_scope. Null selects the global counters.
+    void set_counters(wait_counters *other) noexcept
+    {
+        counters = other;
+    }
+#endif
+
 private:
-    value_type load(std::memory_order = std::memory_order_seq_cst) const noexcept;
     value_type fetch_add(value_type, std::memory_order = std::memory_order_seq_cst) noexcept;
+    LEAN_ATTRIBUTE_COLD
+    void wake(int count) noexcept;
 
 private:
     value_type value = 0;
+    // Number of threads inside wait
+    mutable value_type waiters = 0;
+#if LEAN_WAIT_STATISTICS
+    wait_counters *counters = nullptr;
+#endif
 };
 
 } // namespace detail
 } // namespace v1
 } // namespace lean
 
+#if defined(LEAN_HEADER_ONLY)
+# include <lean/detail/linux/futex.ipp>
+#endif
+
 #endif // LEAN_DETAIL_LINUX_FUTEX_HPP
@@ -0,0 +1,158 @@
+#ifndef LEAN_DETAIL_LINUX_FUTEX_IPP
+#define LEAN_DETAIL_LINUX_FUTEX_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Included by futex.hpp with LEAN_HEADER_ONLY, and by lean-core otherwise.
+
+#include <cerrno>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <thread> // std::this_thread::yield
+#if LEAN_WAIT_STATISTICS
+# include <chrono>
+#endif
+#include <lean/detail/config.hpp>
+#include <lean/detail/linux/futex.hpp>
+
+namespace lean
+{
+namespace v1
+{
+namespace detail
+{
+
+constexpr int futex_memory_order(std::memory_order order)
+{
+    // Ignores consume memory order
+    return (order == std::memory_order_seq_cst
+            ? __ATOMIC_SEQ_CST
+            : (order == std::memory_order_acq_rel
+               ? __ATOMIC_ACQ_REL
+               : (order == std::memory_order_acquire
+                  ? __ATOMIC_ACQUIRE
+                  : (order == std::memory_order_release
+                     ? __ATOMIC_RELEASE
+                     : __ATOMIC_RELAXED))));
+}
+
+#if LEAN_WAIT_STATISTICS
+
+// Innermost wait_scope, then the counters of the atomic, then global
+inline wait_counters& futex_counters(wait_counters *counters) noexcept
+{
+    if (auto scoped = wait_scope::current())
+        return *scoped;
+    return counters ? *counters : wait_counters::global();
+}
+
+#endif
+
+LEAN_DECL
+auto futex::load(std::memory_order order) const noexcept -> futex::value_type
+{
+    return __atomic_load_n(&value, futex_memory_order(order));
+}
+
+LEAN_DECL
+auto futex::fetch_add(value_type arg, std::memory_order order) noexcept -> futex::value_type
+{
+    return __atomic_fetch_add(&value, arg, futex_memory_order(order));
+}
+
+LEAN_DECL
+bool futex::wait(value_type old) const noexcept
+{
+    // The waiter is announced before the counter is checked, and notify
+    // increments the counter before checking for waiters, so either the
+    // waiter sees the new counter or notify sees the waiter.
+    __atomic_fetch_add(&waiters, 1, __ATOMIC_SEQ_CST);
+#if LEAN_WAIT_STATISTICS
+    const auto start = std::chrono::steady_clock::now();
+    std::uint64_t syscalls = 0;
+#endif
+    bool result = true;
+    while (__atomic_load_n(&value, __ATOMIC_SEQ_CST) == old)
+    {
+#if LEAN_WAIT_STATISTICS
+        ++syscalls;
+#endif
+        auto rc = ::syscall(SYS_futex,
+                            static_cast<const void *>(&value),
+                            FUTEX_WAIT_PRIVATE,
+                            old,
+                            /* timeout */ nullptr);
+        if (LEAN_LIKELY((rc == 0) || (errno == EAGAIN) || (errno == EINTR)))
+        {
+            // Spurious wake-up
+            std::this_thread::yield();
+        }
+        else
+        {
+            result = false;
+            break;
+        }
+    }
+    __atomic_fetch_sub(&waiters, 1, __ATOMIC_RELEASE);
+#if LEAN_WAIT_STATISTICS
+    // Every system call but the last returned with an unchanged counter
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    futex_counters(counters).add_wait(
+        syscalls,
+        (syscalls > 0) ? syscalls - 1 : 0,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+#endif
+    return result;
+}
+
+LEAN_DECL
+void futex::wake(int count) noexcept
+{
+    ::syscall(SYS_futex,
+              static_cast<const void *>(&value),
+              FUTEX_WAKE_PRIVATE,
+              count);
+}
+
+LEAN_DECL
+void futex::notify_one() noexcept
+{
+    fetch_add(1, std::memory_order_seq_cst);
+    const bool has_waiters = __atomic_load_n(&waiters, __ATOMIC_SEQ_CST) != 0;
+#if LEAN_WAIT_STATISTICS
+    futex_counters(counters).add_notify(has_waiters);
+#endif
+    if (LEAN_UNLIKELY(has_waiters))
+    {
+        wake(1);
+    }
+}
+
+LEAN_DECL
+void futex::notify_all() noexcept
+{
+    fetch_add(1, std::memory_order_seq_cst);
+    const bool has_waiters = __atomic_load_n(&waiters, __ATOMIC_SEQ_CST) != 0;
+#if LEAN_WAIT_STATISTICS
+    futex_counters(counters).add_notify(has_waiters);
+#endif
+    if (LEAN_UNLIKELY(has_waiters))
+    {
+        wake(~0);
+    }
+}
+
+} // namespace detail
+} // namespace v1
+} // namespace lean
+
+#endif // LEAN_DETAIL_LINUX_FUTEX_IPP
@@ -0,0 +1,55 @@
+#ifndef LEAN_DETAIL_SPECIAL_MEMBERS_HPP
+#define LEAN_DETAIL_SPECIAL_MEMBERS_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace lean
+{
+namespace v1
+{
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// Base classes that delete copy and move operations of the derived class
+// when the contained types do not support them.
+
+template <bool>
+struct enable_copy {};
+
+template <>
+struct enable_copy<false>
+{
+    enable_copy() = default;
+    enable_copy(const enable_copy&) = delete;
+    enable_copy(enable_copy&&) = default;
+    enable_copy& operator=(const enable_copy&) = delete;
+    enable_copy& operator=(enable_copy&&) = default;
+};
+
+template <bool>
+struct enable_move {};
+
+template <>
+struct enable_move<false>
+{
+    enable_move() = default;
+    enable_move(const enable_move&) = default;
+    enable_move(enable_move&&) = delete;
+    enable_move& operator=(const enable_move&) = default;
+    enable_move& operator=(enable_move&&) = delete;
+};
+
+} // namespace detail
+} // namespace v1
+} // namespace lean
+
+#endif // LEAN_DETAIL_SPECIAL_MEMBERS_HPP
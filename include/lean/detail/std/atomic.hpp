@@ -18,6 +18,8 @@ namespace v1
 
 static_assert(__cpp_lib_atomic_wait >= 201907L, "<atomic> not included");
 
+class wait_counters;
+
 template <typename T>
 class atomic : public std::atomic<T>
 {
@@ -25,6 +27,9 @@ class atomic : public std::atomic<T>
 public:
     using value_type = T;
     using base::base;
+
+    // Waits in the standard library are not instrumented
+    void set_wait_counters(wait_counters&) noexcept {}
 };
 
 template <typename T>
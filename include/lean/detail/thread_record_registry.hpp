@@ -0,0 +1,261 @@
+#ifndef LEAN_DETAIL_THREAD_RECORD_REGISTRY_HPP
+#define LEAN_DETAIL_THREAD_RECORD_REGISTRY_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <lean/detail/config.hpp>
+#include <lean/new.hpp>
+
+namespace lean
+{
+namespace v1
+{
+namespace detail
+{
+
+// Identifiers of live domains.
+//
+// Threads release their records on exit under the mutex, and only if the
+// domain is still alive, so a destroyed domain cannot have its records
+// touched afterwards.
+struct thread_record_domains
+{
+    static thread_record_domains& instance()
+    {
+        static thread_record_domains self;
+        return self;
+    }
+
+    bool contains(std::uint64_t id) const noexcept
+    {
+        return std::find(live.begin(), live.end(), id) != live.end();
+    }
+
+    std::mutex mutex;
+    // Identifiers are never reused
+    std::uint64_t last_id = 0;
+    std::vector<std::uint64_t> live;
+};
+
+//! @brief Per-thread records of a domain.
+//!
+//! Each thread using a domain owns one record, which is created on first
+//! use and kept in a lock-free list. The record of an exited thread is
+//! reused by the next new thread.
+//!
+//! Record must be constructible from the arguments passed to local(), and
+//! have the members
+//!
+//!   std::atomic<bool> in_use{ true };
+//!   Record *next = nullptr;
+//!
+//! If Record has a member function reacquire(args...), then it is called
+//! with the arguments passed to local() when the record of an exited thread
+//! is reused.
+//!
+//! Domains are identified by a unique number rather than their address, so
+//! a thread can keep entries for destroyed domains without harm.
+
+template <typename Record, typename... Args>
+auto thread_record_reacquire(Record& data, int, Args&&... args)
+    -> decltype(data.reacquire(std::forward<Args>(args)...))
+{
+    data.reacquire(std::forward<Args>(args)...);
+}
+
+template <typename Record, typename... Args>
+void thread_record_reacquire(Record&, long, Args&&...)
+{
+}
+
+template <typename Domain, typename Record>
+class thread_record_registry
+{
+public:
+    thread_record_registry()
+    {
+        auto& domains = thread_record_domains::instance();
+        std::lock_guard<std::mutex> lock(domains.mutex);
+        id = ++domains.last_id;
+        domains.live.push_back(id);
+    }
+
+    thread_record_registry(const thread_record_registry&) = delete;
+    thread_record_registry& operator=(const thread_record_registry&) = delete;
+
+    //! @brief Deletes all records.
+    //!
+    //! @pre No record is accessed by other threads.
+
+    ~thread_record_registry()
+    {
+        {
+            auto& domains = thread_record_domains::instance();
+            std::lock_guard<std::mutex> lock(domains.mutex);
+            domains.live.erase(std::find(domains.live.begin(), domains.live.end(), id));
+        }
+        Record *current = head.load(std::memory_order_acquire);
+        while (current)
+        {
+            Record *next = current->next;
+            aligned_delete(current);
+            current = next;
+        }
+    }
+
+    //! @brief Returns first record in the list of all records.
+
+    Record *front() const noexcept
+    {
+        return head.load(std::memory_order_acquire);
+    }
+
+    //! @brief Returns the number of records.
+    //!
+    //! Records are never removed, so this is the largest number of threads
+    //! that have used the domain at the same time.
+
+    std::size_t size() const noexcept
+    {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    //! @brief Returns the record of the calling thread.
+    //!
+    //! Repeated calls from a thread with the same domain cost a thread-local
+    //! load and a comparison.
+    //!
+    //! @throws std::bad_alloc if a new record cannot be allocated.
+
+    template <typename... Args>
+    Record& local(Args&&... args)
+    {
+        auto& last = cache();
+        if (LEAN_LIKELY(last.id == id))
+            return *last.data;
+        return local_slow(std::forward<Args>(args)...);
+    }
+
+private:
+    struct entry
+    {
+        std::uint64_t id;
+        Record *data;
+    };
+
+    // Trivially destructible, so access needs no initialization guard
+    static entry& cache() noexcept
+    {
+        static thread_local entry self = { 0, nullptr };
+        return self;
+    }
+
+    struct thread_entries
+    {
+        ~thread_entries()
+        {
+            cache() = { 0, nullptr };
+            auto& domains = thread_record_domains::instance();
+            std::lock_guard<std::mutex> lock(domains.mutex);
+            for (auto& item : entries)
+            {
+                // Remaining work in the record is done by the next owner
+                if (domains.contains(item.id))
+                    item.data->in_use.store(false, std::memory_order_release);
+            }
+        }
+
+        static thread_entries& instance()
+        {
+            static thread_local thread_entries self;
+            return self;
+        }
+
+        std::vector<entry> entries;
+    };
+
+    template <typename... Args>
+    LEAN_ATTRIBUTE_NOINLINE
+    Record& local_slow(Args&&... args)
+    {
+        auto& local = thread_entries::instance();
+        for (auto& item : local.entries)
+        {
+            if (item.id == id)
+            {
+                cache() = item;
+                return *item.data;
+            }
+        }
+
+        {
+            // Drop entries of destroyed domains
+            auto& domains = thread_record_domains::instance();
+            std::lock_guard<std::mutex> lock(domains.mutex);
+            local.entries.erase(std::remove_if(local.entries.begin(),
+                                               local.entries.end(),
+                                               [&domains] (const entry& item) {
+                                                   return !domains.contains(item.id);
+                                               }),
+                                local.entries.end());
+        }
+        // Ensure that the acquired record can be registered
+        local.entries.reserve(local.entries.size() + 1);
+        Record *data = acquire(std::forward<Args>(args)...);
+        local.entries.push_back({ id, data });
+        cache() = local.entries.back();
+        return *data;
+    }
+
+    template <typename... Args>
+    Record *acquire(Args&&... args)
+    {
+        // Reuse record from exited thread
+        for (Record *current = head.load(std::memory_order_acquire);
+             current;
+             current = current->next)
+        {
+            bool expected = false;
+            if (!current->in_use.load(std::memory_order_relaxed) &&
+                current->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                thread_record_reacquire(*current, 0, std::forward<Args>(args)...);
+                return current;
+            }
+        }
+
+        Record *data = aligned_new<Record>(std::forward<Args>(args)...);
+        data->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(data->next, data, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+        count.fetch_add(1, std::memory_order_relaxed);
+        return data;
+    }
+
+private:
+    std::atomic<Record *> head{ nullptr };
+    std::atomic<std::size_t> count{ 0 };
+    std::uint64_t id;
+};
+
+} // namespace detail
+} // namespace v1
+} // namespace lean
+
+#endif // LEAN_DETAIL_THREAD_RECORD_REGISTRY_HPP
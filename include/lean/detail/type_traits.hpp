@@ -11,7 +11,21 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef> // std::size_t
 #include <type_traits>
+#include <utility> // std::declval
+#include <lean/detail/integer_sequence.hpp>
+
+// Builtin type traits
+
+#if defined(__has_builtin)
+# if __has_builtin(__is_same)
+#  define LEAN_HAS_BUILTIN_IS_SAME 1
+# endif
+# if __has_builtin(__type_pack_element)
+#  define LEAN_HAS_TYPE_PACK_ELEMENT 1
+# endif
+#endif
 
 namespace lean
 {
@@ -439,25 +453,71 @@ struct type_bind_projection
 // type_contains
 //
 // Checks if the first type appears later in the parameter pack.
+//
+// Comparisons are expanded in a single pack expansion, so the instantiation
+// depth does not grow with the size of the parameter pack.
+
+namespace impl
+{
+
+template <bool...>
+struct bool_pack;
+
+#if defined(LEAN_HAS_BUILTIN_IS_SAME)
+
+template <typename T, typename... Ts>
+struct type_contains
+    : public bool_constant<!std::is_same<bool_pack<false, __is_same(T, Ts)...>,
+                                         bool_pack<__is_same(T, Ts)..., false>>::value>
+{
+};
+
+#else
+
+template <typename T, typename... Ts>
+struct type_contains
+    : public bool_constant<!std::is_same<bool_pack<false, std::is_same<T, Ts>::value...>,
+                                         bool_pack<std::is_same<T, Ts>::value..., false>>::value>
+{
+};
+
+#endif
+
+} // namespace impl
+
+template <typename T, typename... Ts>
+struct type_contains
+    : public impl::type_contains<T, Ts...>
+{
+};
+
+//-----------------------------------------------------------------------------
+// type_find
+//
+// Index of the first type in the parameter pack that matches the first type.
+//
+// type_find<int, bool, int, float> == 1
+//
+// Returns sizeof...(Types) if the type is not found.
 
 template <typename, typename...>
-struct type_contains;
+struct type_find;
 
 template <typename T>
-struct type_contains<T>
-    : public std::false_type
+struct type_find<T>
+    : public integral_constant<std::size_t, 0>
 {
 };
 
 template <typename T, typename... Tail>
-struct type_contains<T, T, Tail...>
-    : public std::true_type
+struct type_find<T, T, Tail...>
+    : public integral_constant<std::size_t, 0>
 {
 };
 
 template <typename T, typename Head, typename... Tail>
-struct type_contains<T, Head, Tail...>
-    : public type_contains<T, Tail...>
+struct type_find<T, Head, Tail...>
+    : public integral_constant<std::size_t, 1 + type_find<T, Tail...>::value>
 {
 };
 
@@ -468,50 +528,84 @@ struct type_contains<T, Head, Tail...>
 //
 // type = Ti
 // value = i
+//
+// F is not required to be associative, so the fold cannot be reshaped into a
+// tree. Instead eight types are folded per instantiation to reduce the
+// instantiation depth.
 
 namespace impl
 {
 
-template <std::size_t N, std::size_t M, template <typename, typename> class, typename...>
-struct type_fold_left;
-
-template <std::size_t N, std::size_t M, template <typename, typename> class F>
-struct type_fold_left<N, M, F>;
+// Accumulated type and its index
 
-template <std::size_t N, std::size_t M, template <typename, typename> class F, typename T>
-struct type_fold_left<N, M, F, T>
+template <typename T, std::size_t N>
+struct type_fold_state
 {
     using type = T;
     static constexpr std::size_t value = N;
     constexpr operator std::size_t() const noexcept { return value; }
 };
 
-template <std::size_t N, std::size_t M, template <typename, typename> class F, typename Lhs, typename Rhs>
-struct type_fold_left<N, M, F, Lhs, Rhs>
+template <template <typename, typename> class F, typename State, std::size_t N, typename T>
+struct type_fold_step
 {
-    using type = typename F<Lhs, Rhs>::type;
-    static constexpr std::size_t value = is_same<type, Lhs>::value ? N : M;
-    constexpr operator std::size_t() const noexcept { return value; }
+private:
+    using result_type = typename F<typename State::type, T>::type;
+
+public:
+    using type = type_fold_state<result_type,
+                                 is_same<result_type, typename State::type>::value ? State::value : N>;
 };
 
-template <std::size_t N, std::size_t M, template <typename, typename> class F, typename Lhs, typename Rhs, typename... Tail>
-struct type_fold_left<N, M, F, Lhs, Rhs, Tail...>
+template <template <typename, typename> class F, typename State, std::size_t N, typename T>
+using type_fold_step_t = typename type_fold_step<F, State, N, T>::type;
+
+template <template <typename, typename> class F, typename State, std::size_t N, typename...>
+struct type_fold_left
+    : public State
 {
-private:
-    using head_type = type_fold_left<N, N + 1, F, Lhs, Rhs>;
-    using recursive_type = type_fold_left<head_type::value, N + 2, F, typename head_type::type, Tail...>;
+};
 
-public:
-    using type = typename recursive_type::type;
-    static constexpr std::size_t value = recursive_type::value;
-    constexpr operator std::size_t() const noexcept { return value; }
+template <template <typename, typename> class F, typename State, std::size_t N, typename T, typename... Tail>
+struct type_fold_left<F, State, N, T, Tail...>
+    : public type_fold_left<F, type_fold_step_t<F, State, N, T>, N + 1, Tail...>
+{
+};
+
+template <template <typename, typename> class F, typename State, std::size_t N,
+          typename T0, typename T1, typename T2, typename T3,
+          typename T4, typename T5, typename T6, typename T7,
+          typename... Tail>
+struct type_fold_left<F, State, N, T0, T1, T2, T3, T4, T5, T6, T7, Tail...>
+    : public type_fold_left<F,
+                            type_fold_step_t<F,
+                            type_fold_step_t<F,
+                            type_fold_step_t<F,
+                            type_fold_step_t<F,
+                            type_fold_step_t<F,
+                            type_fold_step_t<F,
+                            type_fold_step_t<F,
+                            type_fold_step_t<F, State, N, T0>,
+                                                       N + 1, T1>,
+                                                       N + 2, T2>,
+                                                       N + 3, T3>,
+                                                       N + 4, T4>,
+                                                       N + 5, T5>,
+                                                       N + 6, T6>,
+                                                       N + 7, T7>,
+                            N + 8,
+                            Tail...>
+{
 };
 
 } // namespace impl
 
 template <template <typename, typename> class F, typename... Types>
-struct type_fold_left
-    : impl::type_fold_left<0, 0, F, Types...>
+struct type_fold_left;
+
+template <template <typename, typename> class F, typename T, typename... Types>
+struct type_fold_left<F, T, Types...>
+    : impl::type_fold_left<F, impl::type_fold_state<T, 0>, 1, Types...>
 {
 };
 
@@ -545,12 +639,10 @@ using type_front_t = typename type_front<Ts...>::type;
 // type_element<2, bool, int, float> == float
 //
 // Constraint: N <= sizeof...(Ts)
-
-#if defined(__has_builtin)
-# if __has_builtin(__type_pack_element)
-#  define LEAN_HAS_TYPE_PACK_ELEMENT 1
-# endif
-#endif
+//
+// Without the compiler builtin, the types are bases of an index-tagged set,
+// and overload resolution selects the base with index N. This does not
+// recurse over the parameter pack.
 
 #if defined(LEAN_HAS_TYPE_PACK_ELEMENT)
 
@@ -565,24 +657,28 @@ struct type_element
 namespace impl
 {
 
-template <std::size_t N, typename, typename... Tail>
-struct type_element
-    : public type_element<N - 1, Tail...>
-{
-};
-
-template <typename T, typename... Tail>
-struct type_element<0, T, Tail...>
+template <std::size_t N, typename T>
+struct type_element_entry
 {
     using type = T;
 };
 
-template <typename U, typename T, typename... Tail>
-struct type_element<1, U, T, Tail...>
+template <typename, typename...>
+struct type_element_set;
+
+template <std::size_t... Ints, typename... Ts>
+struct type_element_set<index_sequence<Ints...>, Ts...>
+    : public type_element_entry<Ints, Ts>...
 {
-    using type = T;
 };
 
+// Declaration only, used in unevaluated context
+template <std::size_t N, typename T>
+type_element_entry<N, T> type_element_select(const type_element_entry<N, T>&);
+
+template <std::size_t N, typename... Ts>
+using type_element = decltype(type_element_select<N>(std::declval<type_element_set<index_sequence_for<Ts...>, Ts...>>()));
+
 } // namespace impl
 
 template <std::size_t N, typename... Ts>
@@ -596,8 +692,6 @@ struct type_element
 template <std::size_t N, typename... Ts>
 using type_element_t = typename type_element<N, Ts...>::type;
 
-#undef LEAN_HAS_TYPE_PACK_ELEMENT
-
 //-----------------------------------------------------------------------------
 // type_sizeof
 
@@ -607,6 +701,15 @@ struct type_sizeof
 {
 };
 
+//-----------------------------------------------------------------------------
+// type_alignof
+
+template <typename T>
+struct type_alignof
+    : public std::integral_constant<std::size_t, alignof(T)>
+{
+};
+
 //-----------------------------------------------------------------------------
 // type_predicate_min
 //
@@ -668,7 +771,7 @@ template <template <typename> class Projection, typename... Types>
 using type_min_with_t = typename type_min_with<Projection, Types...>::type;
 
 template <typename... Types>
-using type_min_t = typename type_min_with<type_identity, Types...>::type;
+using type_min_t = typename type_min_with<type_identity_t, Types...>::type;
 
 //-----------------------------------------------------------------------------
 // type_find_min
@@ -698,7 +801,7 @@ template <template <typename> class Projection, typename... Types>
 using type_max_with_t = typename type_max_with<Projection, Types...>::type;
 
 template <typename... Types>
-using type_max_t = typename type_max_with<type_identity, Types...>::type;
+using type_max_t = typename type_max_with<type_identity_t, Types...>::type;
 
 //-----------------------------------------------------------------------------
 // type_find_max
@@ -715,4 +818,7 @@ using type_find_max = type_find_max_with<type_identity_t, Types...>;
 
 } // namespace lean
 
+#undef LEAN_HAS_BUILTIN_IS_SAME
+#undef LEAN_HAS_TYPE_PACK_ELEMENT
+
 #endif // LEAN_DETAIL_TYPE_TRAITS_HPP
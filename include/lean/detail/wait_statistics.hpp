@@ -0,0 +1,279 @@
+#ifndef LEAN_DETAIL_WAIT_STATISTICS_HPP
+#define LEAN_DETAIL_WAIT_STATISTICS_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstdint> // std::uint64_t
+#include <mutex>
+#include <lean/detail/config.hpp>
+#include <lean/latency_histogram.hpp>
+#include <lean/new.hpp>
+
+namespace lean
+{
+namespace v1
+{
+
+//! @brief Snapshot of wait counters.
+
+struct wait_statistics
+{
+    //! Name of the counters.
+    const char *name;
+    //! Number of waits that reached the slow path.
+    std::uint64_t waits;
+    //! Number of FUTEX_WAIT system calls.
+    std::uint64_t wait_syscalls;
+    //! Number of wake-ups where the notification counter was unchanged.
+    std::uint64_t spurious_wakeups;
+    //! Total time spent in the slow path of wait.
+    std::uint64_t wait_nanoseconds;
+    //! Longest time spent in the slow path of a single wait.
+    std::uint64_t max_wait_nanoseconds;
+    //! Median time spent in the slow path of a single wait.
+    std::uint64_t p50_wait_nanoseconds;
+    //! 99th percentile of the time spent in the slow path of a single wait.
+    std::uint64_t p99_wait_nanoseconds;
+    //! Number of notifications.
+    std::uint64_t notifies;
+    //! Number of FUTEX_WAKE system calls.
+    std::uint64_t wake_syscalls;
+    //! Number of notifications that skipped the system call.
+    std::uint64_t notifies_without_waiters;
+};
+
+//! @brief Named set of wait counters.
+//!
+//! Waits and notifications are counted in the counters of the innermost
+//! wait_scope on the calling thread, or else in the counters attached to the
+//! atomic, or else in the global counters.
+//!
+//! Counters are only updated with LEAN_WAIT_STATISTICS. All counters are
+//! registered so they can be reported together.
+
+class alignas(hardware_destructive_interference_size) wait_counters
+{
+public:
+    //! @brief Creates and registers counters.
+    //!
+    //! @param name Name used in reports. Must outlive the counters.
+
+    explicit wait_counters(const char *name) noexcept
+        : label(name)
+    {
+        auto& self = registry();
+        std::lock_guard<std::mutex> lock(self.mutex);
+        next = self.head;
+        self.head = this;
+    }
+
+    wait_counters(const wait_counters&) = delete;
+    wait_counters& operator=(const wait_counters&) = delete;
+
+    ~wait_counters()
+    {
+        auto& self = registry();
+        std::lock_guard<std::mutex> lock(self.mutex);
+        for (wait_counters **current = &self.head; *current; current = &(*current)->next)
+        {
+            if (*current == this)
+            {
+                *current = next;
+                break;
+            }
+        }
+    }
+
+    //! @brief Counters used when no other counters are selected.
+
+    static wait_counters& global() noexcept
+    {
+        static wait_counters instance("global");
+        return instance;
+    }
+
+    const char *name() const noexcept
+    {
+        return label;
+    }
+
+    //! @brief Returns the current counter values.
+    //!
+    //! Counters are read individually, so a snapshot taken during a wait
+    //! need not be consistent across counters.
+
+    wait_statistics snapshot() const noexcept
+    {
+        return {
+            label,
+            waits.load(std::memory_order_relaxed),
+            wait_syscalls.load(std::memory_order_relaxed),
+            spurious_wakeups.load(std::memory_order_relaxed),
+            wait_nanoseconds.load(std::memory_order_relaxed),
+            max_wait_nanoseconds.load(std::memory_order_relaxed),
+            durations.percentile(50.0),
+            durations.percentile(99.0),
+            notifies.load(std::memory_order_relaxed),
+            wake_syscalls.load(std::memory_order_relaxed),
+            notifies_without_waiters.load(std::memory_order_relaxed)
+        };
+    }
+
+    //! @brief Sets all counters to zero.
+
+    void reset() noexcept
+    {
+        waits.store(0, std::memory_order_relaxed);
+        wait_syscalls.store(0, std::memory_order_relaxed);
+        spurious_wakeups.store(0, std::memory_order_relaxed);
+        wait_nanoseconds.store(0, std::memory_order_relaxed);
+        max_wait_nanoseconds.store(0, std::memory_order_relaxed);
+        notifies.store(0, std::memory_order_relaxed);
+        wake_syscalls.store(0, std::memory_order_relaxed);
+        notifies_without_waiters.store(0, std::memory_order_relaxed);
+        durations.reset();
+    }
+
+    //! @brief Returns the distribution of time spent in the slow path of wait.
+
+    const latency_histogram& wait_durations() const noexcept
+    {
+        return durations;
+    }
+
+    //! @brief Calls function with each registered counters.
+    //!
+    //! Counters cannot be created or destroyed by function.
+
+    template <typename F>
+    static void for_each(F&& function)
+    {
+        auto& self = registry();
+        std::lock_guard<std::mutex> lock(self.mutex);
+        for (const wait_counters *current = self.head; current; current = current->next)
+        {
+            function(*current);
+        }
+    }
+
+    // Updated by the futex backend
+
+    void add_wait(std::uint64_t syscalls,
+                  std::uint64_t spurious,
+                  std::uint64_t nanoseconds) noexcept
+    {
+        waits.fetch_add(1, std::memory_order_relaxed);
+        wait_syscalls.fetch_add(syscalls, std::memory_order_relaxed);
+        spurious_wakeups.fetch_add(spurious, std::memory_order_relaxed);
+        wait_nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        durations.record(nanoseconds);
+        auto current = max_wait_nanoseconds.load(std::memory_order_relaxed);
+        while ((current < nanoseconds) &&
+               !max_wait_nanoseconds.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void add_notify(bool has_waiters) noexcept
+    {
+        notifies.fetch_add(1, std::memory_order_relaxed);
+        if (has_waiters)
+            wake_syscalls.fetch_add(1, std::memory_order_relaxed);
+        else
+            notifies_without_waiters.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    struct registry_type
+    {
+        std::mutex mutex;
+        wait_counters *head = nullptr;
+    };
+
+    static registry_type& registry() noexcept
+    {
+        static registry_type instance;
+        return instance;
+    }
+
+private:
+    std::atomic<std::uint64_t> waits{ 0 };
+    std::atomic<std::uint64_t> wait_syscalls{ 0 };
+    std::atomic<std::uint64_t> spurious_wakeups{ 0 };
+    std::atomic<std::uint64_t> wait_nanoseconds{ 0 };
+    std::atomic<std::uint64_t> max_wait_nanoseconds{ 0 };
+    std::atomic<std::uint64_t> notifies{ 0 };
+    std::atomic<std::uint64_t> wake_syscalls{ 0 };
+    std::atomic<std::uint64_t> notifies_without_waiters{ 0 };
+    latency_histogram durations;
+    const char *label;
+    wait_counters *next = nullptr;
+};
+
+//! @brief Selects counters for waits and notifications on the calling thread.
+//!
+//! Used to tag a call site regardless of which atomic it waits on. Scopes
+//! can be nested.
+//!
+//! Example:
+//!
+//!   static lean::wait_counters pop_counters("queue.pop");
+//!   {
+//!       lean::wait_scope scope(pop_counters);
+//!       tail.wait(old);
+//!   }
+
+class wait_scope
+{
+public:
+    explicit wait_scope(wait_counters& counters) noexcept
+#if LEAN_WAIT_STATISTICS
+        : previous(current())
+    {
+        current() = &counters;
+    }
+#else
+    {
+        (void)counters;
+    }
+#endif
+
+    wait_scope(const wait_scope&) = delete;
+    wait_scope& operator=(const wait_scope&) = delete;
+
+#if LEAN_WAIT_STATISTICS
+    ~wait_scope()
+    {
+        current() = previous;
+    }
+
+    // Innermost counters on the calling thread, or null
+    static wait_counters *& current() noexcept
+    {
+        static thread_local wait_counters *instance = nullptr;
+        return instance;
+    }
+
+private:
+    wait_counters *previous;
+#endif
+};
+
+} // namespace v1
+
+using v1::wait_counters;
+using v1::wait_scope;
+using v1::wait_statistics;
+
+} // namespace lean
+
+#endif // LEAN_DETAIL_WAIT_STATISTICS_HPP
@@ -0,0 +1,358 @@
+#ifndef LEAN_EPOCH_HPP
+#define LEAN_EPOCH_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <vector>
+#include <lean/atomic.hpp>
+#include <lean/new.hpp>
+#include <lean/utility.hpp>
+#include <lean/detail/thread_record_registry.hpp>
+
+#if LEAN_CXX >= LEAN_LIB_ATOMIC_WAIT
+
+namespace lean
+{
+namespace v1
+{
+
+//! @brief Epoch-based memory reclamation.
+//!
+//! Objects removed from a lock-free data structure are retired rather than
+//! deleted. A retired object is deleted once every reader that might have
+//! observed it has left its critical section.
+//!
+//! Readers enter a critical section with pin(). The per-thread record is
+//! looked up through a thread-local cache, so entering costs a load, a store
+//! and a fence, and leaving costs an exchange. Nested critical sections only
+//! touch a thread-local counter. The first pin on a thread allocates its
+//! record.
+//!
+//! Retired objects are collected in per-thread lists, and reclamation is
+//! attempted whenever a list reaches the batch size.
+//!
+//! A single stalled reader prevents all reclamation in the domain.
+//!
+//! Threads that have used the domain may outlive it, but must not use it
+//! during or after its destruction.
+//!
+//! Example:
+//!
+//!   epoch_domain domain;
+//!
+//!   // Reader
+//!   {
+//!     auto guard = domain.pin();
+//!     auto node = head.load(std::memory_order_acquire);
+//!     ...
+//!   }
+//!
+//!   // Writer
+//!   auto node = head.exchange(replacement);
+//!   domain.retire(node);
+
+class epoch_domain
+{
+    struct record;
+
+public:
+    using epoch_type = std::uint32_t;
+
+    class guard;
+
+    //! @brief Creates domain.
+    //!
+    //! @param batch_size Number of retired objects per thread before
+    //!                   reclamation is attempted.
+
+    explicit epoch_domain(std::size_t batch_size = 64) noexcept
+        : batch_size(batch_size)
+    {
+    }
+
+    epoch_domain(const epoch_domain&) = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    //! @brief Destroys domain and deletes all retired objects.
+    //!
+    //! @pre No thread is in a critical section.
+
+    ~epoch_domain()
+    {
+        for (record *current = records.front(); current; current = current->next)
+        {
+            for (auto& item : current->retired)
+                item.deleter(item.pointer);
+        }
+    }
+
+    //! @brief Enters critical section.
+    //!
+    //! Objects retired after entering will not be deleted until the
+    //! returned guard is destroyed.
+    //!
+    //! @throws std::bad_alloc if the record of the calling thread cannot be
+    //!         allocated on first use.
+
+    guard pin();
+
+    //! @brief Retires object for deferred deletion.
+    //!
+    //! @pre Object is no longer reachable by new readers.
+
+    template <typename T>
+    void retire(T *pointer)
+    {
+        retire(static_cast<void *>(pointer),
+               [] (void *self) { delete static_cast<T *>(self); });
+    }
+
+    //! @brief Retires object for deferred deletion with custom deleter.
+
+    void retire(void *pointer, void (*deleter)(void *))
+    {
+        record& self = local_record();
+        // Epoch must be read after the object was unlinked
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        self.retired.push_back({ pointer, deleter, global.load(std::memory_order_relaxed) });
+        if (self.retired.size() >= batch_size)
+        {
+            try_advance();
+            collect(self);
+        }
+    }
+
+    //! @brief Deletes objects retired by the calling thread whose grace
+    //! period has elapsed.
+    //!
+    //! Returns the number of deleted objects.
+
+    std::size_t reclaim()
+    {
+        record& self = local_record();
+        try_advance();
+        return collect(self);
+    }
+
+    //! @brief Blocks until all objects retired by the calling thread have
+    //! been deleted.
+    //!
+    //! Blocks on lean::atomic::wait while readers from older epochs remain in
+    //! their critical sections.
+    //!
+    //! @pre The calling thread is not in a critical section.
+
+    void synchronize()
+    {
+        record& self = local_record();
+        const epoch_type start = global.load(std::memory_order_acquire);
+        while (epoch_type(global.load(std::memory_order_acquire) - start) < grace_period)
+        {
+            if (!try_advance())
+            {
+                wait_for_readers();
+            }
+        }
+        collect(self);
+    }
+
+private:
+    // Record epoch layout
+    //
+    //   bit 0     - active (in critical section)
+    //   bit 1     - writer waiting for reader to leave
+    //   bit 2..31 - global epoch when critical section was entered
+    static constexpr epoch_type active_flag = 1;
+    static constexpr epoch_type waiting_flag = 2;
+    static constexpr epoch_type epoch_mask = ~(active_flag | waiting_flag);
+    static constexpr epoch_type epoch_increment = 4;
+
+    // Retired objects can be deleted after two epoch advances
+    static constexpr epoch_type grace_period = 2 * epoch_increment;
+
+    struct retired_type
+    {
+        void *pointer;
+        void (*deleter)(void *);
+        epoch_type epoch;
+    };
+
+    struct alignas(hardware_destructive_interference_size) record
+    {
+        lean::atomic<epoch_type> epoch{ 0 };
+        std::atomic<bool> in_use{ true };
+        record *next = nullptr;
+        // Owned by thread
+        std::size_t depth = 0;
+        std::vector<retired_type> retired;
+    };
+
+    record& local_record()
+    {
+        return records.local();
+    }
+
+    record *enter()
+    {
+        record& self = local_record();
+        if (self.depth++ == 0)
+        {
+            self.epoch.store(global.load(std::memory_order_relaxed) | active_flag,
+                             std::memory_order_relaxed);
+            // Announcement must be visible before reading shared pointers
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        return &self;
+    }
+
+    static void leave(record *self) noexcept
+    {
+        if (--self->depth == 0)
+        {
+            auto old = self->epoch.exchange(0, std::memory_order_release);
+            if (LEAN_UNLIKELY(old & waiting_flag))
+            {
+                self->epoch.notify_all();
+            }
+        }
+    }
+
+    // Advances the global epoch if all active readers have observed it.
+    //
+    // Returns false if blocked by a reader.
+
+    bool try_advance() noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        epoch_type current = global.load(std::memory_order_relaxed);
+        for (record *data = records.front();
+             data;
+             data = data->next)
+        {
+            // Synchronizes with leave, so reads by the reader happen before
+            // the deletion of objects retired in the next epoch
+            const epoch_type local = data->epoch.load(std::memory_order_acquire);
+            if ((local & active_flag) && ((local & epoch_mask) != current))
+                return false;
+        }
+        // Failure means that another thread has advanced the epoch
+        global.compare_exchange_strong(current,
+                                       current + epoch_increment,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed);
+        return true;
+    }
+
+    // Blocks until readers from older epochs have left.
+
+    LEAN_ATTRIBUTE_NOINLINE LEAN_ATTRIBUTE_COLD
+    void wait_for_readers() noexcept
+    {
+        const epoch_type current = global.load(std::memory_order_acquire);
+        for (record *data = records.front();
+             data;
+             data = data->next)
+        {
+            epoch_type local = data->epoch.load(std::memory_order_acquire);
+            while ((local & active_flag) && ((local & epoch_mask) != current))
+            {
+                if (local & waiting_flag)
+                {
+                    data->epoch.wait(local, std::memory_order_acquire);
+                    local = data->epoch.load(std::memory_order_acquire);
+                }
+                else if (data->epoch.compare_exchange_weak(local,
+                                                           local | waiting_flag,
+                                                           std::memory_order_acq_rel,
+                                                           std::memory_order_acquire))
+                {
+                    local |= waiting_flag;
+                }
+            }
+        }
+    }
+
+    std::size_t collect(record& self)
+    {
+        const epoch_type current = global.load(std::memory_order_acquire);
+        std::size_t count = 0;
+        auto last = self.retired.begin();
+        for (auto& item : self.retired)
+        {
+            if (epoch_type(current - item.epoch) >= grace_period)
+            {
+                item.deleter(item.pointer);
+                ++count;
+            }
+            else
+            {
+                *last++ = item;
+            }
+        }
+        self.retired.erase(last, self.retired.end());
+        return count;
+    }
+
+private:
+    detail::thread_record_registry<epoch_domain, record> records;
+    lean::atomic<epoch_type> global{ 0 };
+    const std::size_t batch_size;
+};
+
+//! @brief Critical section of an epoch domain.
+//!
+//! Readers may access objects obtained within the critical section until
+//! the guard is destroyed.
+
+class epoch_domain::guard
+{
+public:
+    guard(guard&& other) noexcept
+        : data(lean::exchange(other.data, nullptr))
+    {
+    }
+
+    guard(const guard&) = delete;
+    guard& operator=(const guard&) = delete;
+    guard& operator=(guard&&) = delete;
+
+    ~guard()
+    {
+        if (data)
+            epoch_domain::leave(data);
+    }
+
+private:
+    friend class epoch_domain;
+
+    explicit guard(record *data) noexcept
+        : data(data)
+    {
+    }
+
+    record *data;
+};
+
+inline auto epoch_domain::pin() -> guard
+{
+    return guard(enter());
+}
+
+} // namespace v1
+
+using v1::epoch_domain;
+
+} // namespace lean
+
+#endif // LEAN_LIB_ATOMIC_WAIT
+#endif // LEAN_EPOCH_HPP
@@ -0,0 +1,816 @@
+#ifndef LEAN_EXPECTED_HPP
+#define LEAN_EXPECTED_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <exception>
+#include <functional> // std::reference_wrapper
+#include <new>
+#include <lean/detail/config.hpp>
+#include <lean/detail/invoke_traits.hpp>
+#include <lean/detail/special_members.hpp>
+#include <lean/memory.hpp>
+#include <lean/throw.hpp>
+#include <lean/type_traits.hpp>
+#include <lean/utility.hpp>
+
+namespace lean
+{
+namespace v1
+{
+
+template <typename T, typename E>
+class expected;
+
+//-----------------------------------------------------------------------------
+// unexpected
+
+//! @brief Wrapper for constructing expected with an error.
+
+template <typename E>
+class unexpected
+{
+    static_assert(!std::is_reference<E>::value, "E must not be a reference");
+
+public:
+    template <typename G = E,
+              typename = enable_if_t<!std::is_same<decay_t<G>, unexpected>::value &&
+                                     std::is_constructible<E, G>::value>>
+    constexpr explicit unexpected(G&& error)
+        : member(std::forward<G>(error))
+    {
+    }
+
+    LEAN_CONSTEXPR_CXX14 E& error() & noexcept { return member; }
+    constexpr const E& error() const & noexcept { return member; }
+    LEAN_CONSTEXPR_CXX14 E&& error() && noexcept { return std::move(member); }
+
+    friend bool operator==(const unexpected& lhs, const unexpected& rhs)
+    {
+        return lhs.member == rhs.member;
+    }
+
+    friend bool operator!=(const unexpected& lhs, const unexpected& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    E member;
+};
+
+template <typename E>
+constexpr unexpected<decay_t<E>> make_unexpected(E&& error)
+{
+    return unexpected<decay_t<E>>(std::forward<E>(error));
+}
+
+//! @brief Tag for in-place construction of error.
+
+struct unexpect_t
+{
+    struct tag {};
+    explicit constexpr unexpect_t(tag) noexcept {}
+};
+
+constexpr unexpect_t unexpect{ unexpect_t::tag{} };
+
+//-----------------------------------------------------------------------------
+// bad_expected_access
+
+template <typename E>
+class bad_expected_access;
+
+template <>
+class bad_expected_access<void> : public std::exception
+{
+public:
+    const char *what() const noexcept override
+    {
+        return "bad expected access";
+    }
+};
+
+template <typename E>
+class bad_expected_access : public bad_expected_access<void>
+{
+public:
+    explicit bad_expected_access(E error)
+        : member(std::move(error))
+    {
+    }
+
+    E& error() & noexcept { return member; }
+    const E& error() const & noexcept { return member; }
+    E&& error() && noexcept { return std::move(member); }
+
+private:
+    E member;
+};
+
+namespace detail
+{
+
+// Stored in place of void values
+struct expected_unit
+{
+    friend constexpr bool operator==(expected_unit, expected_unit) noexcept { return true; }
+};
+
+template <typename T>
+using expected_value_t = conditional_t<std::is_void<T>::value, expected_unit, T>;
+
+//-----------------------------------------------------------------------------
+// Storage and lifetime management
+//
+// The storage has the layout of inplace_union<T, E> but is kept as raw
+// bytes, so the expected is trivially copyable when T and E are.
+//
+// Values are constructed with parentheses rather than construct_at, so
+// arguments are not captured by initializer-list constructors.
+
+template <typename T, typename E>
+struct expected_base
+{
+    using value_type = expected_value_t<T>;
+    using storage_type = inplace_union<value_type, E>;
+
+    using is_trivially_destructible = conjunction<std::is_trivially_destructible<value_type>,
+                                                  std::is_trivially_destructible<E>>;
+
+    value_type *value_pointer() noexcept
+    {
+        return reinterpret_cast<value_type *>(&storage);
+    }
+
+    const value_type *value_pointer() const noexcept
+    {
+        return reinterpret_cast<const value_type *>(&storage);
+    }
+
+    E *error_pointer() noexcept
+    {
+        return reinterpret_cast<E *>(&storage);
+    }
+
+    const E *error_pointer() const noexcept
+    {
+        return reinterpret_cast<const E *>(&storage);
+    }
+
+    template <typename... Args>
+    void construct_value(Args&&... args)
+    {
+        ::new (static_cast<void *>(&storage)) value_type(std::forward<Args>(args)...);
+        valued = true;
+    }
+
+    template <typename... Args>
+    void construct_error(Args&&... args)
+    {
+        ::new (static_cast<void *>(&storage)) E(std::forward<Args>(args)...);
+        valued = false;
+    }
+
+    void destroy() noexcept
+    {
+        destroy(is_trivially_destructible{});
+    }
+
+    void copy_construct(const expected_base& other)
+    {
+        if (other.valued)
+            construct_value(*other.value_pointer());
+        else
+            construct_error(*other.error_pointer());
+    }
+
+    void move_construct(expected_base&& other)
+    {
+        if (other.valued)
+            construct_value(std::move(*other.value_pointer()));
+        else
+            construct_error(std::move(*other.error_pointer()));
+    }
+
+    void copy_assign(const expected_base& other)
+    {
+        if (valued && other.valued)
+        {
+            *value_pointer() = *other.value_pointer();
+        }
+        else if (!valued && !other.valued)
+        {
+            *error_pointer() = *other.error_pointer();
+        }
+        else if (other.valued)
+        {
+            reinit<true>(*other.value_pointer());
+        }
+        else
+        {
+            reinit<false>(*other.error_pointer());
+        }
+    }
+
+    void move_assign(expected_base&& other)
+    {
+        if (valued && other.valued)
+        {
+            *value_pointer() = std::move(*other.value_pointer());
+        }
+        else if (!valued && !other.valued)
+        {
+            *error_pointer() = std::move(*other.error_pointer());
+        }
+        else if (other.valued)
+        {
+            reinit<true>(std::move(*other.value_pointer()));
+        }
+        else
+        {
+            reinit<false>(std::move(*other.error_pointer()));
+        }
+    }
+
+    alignas(storage_type) unsigned char storage[sizeof(storage_type)];
+    bool valued;
+
+private:
+    // Replaces the current alternative with a new alternative constructed
+    // from args, where Valued selects the new alternative.
+    //
+    // Uses the reinitialization scheme of std::expected so the object holds
+    // exactly one alternative even if construction throws: the new
+    // alternative is constructed in a temporary, or else the old alternative
+    // is moved aside and restored on failure.
+
+    template <bool Valued>
+    using reinit_new_t = conditional_t<Valued, value_type, E>;
+
+    template <bool Valued>
+    using reinit_old_t = conditional_t<Valued, E, value_type>;
+
+    template <bool Valued, typename... Args>
+    using reinit_strategy = std::integral_constant<int,
+                                                   std::is_nothrow_constructible<reinit_new_t<Valued>, Args...>::value
+                                                   ? 0
+                                                   : (std::is_nothrow_move_constructible<reinit_new_t<Valued>>::value ? 1 : 2)>;
+
+    template <bool Valued, typename... Args>
+    void reinit(Args&&... args)
+    {
+        reinit<Valued>(reinit_strategy<Valued, Args...>{}, std::forward<Args>(args)...);
+    }
+
+    // Construction cannot throw
+    template <bool Valued, typename... Args>
+    void reinit(std::integral_constant<int, 0>, Args&&... args)
+    {
+        using new_type = reinit_new_t<Valued>;
+        destroy_at(reinterpret_cast<reinit_old_t<Valued> *>(&storage));
+        ::new (static_cast<void *>(&storage)) new_type(std::forward<Args>(args)...);
+        valued = Valued;
+    }
+
+    // Construct into temporary and move without throwing
+    template <bool Valued, typename... Args>
+    void reinit(std::integral_constant<int, 1>, Args&&... args)
+    {
+        using new_type = reinit_new_t<Valued>;
+        new_type temporary(std::forward<Args>(args)...);
+        destroy_at(reinterpret_cast<reinit_old_t<Valued> *>(&storage));
+        ::new (static_cast<void *>(&storage)) new_type(std::move(temporary));
+        valued = Valued;
+    }
+
+    // Move old alternative aside and restore it if construction throws
+    template <bool Valued, typename... Args>
+    void reinit(std::integral_constant<int, 2>, Args&&... args)
+    {
+        using new_type = reinit_new_t<Valued>;
+        using old_type = reinit_old_t<Valued>;
+        static_assert(std::is_nothrow_move_constructible<old_type>::value,
+                      "T or E must be nothrow move constructible to assign between value and error");
+        old_type backup(std::move(*reinterpret_cast<old_type *>(&storage)));
+        destroy_at(reinterpret_cast<old_type *>(&storage));
+        LEAN_TRY
+        {
+            ::new (static_cast<void *>(&storage)) new_type(std::forward<Args>(args)...);
+        }
+        LEAN_CATCH_ALL
+        {
+            ::new (static_cast<void *>(&storage)) old_type(std::move(backup));
+            LEAN_RETHROW;
+        }
+        valued = Valued;
+    }
+
+    void destroy(std::true_type) noexcept
+    {
+    }
+
+    void destroy(std::false_type) noexcept
+    {
+        if (valued)
+            destroy_at(value_pointer());
+        else
+            destroy_at(error_pointer());
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Destructor is trivial if value and error are trivially destructible.
+
+template <bool, typename T, typename E>
+struct expected_destructor
+    : expected_base<T, E>
+{
+};
+
+template <typename T, typename E>
+struct expected_destructor<false, T, E>
+    : expected_base<T, E>
+{
+    expected_destructor() = default;
+    expected_destructor(const expected_destructor&) = default;
+    expected_destructor(expected_destructor&&) = default;
+    expected_destructor& operator=(const expected_destructor&) = default;
+    expected_destructor& operator=(expected_destructor&&) = default;
+
+    ~expected_destructor()
+    {
+        this->destroy();
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Copy and move are trivial if value and error are trivially copyable.
+
+template <typename T, typename E>
+using expected_destructor_base = expected_destructor<expected_base<T, E>::is_trivially_destructible::value,
+                                                     T,
+                                                     E>;
+
+template <bool, typename T, typename E>
+struct expected_copy
+    : expected_destructor_base<T, E>
+{
+};
+
+template <typename T, typename E>
+struct expected_copy<false, T, E>
+    : expected_destructor_base<T, E>
+{
+    using value_type = expected_value_t<T>;
+
+    expected_copy() = default;
+
+    expected_copy(const expected_copy& other)
+        noexcept(conjunction<std::is_nothrow_copy_constructible<value_type>,
+                             std::is_nothrow_copy_constructible<E>>::value)
+        : expected_destructor_base<T, E>()
+    {
+        this->copy_construct(other);
+    }
+
+    expected_copy(expected_copy&& other)
+        noexcept(conjunction<std::is_nothrow_move_constructible<value_type>,
+                             std::is_nothrow_move_constructible<E>>::value)
+        : expected_destructor_base<T, E>()
+    {
+        this->move_construct(std::move(other));
+    }
+
+    expected_copy& operator=(const expected_copy& other)
+    {
+        this->copy_assign(other);
+        return *this;
+    }
+
+    expected_copy& operator=(expected_copy&& other)
+        noexcept(conjunction<std::is_nothrow_move_constructible<value_type>,
+                             std::is_nothrow_move_assignable<value_type>,
+                             std::is_nothrow_move_constructible<E>,
+                             std::is_nothrow_move_assignable<E>>::value)
+    {
+        this->move_assign(std::move(other));
+        return *this;
+    }
+};
+
+template <typename T, typename E>
+using expected_copy_base = expected_copy<conjunction<std::is_trivially_copyable<expected_value_t<T>>,
+                                                     std::is_trivially_copyable<E>>::value,
+                                         T,
+                                         E>;
+
+template <typename T>
+struct is_expected : std::false_type {};
+
+template <typename T, typename E>
+struct is_expected<expected<T, E>> : std::true_type {};
+
+template <typename T>
+struct is_unexpected : std::false_type {};
+
+template <typename E>
+struct is_unexpected<unexpected<E>> : std::true_type {};
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+// expected
+//
+//! @brief Object that contains either a value or an error.
+//!
+//! Errors are returned rather than thrown, so failures on hot paths do not
+//! pay for stack unwinding.
+//!
+//! The expected is trivially destructible and trivially copyable if T and E
+//! are. T can be void.
+//!
+//! Example:
+//!
+//!   lean::expected<int, std::errc> parse(const char *);
+//!
+//!   auto result = parse(input);
+//!   if (!result)
+//!     return lean::make_unexpected(result.error());
+
+template <typename T, typename E>
+class expected
+    : private detail::expected_copy_base<T, E>
+    , private detail::enable_copy<conjunction<std::is_copy_constructible<detail::expected_value_t<T>>,
+                                              std::is_copy_assignable<detail::expected_value_t<T>>,
+                                              std::is_copy_constructible<E>,
+                                              std::is_copy_assignable<E>>::value>
+    , private detail::enable_move<conjunction<std::is_move_constructible<detail::expected_value_t<T>>,
+                                              std::is_move_assignable<detail::expected_value_t<T>>,
+                                              std::is_move_constructible<E>,
+                                              std::is_move_assignable<E>>::value>
+{
+    static_assert(!std::is_reference<T>::value, "T must not be a reference");
+    static_assert(!std::is_reference<E>::value, "E must not be a reference");
+    static_assert(!std::is_void<E>::value, "E must not be void");
+
+    using storage_value_type = detail::expected_value_t<T>;
+
+    template <typename U>
+    using enable_value = enable_if_t<!std::is_void<T>::value &&
+                                     !detail::is_expected<decay_t<U>>::value &&
+                                     !detail::is_unexpected<decay_t<U>>::value &&
+                                     !std::is_same<decay_t<U>, in_place_t>::value &&
+                                     !std::is_same<decay_t<U>, unexpect_t>::value &&
+                                     std::is_constructible<storage_value_type, U>::value, int>;
+
+    template <typename U>
+    using reference_t = add_lvalue_reference_t<conditional_t<std::is_void<T>::value, void, U>>;
+
+    template <typename U>
+    using rvalue_reference_t = add_rvalue_reference_t<conditional_t<std::is_void<T>::value, void, U>>;
+
+public:
+    using value_type = T;
+    using error_type = E;
+    using unexpected_type = unexpected<E>;
+
+    //! @brief Creates object with value-initialized value.
+
+    template <typename U = storage_value_type,
+              typename = enable_if_t<std::is_default_constructible<U>::value>>
+    expected() noexcept(std::is_nothrow_default_constructible<U>::value)
+    {
+        this->construct_value();
+    }
+
+    //! @brief Creates object with given value.
+
+    template <typename U = storage_value_type, enable_value<U> = 0>
+    expected(U&& value) noexcept(std::is_nothrow_constructible<storage_value_type, U>::value)
+    {
+        this->construct_value(std::forward<U>(value));
+    }
+
+    //! @brief Creates object with given error.
+
+    template <typename G,
+              typename = enable_if_t<std::is_constructible<E, const G&>::value>>
+    expected(const unexpected<G>& error)
+    {
+        this->construct_error(error.error());
+    }
+
+    template <typename G,
+              typename = enable_if_t<std::is_constructible<E, G&&>::value>>
+    expected(unexpected<G>&& error) noexcept(std::is_nothrow_constructible<E, G&&>::value)
+    {
+        this->construct_error(std::move(error).error());
+    }
+
+    //! @brief Creates object with in-place construction of value.
+
+    template <typename... Args,
+              typename = enable_if_t<std::is_constructible<storage_value_type, Args...>::value>>
+    explicit expected(in_place_t, Args&&... args)
+    {
+        this->construct_value(std::forward<Args>(args)...);
+    }
+
+    //! @brief Creates object with in-place construction of error.
+
+    template <typename... Args,
+              typename = enable_if_t<std::is_constructible<E, Args...>::value>>
+    explicit expected(unexpect_t, Args&&... args)
+    {
+        this->construct_error(std::forward<Args>(args)...);
+    }
+
+    //! @brief Assigns given value.
+
+    template <typename U = storage_value_type, enable_value<U> = 0>
+    expected& operator=(U&& value)
+    {
+        if (has_value())
+        {
+            *this->value_pointer() = std::forward<U>(value);
+        }
+        else
+        {
+            *this = expected(std::forward<U>(value));
+        }
+        return *this;
+    }
+
+    //! @brief Assigns given error.
+
+    template <typename G>
+    expected& operator=(const unexpected<G>& error)
+    {
+        if (has_value())
+        {
+            *this = expected(error);
+        }
+        else
+        {
+            *this->error_pointer() = error.error();
+        }
+        return *this;
+    }
+
+    template <typename G>
+    expected& operator=(unexpected<G>&& error)
+    {
+        if (has_value())
+        {
+            *this = expected(std::move(error));
+        }
+        else
+        {
+            *this->error_pointer() = std::move(error).error();
+        }
+        return *this;
+    }
+
+    //! @brief Checks if object contains a value.
+
+    constexpr bool has_value() const noexcept
+    {
+        return this->valued;
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    //! @brief Returns value.
+    //!
+    //! @throws bad_expected_access<E> with a copy of the error if object
+    //!         contains an error.
+
+    template <typename U = T>
+    reference_t<U> value() &
+    {
+        if (LEAN_UNLIKELY(!has_value()))
+            throw_exception<bad_expected_access<E>>(error());
+        return static_cast<reference_t<U>>(*this->value_pointer());
+    }
+
+    template <typename U = T>
+    reference_t<const U> value() const &
+    {
+        if (LEAN_UNLIKELY(!has_value()))
+            throw_exception<bad_expected_access<E>>(error());
+        return static_cast<reference_t<const U>>(*this->value_pointer());
+    }
+
+    template <typename U = T>
+    rvalue_reference_t<U> value() &&
+    {
+        return static_cast<rvalue_reference_t<U>>(value<U>());
+    }
+
+    //! @brief Returns value or given default value if object contains an
+    //! error.
+
+    template <typename U>
+    T value_or(U&& other) const &
+    {
+        return has_value() ? **this : static_cast<T>(std::forward<U>(other));
+    }
+
+    template <typename U>
+    T value_or(U&& other) &&
+    {
+        return has_value() ? std::move(**this) : static_cast<T>(std::forward<U>(other));
+    }
+
+    //! @brief Returns error.
+    //!
+    //! @pre Object contains an error.
+
+    E& error() & noexcept
+    {
+        return *this->error_pointer();
+    }
+
+    const E& error() const & noexcept
+    {
+        return *this->error_pointer();
+    }
+
+    E&& error() && noexcept
+    {
+        return std::move(*this->error_pointer());
+    }
+
+    //! @brief Returns value.
+    //!
+    //! @pre Object contains a value.
+
+    template <typename U = T>
+    reference_t<U> operator*() noexcept
+    {
+        return static_cast<reference_t<U>>(*this->value_pointer());
+    }
+
+    template <typename U = T>
+    reference_t<const U> operator*() const noexcept
+    {
+        return static_cast<reference_t<const U>>(*this->value_pointer());
+    }
+
+    template <typename U = T>
+    add_pointer_t<U> operator->() noexcept
+    {
+        return this->value_pointer();
+    }
+
+    template <typename U = T>
+    add_pointer_t<const U> operator->() const noexcept
+    {
+        return this->value_pointer();
+    }
+
+    //! @brief Exchanges content.
+
+    void swap(expected& other)
+    {
+        expected temporary(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temporary);
+    }
+
+    friend bool operator==(const expected& lhs, const expected& rhs)
+    {
+        if (lhs.has_value() != rhs.has_value())
+            return false;
+        return lhs.has_value()
+            ? (*lhs.value_pointer() == *rhs.value_pointer())
+            : (lhs.error() == rhs.error());
+    }
+
+    friend bool operator!=(const expected& lhs, const expected& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <typename G>
+    friend bool operator==(const expected& lhs, const unexpected<G>& rhs)
+    {
+        return !lhs.has_value() && (lhs.error() == rhs.error());
+    }
+
+    template <typename G>
+    friend bool operator!=(const expected& lhs, const unexpected<G>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+};
+
+template <typename T, typename E>
+void swap(expected<T, E>& lhs, expected<T, E>& rhs)
+{
+    lhs.swap(rhs);
+}
+
+//-----------------------------------------------------------------------------
+// try_invoke
+
+namespace detail
+{
+
+// Lvalue references are returned as std::reference_wrapper, because expected
+// cannot hold references. Rvalue references are moved into the result.
+
+template <typename R>
+struct try_invoke_value
+{
+    using type = remove_reference_t<R>;
+};
+
+template <typename R>
+struct try_invoke_value<R&>
+{
+    using type = std::reference_wrapper<R>;
+};
+
+template <typename R>
+using try_invoke_value_t = typename try_invoke_value<R>::type;
+
+template <typename R>
+struct try_invoke_helper
+{
+    template <typename F, typename... Args>
+    static expected<try_invoke_value_t<R>, std::exception_ptr> call(F&& fn, Args&&... args)
+    {
+        return expected<try_invoke_value_t<R>, std::exception_ptr>(
+            v1::invoke(std::forward<F>(fn), std::forward<Args>(args)...));
+    }
+};
+
+template <>
+struct try_invoke_helper<void>
+{
+    template <typename F, typename... Args>
+    static expected<void, std::exception_ptr> call(F&& fn, Args&&... args)
+    {
+        v1::invoke(std::forward<F>(fn), std::forward<Args>(args)...);
+        return {};
+    }
+};
+
+} // namespace detail
+
+//! @brief Invokes callable and returns result or caught exception.
+//!
+//! Converts an exception-throwing interface into an error channel at the
+//! boundary of code that should not unwind.
+//!
+//! A callable returning T& yields expected<std::reference_wrapper<T>, ...>,
+//! and one returning T&& yields expected<T, ...>.
+
+template <typename F, typename... Args>
+auto try_invoke(F&& fn, Args&&... args) noexcept
+    -> expected<detail::try_invoke_value_t<invoke_result_t<F, Args...>>, std::exception_ptr>
+{
+    using result_type = invoke_result_t<F, Args...>;
+    LEAN_TRY
+    {
+        return detail::try_invoke_helper<result_type>::call(std::forward<F>(fn), std::forward<Args>(args)...);
+    }
+    LEAN_CATCH_ALL
+    {
+        return make_unexpected(std::current_exception());
+    }
+}
+
+} // namespace v1
+
+template <typename T, typename E>
+struct is_trivially_relocatable<v1::expected<T, E>>
+    : conjunction<is_trivially_relocatable<v1::detail::expected_value_t<T>>,
+                  is_trivially_relocatable<E>>
+{
+};
+
+using v1::unexpected;
+using v1::make_unexpected;
+using v1::unexpect_t;
+using v1::unexpect;
+using v1::bad_expected_access;
+using v1::expected;
+using v1::try_invoke;
+
+} // namespace lean
+
+#endif // LEAN_EXPECTED_HPP
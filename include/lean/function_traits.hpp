@@ -89,7 +89,7 @@ struct is_function_const
 
 template <typename T>
 struct is_function_const<T, enable_if_t<is_function<T>::value>>
-    : v1::detail::function_traits<T>::is_const
+    : v1::detail::function_has_flags<T, v1::detail::function_const>
 {
 };
 
@@ -107,7 +107,7 @@ struct is_function_volatile
 
 template <typename T>
 struct is_function_volatile<T, enable_if_t<is_function<T>::value>>
-    : v1::detail::function_traits<T>::is_volatile
+    : v1::detail::function_has_flags<T, v1::detail::function_volatile>
 {
 };
 
@@ -125,7 +125,7 @@ struct is_function_lvalue_reference
 
 template <typename T>
 struct is_function_lvalue_reference<T, enable_if_t<is_function<T>::value>>
-    : v1::detail::function_traits<T>::is_lvalue_reference
+    : v1::detail::function_has_flags<T, v1::detail::function_lvalue_reference>
 {
 };
 
@@ -143,7 +143,7 @@ struct is_function_rvalue_reference
 
 template <typename T>
 struct is_function_rvalue_reference<T, enable_if_t<is_function<T>::value>>
-    : v1::detail::function_traits<T>::is_rvalue_reference
+    : v1::detail::function_has_flags<T, v1::detail::function_rvalue_reference>
 {
 };
 
@@ -174,7 +174,7 @@ struct is_function_ellipsis
 
 template <typename T>
 struct is_function_ellipsis<T, enable_if_t<is_function<T>::value>>
-    : v1::detail::function_traits<T>::is_ellipsis
+    : v1::detail::function_has_flags<T, v1::detail::function_ellipsis>
 {
 };
 
@@ -203,7 +203,7 @@ struct add_function_const
 template <typename T>
 struct add_function_const<T, enable_if_t<is_function<T>::value>>
 {
-    using type = typename v1::detail::function_traits<T>::add_const;
+    using type = v1::detail::function_requalify_t<T, v1::detail::function_const>;
 };
 
 template <typename T>
@@ -221,7 +221,7 @@ struct add_function_volatile
 template <typename T>
 struct add_function_volatile<T, enable_if_t<is_function<T>::value>>
 {
-    using type = typename v1::detail::function_traits<T>::add_volatile;
+    using type = v1::detail::function_requalify_t<T, v1::detail::function_volatile>;
 };
 
 template <typename T>
@@ -257,7 +257,7 @@ struct add_function_lvalue_reference
 template <typename T>
 struct add_function_lvalue_reference<T, enable_if_t<is_function<T>::value>>
 {
-    using type = typename v1::detail::function_traits<T>::add_lvalue_reference;
+    using type = v1::detail::function_requalify_t<T, v1::detail::function_lvalue_reference, v1::detail::function_rvalue_reference>;
 };
 
 template <typename T>
@@ -275,7 +275,7 @@ struct add_function_rvalue_reference
 template <typename T>
 struct add_function_rvalue_reference<T, enable_if_t<is_function<T>::value>>
 {
-    using type = typename v1::detail::function_traits<T>::add_rvalue_reference;
+    using type = v1::detail::function_requalify_t<T, v1::detail::function_rvalue_reference, v1::detail::function_lvalue_reference>;
 };
 
 template <typename T>
@@ -293,7 +293,7 @@ struct add_function_ellipsis
 template <typename T>
 struct add_function_ellipsis<T, enable_if_t<is_function<T>::value>>
 {
-    using type = typename v1::detail::function_traits<T>::add_ellipsis;
+    using type = v1::detail::function_requalify_t<T, v1::detail::function_ellipsis>;
 };
 
 template <typename T>
@@ -321,7 +321,7 @@ struct remove_function_const
 template <typename T>
 struct remove_function_const<T, enable_if_t<is_function<T>::value>>
 {
-    using type = typename v1::detail::function_traits<T>::remove_const;
+    using type = v1::detail::function_requalify_t<T, 0, v1::detail::function_const>;
 };
 
 template <typename T>
@@ -340,7 +340,7 @@ struct remove_function_volatile
 template <typename T>
 struct remove_function_volatile<T, enable_if_t<is_function<T>::value>>
 {
-    using type = typename v1::detail::function_traits<T>::remove_volatile;
+    using type = v1::detail::function_requalify_t<T, 0, v1::detail::function_volatile>;
 };
 
 template <typename T>
@@ -370,7 +370,7 @@ struct remove_function_reference
 template <typename T>
 struct remove_function_reference<T, enable_if_t<is_function<T>::value>>
 {
-    using type = typename v1::detail::function_traits<T>::remove_reference;
+    using type = v1::detail::function_requalify_t<T, 0, v1::detail::function_lvalue_reference | v1::detail::function_rvalue_reference>;
 };
 
 template <typename T>
@@ -400,7 +400,7 @@ struct remove_function_ellipsis
 template <typename T>
 struct remove_function_ellipsis<T, enable_if_t<is_function<T>::value>>
 {
-    using type = typename v1::detail::function_traits<T>::remove_ellipsis;
+    using type = v1::detail::function_requalify_t<T, 0, v1::detail::function_ellipsis>;
 };
 
 template <typename T>
@@ -21,11 +21,19 @@ namespace lean
 #if __cpp_lib_constexpr_functional >= 201907L
 
 using std::invoke;
-using std::invoke_r;
 
 #else
 
 using v1::invoke;
+
+#endif
+
+#if __cpp_lib_invoke_r >= 202106L
+
+using std::invoke_r;
+
+#else
+
 using v1::invoke_r;
 
 #endif
@@ -0,0 +1,368 @@
+#ifndef LEAN_HAZARD_POINTER_HPP
+#define LEAN_HAZARD_POINTER_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef> // std::size_t
+#include <stdexcept>
+#include <vector>
+#include <lean/new.hpp>
+#include <lean/throw.hpp>
+#include <lean/utility.hpp>
+#include <lean/detail/thread_record_registry.hpp>
+
+// Maximum number of hazard pointers owned by a thread at the same time in
+// each domain.
+
+#if !defined(LEAN_HAZARD_POINTER_SLOTS)
+# define LEAN_HAZARD_POINTER_SLOTS 4
+#endif
+
+namespace lean
+{
+namespace v1
+{
+
+//! @brief Hazard pointer reclamation.
+//!
+//! Objects removed from a lock-free data structure are retired rather than
+//! deleted. A retired object is deleted once no hazard pointer protects it.
+//!
+//! Unlike epoch_domain, a stalled reader only prevents the deletion of the
+//! objects it protects, so the number of unreclaimed objects is bounded by
+//! the batch size and the number of hazard pointers.
+//!
+//! Protecting a pointer costs a store and a fence per load, which is more
+//! expensive than pinning an epoch once per critical section.
+//!
+//! Retired objects are collected in per-thread lists. When a list reaches
+//! the batch size plus the number of hazard pointer slots of all threads,
+//! all hazard pointers are gathered and sorted, so scanning the retired list
+//! costs a binary search per object. At most the slots can be protected, so
+//! each scan deletes at least the batch size of objects, and the cost of a
+//! scan is amortized over the retired objects.
+//!
+//! Threads that have used the domain may outlive it, but must not use it
+//! during or after its destruction.
+//!
+//! Example:
+//!
+//!   hazard_pointer_domain domain;
+//!
+//!   // Reader
+//!   auto hazard = domain.make_hazard_pointer();
+//!   auto node = hazard.protect(head);
+//!   ...
+//!   hazard.reset_protection();
+//!
+//!   // Writer
+//!   auto node = head.exchange(replacement);
+//!   domain.retire(node);
+
+class hazard_pointer_domain
+{
+    struct record;
+
+public:
+    class hazard_pointer;
+
+    static constexpr std::size_t slot_count = LEAN_HAZARD_POINTER_SLOTS;
+
+    //! @brief Creates domain.
+    //!
+    //! @param batch_size Number of retired objects per thread, in addition to
+    //!                   the number of hazard pointer slots, before
+    //!                   reclamation is attempted.
+
+    explicit hazard_pointer_domain(std::size_t batch_size = 64) noexcept
+        : batch_size(batch_size)
+    {
+    }
+
+    hazard_pointer_domain(const hazard_pointer_domain&) = delete;
+    hazard_pointer_domain& operator=(const hazard_pointer_domain&) = delete;
+
+    //! @brief Destroys domain and deletes all retired objects.
+    //!
+    //! @pre No hazard pointers exist.
+
+    ~hazard_pointer_domain()
+    {
+        for (record *current = records.front(); current; current = current->next)
+        {
+            for (auto& item : current->retired)
+                item.deleter(item.pointer);
+        }
+    }
+
+    //! @brief Creates hazard pointer owned by the calling thread.
+    //!
+    //! @throws std::length_error if the calling thread already owns
+    //!         slot_count hazard pointers in this domain.
+
+    hazard_pointer make_hazard_pointer();
+
+    //! @brief Retires object for deferred deletion.
+    //!
+    //! @pre Object is no longer reachable by new readers.
+
+    template <typename T>
+    void retire(T *pointer)
+    {
+        retire(static_cast<void *>(pointer),
+               [] (void *self) { delete static_cast<T *>(self); });
+    }
+
+    //! @brief Retires object for deferred deletion with custom deleter.
+
+    void retire(void *pointer, void (*deleter)(void *))
+    {
+        record& self = local_record();
+        self.retired.push_back({ pointer, deleter });
+        // Threshold grows with the number of hazards to keep scans amortized
+        if (self.retired.size() >= batch_size + records.size() * slot_count)
+        {
+            collect(self);
+        }
+    }
+
+    //! @brief Deletes unprotected objects retired by the calling thread.
+    //!
+    //! Returns the number of deleted objects.
+
+    std::size_t reclaim()
+    {
+        return collect(local_record());
+    }
+
+private:
+    struct retired_type
+    {
+        void *pointer;
+        void (*deleter)(void *);
+    };
+
+    struct alignas(hardware_destructive_interference_size) record
+    {
+        record() noexcept
+        {
+            for (auto& slot : slots)
+                slot.store(nullptr, std::memory_order_relaxed);
+        }
+
+        std::atomic<void *> slots[slot_count];
+        std::atomic<bool> in_use{ true };
+        record *next = nullptr;
+        // Owned by thread
+        unsigned int used = 0;
+        std::vector<retired_type> retired;
+        std::vector<void *> protected_pointers;
+    };
+
+    static_assert(slot_count <= 8 * sizeof(unsigned int), "Too many hazard pointer slots");
+
+    record& local_record()
+    {
+        return records.local();
+    }
+
+    std::size_t collect(record& self)
+    {
+        // Retired objects must be unlinked before hazard pointers are read
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto& hazards = self.protected_pointers;
+        hazards.clear();
+        for (record *data = records.front();
+             data;
+             data = data->next)
+        {
+            for (auto& slot : data->slots)
+            {
+                if (auto pointer = slot.load(std::memory_order_acquire))
+                    hazards.push_back(pointer);
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        std::size_t count = 0;
+        auto last = self.retired.begin();
+        for (auto& item : self.retired)
+        {
+            if (std::binary_search(hazards.begin(), hazards.end(), item.pointer))
+            {
+                *last++ = item;
+            }
+            else
+            {
+                item.deleter(item.pointer);
+                ++count;
+            }
+        }
+        self.retired.erase(last, self.retired.end());
+        return count;
+    }
+
+private:
+    detail::thread_record_registry<hazard_pointer_domain, record> records;
+    const std::size_t batch_size;
+};
+
+//! @brief Single-writer pointer that protects an object from reclamation.
+//!
+//! A hazard pointer is owned by the thread that created it.
+
+class hazard_pointer_domain::hazard_pointer
+{
+public:
+    //! @brief Creates empty hazard pointer.
+
+    hazard_pointer() noexcept = default;
+
+    hazard_pointer(hazard_pointer&& other) noexcept
+        : data(lean::exchange(other.data, nullptr)),
+          slot(other.slot)
+    {
+    }
+
+    hazard_pointer& operator=(hazard_pointer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            data = lean::exchange(other.data, nullptr);
+            slot = other.slot;
+        }
+        return *this;
+    }
+
+    hazard_pointer(const hazard_pointer&) = delete;
+    hazard_pointer& operator=(const hazard_pointer&) = delete;
+
+    ~hazard_pointer()
+    {
+        reset();
+    }
+
+    //! @brief Checks if hazard pointer has no slot.
+
+    bool empty() const noexcept
+    {
+        return data == nullptr;
+    }
+
+    //! @brief Loads and protects pointer from source.
+    //!
+    //! The returned pointer is safe to dereference until protection is
+    //! reset or another pointer is protected.
+    //!
+    //! @pre Hazard pointer is not empty.
+
+    template <typename T>
+    T *protect(const std::atomic<T *>& source) noexcept
+    {
+        T *pointer = source.load(std::memory_order_relaxed);
+        while (!try_protect(pointer, source))
+        {
+        }
+        return pointer;
+    }
+
+    //! @brief Attempts to protect pointer.
+    //!
+    //! Returns true if source still contains pointer after protection was
+    //! announced. Otherwise pointer is updated with the content of source.
+    //!
+    //! @pre Hazard pointer is not empty.
+
+    template <typename T>
+    bool try_protect(T *& pointer, const std::atomic<T *>& source) noexcept
+    {
+        T *expected = pointer;
+        reset_protection(expected);
+        // Announcement must be visible before source is validated
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        pointer = source.load(std::memory_order_acquire);
+        if (pointer == expected)
+            return true;
+        reset_protection();
+        return false;
+    }
+
+    //! @brief Protects pointer without validation.
+    //!
+    //! The caller must ensure that pointer was not retired before the
+    //! protection became visible.
+
+    template <typename T>
+    void reset_protection(const T *pointer) noexcept
+    {
+        data->slots[slot].store(const_cast<void *>(static_cast<const void *>(pointer)),
+                                std::memory_order_relaxed);
+    }
+
+    //! @brief Clears protection.
+
+    void reset_protection(std::nullptr_t = nullptr) noexcept
+    {
+        data->slots[slot].store(nullptr, std::memory_order_release);
+    }
+
+    void swap(hazard_pointer& other) noexcept
+    {
+        std::swap(data, other.data);
+        std::swap(slot, other.slot);
+    }
+
+private:
+    friend class hazard_pointer_domain;
+
+    hazard_pointer(record *data, unsigned int slot) noexcept
+        : data(data),
+          slot(slot)
+    {
+    }
+
+    void reset() noexcept
+    {
+        if (data)
+        {
+            reset_protection();
+            data->used &= ~(1U << slot);
+            data = nullptr;
+        }
+    }
+
+    record *data = nullptr;
+    unsigned int slot = 0;
+};
+
+inline auto hazard_pointer_domain::make_hazard_pointer() -> hazard_pointer
+{
+    record& self = local_record();
+    unsigned int slot = 0;
+    while ((slot < slot_count) && (self.used & (1U << slot)))
+        ++slot;
+    if (LEAN_UNLIKELY(slot == slot_count))
+        throw_exception<std::length_error>("hazard pointer slots exhausted");
+    self.used |= 1U << slot;
+    return hazard_pointer(&self, slot);
+}
+
+} // namespace v1
+
+using v1::hazard_pointer_domain;
+
+} // namespace lean
+
+#endif // LEAN_HAZARD_POINTER_HPP
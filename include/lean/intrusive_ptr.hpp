@@ -0,0 +1,332 @@
+#ifndef LEAN_INTRUSIVE_PTR_HPP
+#define LEAN_INTRUSIVE_PTR_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef> // std::size_t, std::nullptr_t
+#include <type_traits>
+#include <utility>
+#include <lean/atomic.hpp>
+#include <lean/type_traits.hpp>
+#include <lean/utility.hpp>
+
+// Reference counting policy
+
+namespace lean
+{
+namespace v1
+{
+
+//! @brief Reference count can be updated from multiple threads.
+
+struct thread_safe {};
+
+//! @brief Reference count is only updated from a single thread.
+
+struct thread_unsafe {};
+
+namespace detail
+{
+
+template <typename T>
+struct plain_counter
+{
+    static_assert(std::is_integral<T>::value, "T must be integral");
+
+    void increment() noexcept {
+        ++value;
+    }
+
+    bool decrement() noexcept {
+        return --value == 0;
+    }
+
+    T load() const noexcept {
+        return value;
+    }
+
+private:
+    T value = 0;
+};
+
+template <typename Policy>
+struct ref_counter;
+
+template <>
+struct ref_counter<thread_safe>
+{
+    using type = atomic_counter<std::size_t>;
+};
+
+template <>
+struct ref_counter<thread_unsafe>
+{
+    using type = plain_counter<std::size_t>;
+};
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+// ref_counted
+
+//! @brief Base class with embedded reference count.
+//!
+//! The object is deleted when the last intrusive_ptr to it is destroyed.
+//!
+//! Example:
+//!
+//!   struct node : lean::ref_counted<node>
+//!   {
+//!     int value;
+//!   };
+//!
+//!   auto ptr = lean::make_intrusive<node>();
+
+template <typename T, typename Policy = thread_safe>
+class ref_counted
+{
+public:
+    //! @brief Returns number of intrusive_ptr referencing the object.
+
+    std::size_t use_count() const noexcept
+    {
+        return count.load();
+    }
+
+protected:
+    constexpr ref_counted() noexcept = default;
+
+    // The reference count belongs to the object, not its value
+    ref_counted(const ref_counted&) noexcept {}
+    ref_counted& operator=(const ref_counted&) noexcept { return *this; }
+
+    ~ref_counted() = default;
+
+private:
+    friend void intrusive_ptr_add_ref(const ref_counted *self) noexcept
+    {
+        self->count.increment();
+    }
+
+    friend void intrusive_ptr_release(const ref_counted *self) noexcept
+    {
+        if (self->count.decrement())
+        {
+            delete static_cast<const T *>(self);
+        }
+    }
+
+    mutable typename detail::ref_counter<Policy>::type count;
+};
+
+//-----------------------------------------------------------------------------
+// intrusive_ptr
+
+//! @brief Smart pointer to object with embedded reference count.
+//!
+//! Occupies a single pointer. The reference count is updated through the
+//! unqualified functions
+//!
+//!   void intrusive_ptr_add_ref(T *);
+//!   void intrusive_ptr_release(T *);
+//!
+//! which are found by argument-dependent lookup. ref_counted provides both.
+
+template <typename T>
+class intrusive_ptr
+{
+    template <typename U>
+    using enable_convertible = enable_if_t<std::is_convertible<U *, T *>::value, int>;
+
+public:
+    using element_type = T;
+
+    constexpr intrusive_ptr() noexcept = default;
+
+    constexpr intrusive_ptr(std::nullptr_t) noexcept
+    {
+    }
+
+    //! @brief Takes ownership of object.
+    //!
+    //! Increments the reference count unless add_ref is false.
+
+    intrusive_ptr(T *pointer, bool add_ref = true) noexcept
+        : pointer(pointer)
+    {
+        if (pointer && add_ref)
+            intrusive_ptr_add_ref(pointer);
+    }
+
+    intrusive_ptr(const intrusive_ptr& other) noexcept
+        : intrusive_ptr(other.pointer)
+    {
+    }
+
+    intrusive_ptr(intrusive_ptr&& other) noexcept
+        : pointer(lean::exchange(other.pointer, nullptr))
+    {
+    }
+
+    template <typename U, enable_convertible<U> = 0>
+    intrusive_ptr(const intrusive_ptr<U>& other) noexcept
+        : intrusive_ptr(other.get())
+    {
+    }
+
+    template <typename U, enable_convertible<U> = 0>
+    intrusive_ptr(intrusive_ptr<U>&& other) noexcept
+        : pointer(other.detach())
+    {
+    }
+
+    ~intrusive_ptr()
+    {
+        if (pointer)
+            intrusive_ptr_release(pointer);
+    }
+
+    intrusive_ptr& operator=(const intrusive_ptr& other) noexcept
+    {
+        intrusive_ptr(other).swap(*this);
+        return *this;
+    }
+
+    intrusive_ptr& operator=(intrusive_ptr&& other) noexcept
+    {
+        intrusive_ptr(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    template <typename U, enable_convertible<U> = 0>
+    intrusive_ptr& operator=(const intrusive_ptr<U>& other) noexcept
+    {
+        intrusive_ptr(other).swap(*this);
+        return *this;
+    }
+
+    template <typename U, enable_convertible<U> = 0>
+    intrusive_ptr& operator=(intrusive_ptr<U>&& other) noexcept
+    {
+        intrusive_ptr(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    void reset() noexcept
+    {
+        intrusive_ptr().swap(*this);
+    }
+
+    void reset(T *other, bool add_ref = true) noexcept
+    {
+        intrusive_ptr(other, add_ref).swap(*this);
+    }
+
+    //! @brief Releases ownership without decrementing the reference count.
+
+    T *detach() noexcept
+    {
+        return lean::exchange(pointer, nullptr);
+    }
+
+    T *get() const noexcept
+    {
+        return pointer;
+    }
+
+    T& operator*() const noexcept
+    {
+        return *pointer;
+    }
+
+    T *operator->() const noexcept
+    {
+        return pointer;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return pointer != nullptr;
+    }
+
+    void swap(intrusive_ptr& other) noexcept
+    {
+        std::swap(pointer, other.pointer);
+    }
+
+private:
+    T *pointer = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) noexcept
+{
+    return lhs.get() == rhs.get();
+}
+
+template <typename T, typename U>
+bool operator!=(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) noexcept
+{
+    return lhs.get() != rhs.get();
+}
+
+template <typename T>
+bool operator==(const intrusive_ptr<T>& lhs, std::nullptr_t) noexcept
+{
+    return !lhs;
+}
+
+template <typename T>
+bool operator==(std::nullptr_t, const intrusive_ptr<T>& rhs) noexcept
+{
+    return !rhs;
+}
+
+template <typename T>
+bool operator!=(const intrusive_ptr<T>& lhs, std::nullptr_t) noexcept
+{
+    return bool(lhs);
+}
+
+template <typename T>
+bool operator!=(std::nullptr_t, const intrusive_ptr<T>& rhs) noexcept
+{
+    return bool(rhs);
+}
+
+template <typename T>
+void swap(intrusive_ptr<T>& lhs, intrusive_ptr<T>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+//! @brief Creates object and returns intrusive_ptr to it.
+
+template <typename T, typename... Args>
+intrusive_ptr<T> make_intrusive(Args&&... args)
+{
+    return intrusive_ptr<T>(new T(std::forward<Args>(args)...));
+}
+
+} // namespace v1
+
+template <typename T>
+struct is_trivially_relocatable<v1::intrusive_ptr<T>> : std::true_type {};
+
+using v1::thread_safe;
+using v1::thread_unsafe;
+using v1::ref_counted;
+using v1::intrusive_ptr;
+using v1::make_intrusive;
+
+} // namespace lean
+
+#endif // LEAN_INTRUSIVE_PTR_HPP
@@ -0,0 +1,327 @@
+#ifndef LEAN_LATENCY_HISTOGRAM_HPP
+#define LEAN_LATENCY_HISTOGRAM_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <vector>
+#include <lean/detail/config.hpp>
+#include <lean/new.hpp>
+
+namespace lean
+{
+namespace v1
+{
+namespace detail
+{
+
+// Position of the highest set bit
+inline unsigned int log2_floor(std::uint64_t value) noexcept
+{
+#if defined(__GNUC__)
+    return 63U - static_cast<unsigned int>(__builtin_clzll(value));
+#else
+    unsigned int result = 0;
+    while (value >>= 1)
+        ++result;
+    return result;
+#endif
+}
+
+} // namespace detail
+
+//! @brief Histogram of 64-bit values with logarithmic buckets.
+//!
+//! Values below 2^(precision_bits + 1) have their own bucket. Larger values
+//! share buckets whose width is 1/2^precision_bits of their power of two, so
+//! the relative error of reported values is below 1/2^precision_bits.
+//!
+//! Recording is a relaxed atomic increment, so multiple threads can record
+//! without locks. Threads recording at high rates should use their own
+//! histograms and merge them to avoid contention on the bucket cache lines.
+//!
+//! Reading functions are not atomic with respect to concurrent recording,
+//! but every recorded value is eventually counted.
+//!
+//! Example:
+//!
+//!   lean::latency_histogram histogram;
+//!   histogram.record(std::chrono::steady_clock::now() - start);
+//!   auto p99 = histogram.percentile(99.0);
+
+class alignas(hardware_destructive_interference_size) latency_histogram
+{
+public:
+    static constexpr unsigned int precision_bits = 4;
+    static constexpr std::size_t sub_bucket_count = std::size_t(1) << precision_bits;
+    static constexpr std::size_t bucket_count = (65 - precision_bits) * sub_bucket_count;
+
+    //! @brief Creates empty histogram.
+
+    latency_histogram() noexcept
+    {
+        reset();
+    }
+
+    //! @brief Creates copy of the current bucket counts.
+
+    latency_histogram(const latency_histogram& other) noexcept
+    {
+        for (std::size_t index = 0; index < bucket_count; ++index)
+            buckets[index].store(other.buckets[index].load(std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+    }
+
+    latency_histogram& operator=(const latency_histogram& other) noexcept
+    {
+        for (std::size_t index = 0; index < bucket_count; ++index)
+            buckets[index].store(other.buckets[index].load(std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+        return *this;
+    }
+
+    //! @brief Records value count times.
+
+    void record(std::uint64_t value, std::uint64_t count = 1) noexcept
+    {
+        buckets[bucket_index(value)].fetch_add(count, std::memory_order_relaxed);
+    }
+
+    //! @brief Records duration in nanoseconds.
+    //!
+    //! Negative durations are recorded as zero.
+
+    template <typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> duration) noexcept
+    {
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        record(nanoseconds > 0 ? static_cast<std::uint64_t>(nanoseconds) : 0);
+    }
+
+    //! @brief Adds the bucket counts of other histogram.
+
+    void merge(const latency_histogram& other) noexcept
+    {
+        for (std::size_t index = 0; index < bucket_count; ++index)
+        {
+            auto count = other.buckets[index].load(std::memory_order_relaxed);
+            if (count != 0)
+                buckets[index].fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    //! @brief Removes all recorded values.
+
+    void reset() noexcept
+    {
+        for (auto& bucket : buckets)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+
+    //! @brief Returns the number of recorded values.
+
+    std::uint64_t count() const noexcept
+    {
+        std::uint64_t result = 0;
+        for (const auto& bucket : buckets)
+            result += bucket.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    //! @brief Returns the lowest value equivalent to the smallest recorded value.
+    //!
+    //! Returns zero if the histogram is empty.
+
+    std::uint64_t min() const noexcept
+    {
+        for (std::size_t index = 0; index < bucket_count; ++index)
+        {
+            if (buckets[index].load(std::memory_order_relaxed) != 0)
+                return bucket_lower(index);
+        }
+        return 0;
+    }
+
+    //! @brief Returns the highest value equivalent to the largest recorded value.
+    //!
+    //! Returns zero if the histogram is empty.
+
+    std::uint64_t max() const noexcept
+    {
+        for (std::size_t index = bucket_count; index > 0; --index)
+        {
+            if (buckets[index - 1].load(std::memory_order_relaxed) != 0)
+                return bucket_upper(index - 1);
+        }
+        return 0;
+    }
+
+    //! @brief Returns the value below or at which the percentage of values falls.
+    //!
+    //! The highest value equivalent to the bucket is returned, so the result
+    //! is never below the exact percentile. Returns zero if the histogram is
+    //! empty.
+    //!
+    //! @param percentage Percentage between 0 and 100.
+
+    std::uint64_t percentile(double percentage) const noexcept
+    {
+        const std::uint64_t total = count();
+        if (total == 0)
+            return 0;
+        if (percentage >= 100.0)
+            return max();
+        // Rank of the value in sorted order, starting from one
+        std::uint64_t rank = 1;
+        if (percentage > 0.0)
+            rank = static_cast<std::uint64_t>(std::ceil(percentage / 100.0 * double(total)));
+        if (rank == 0)
+            rank = 1;
+        std::uint64_t cumulative = 0;
+        for (std::size_t index = 0; index < bucket_count; ++index)
+        {
+            cumulative += buckets[index].load(std::memory_order_relaxed);
+            if (cumulative >= rank)
+                return bucket_upper(index);
+        }
+        return max();
+    }
+
+    //! @brief Returns compact binary encoding of the bucket counts.
+    //!
+    //! The encoding is two bytes with the format version and precision_bits,
+    //! followed by the index gap and the count of each non-empty bucket as
+    //! LEB128 variable-length integers.
+
+    std::vector<std::uint8_t> serialize() const
+    {
+        std::vector<std::uint8_t> result;
+        result.push_back(static_cast<std::uint8_t>(format_version));
+        result.push_back(static_cast<std::uint8_t>(precision_bits));
+        std::size_t next = 0;
+        for (std::size_t index = 0; index < bucket_count; ++index)
+        {
+            auto count = buckets[index].load(std::memory_order_relaxed);
+            if (count == 0)
+                continue;
+            write_varint(result, index - next);
+            write_varint(result, count);
+            next = index + 1;
+        }
+        return result;
+    }
+
+    //! @brief Replaces the bucket counts with serialized bucket counts.
+    //!
+    //! Returns false, and leaves the histogram empty, if the input is not a
+    //! serialized histogram with the same precision.
+
+    bool deserialize(const std::uint8_t *data, std::size_t size) noexcept
+    {
+        reset();
+        const std::uint8_t *last = data + size;
+        if ((size < 2) || (data[0] != format_version) || (data[1] != precision_bits))
+            return false;
+        data += 2;
+        std::uint64_t next = 0;
+        while (data != last)
+        {
+            std::uint64_t gap;
+            std::uint64_t count;
+            if (!read_varint(data, last, gap) ||
+                !read_varint(data, last, count) ||
+                (gap >= bucket_count - next) ||
+                (count == 0))
+            {
+                reset();
+                return false;
+            }
+            next += gap;
+            buckets[next].store(count, std::memory_order_relaxed);
+            ++next;
+        }
+        return true;
+    }
+
+    //! @brief Returns the bucket of value.
+
+    static std::size_t bucket_index(std::uint64_t value) noexcept
+    {
+        if (value < 2 * sub_bucket_count)
+            return static_cast<std::size_t>(value);
+        const unsigned int shift = detail::log2_floor(value) - precision_bits;
+        return (std::size_t(shift + 1) << precision_bits) +
+            static_cast<std::size_t>((value >> shift) & (sub_bucket_count - 1));
+    }
+
+    //! @brief Returns the lowest value in bucket.
+
+    static std::uint64_t bucket_lower(std::size_t index) noexcept
+    {
+        const std::size_t group = index >> precision_bits;
+        if (group == 0)
+            return index;
+        return std::uint64_t(sub_bucket_count + (index & (sub_bucket_count - 1))) << (group - 1);
+    }
+
+    //! @brief Returns the highest value in bucket.
+
+    static std::uint64_t bucket_upper(std::size_t index) noexcept
+    {
+        const std::size_t group = index >> precision_bits;
+        if (group == 0)
+            return index;
+        return bucket_lower(index) + ((std::uint64_t(1) << (group - 1)) - 1);
+    }
+
+private:
+    static constexpr std::uint8_t format_version = 1;
+
+    static void write_varint(std::vector<std::uint8_t>& output, std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            output.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        output.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    static bool read_varint(const std::uint8_t *& data,
+                            const std::uint8_t *last,
+                            std::uint64_t& value) noexcept
+    {
+        value = 0;
+        for (unsigned int shift = 0; (data != last) && (shift < 64); shift += 7)
+        {
+            const std::uint8_t byte = *data++;
+            value |= std::uint64_t(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+
+private:
+    std::atomic<std::uint64_t> buckets[bucket_count];
+};
+
+} // namespace v1
+
+using v1::latency_histogram;
+
+} // namespace lean
+
+#endif // LEAN_LATENCY_HISTOGRAM_HPP
@@ -12,10 +12,17 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <cstddef> // std::max_align_t
+#include <cstdlib> // std::abort
+#include <cstring> // std::memcpy, std::memset
 #include <new>
 #include <memory>
+#include <stdexcept>
+#include <lean/detail/checked_policy.hpp>
 #include <lean/detail/config.hpp>
 #include <lean/detail/type_traits.hpp>
+#include <lean/new.hpp>
+#include <lean/throw.hpp>
+#include <lean/type_traits.hpp>
 
 namespace lean
 {
@@ -96,6 +103,232 @@ void destroy_at(T* ptr)
 
 #endif
 
+//-----------------------------------------------------------------------------
+// destroy_n
+//
+// Destroys count objects starting at first.
+//
+// Returns the end of the range.
+//
+// No-op for trivially destructible types.
+
+template <typename T,
+          enable_if_t<std::is_trivially_destructible<T>::value, int> = 0>
+T* destroy_n(T* first, std::size_t count) noexcept
+{
+    return first + count;
+}
+
+template <typename T,
+          enable_if_t<!std::is_trivially_destructible<T>::value, int> = 0>
+T* destroy_n(T* first, std::size_t count) noexcept
+{
+    for (; count > 0; --count, ++first)
+        destroy_at(first);
+    return first;
+}
+
+namespace detail
+{
+
+// Destroys the range unless it has been emptied before the guard goes out of
+// scope.
+
+template <typename T>
+struct destroy_guard
+{
+    ~destroy_guard()
+    {
+        v1::destroy_n(first, std::size_t(last - first));
+    }
+
+    T* first;
+    T* last;
+};
+
+// Value-initialization of these types yields all-zero bytes.
+//
+// Class types are excluded because pointers to data members are not
+// zero-initialized to all-zero bytes in the Itanium ABI.
+
+template <typename T>
+struct is_zero_initializable
+    : public bool_constant<std::is_arithmetic<T>::value ||
+                           std::is_enum<T>::value ||
+                           std::is_pointer<T>::value>
+{
+};
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+// uninitialized_copy_n
+//
+// Copy-constructs count objects from first into uninitialized target.
+//
+// Returns the end of the target range.
+//
+// Trivially copyable types are copied with a single memcpy. The ranges must
+// not overlap.
+//
+// If a constructor throws, then the already constructed target objects are
+// destroyed before the exception is propagated.
+
+template <typename T,
+          enable_if_t<std::is_trivially_copyable<T>::value, int> = 0>
+T* uninitialized_copy_n(const T* first, std::size_t count, T* target) noexcept
+{
+    if (count > 0)
+    {
+        std::memcpy(static_cast<void*>(target), static_cast<const void*>(first), count * sizeof(T));
+    }
+    return target + count;
+}
+
+template <typename T,
+          enable_if_t<!std::is_trivially_copyable<T>::value, int> = 0>
+T* uninitialized_copy_n(const T* first, std::size_t count, T* target) noexcept(std::is_nothrow_copy_constructible<T>::value)
+{
+    detail::destroy_guard<T> guard{ target, target };
+    for (; count > 0; --count, ++first, ++guard.last)
+        construct_at(guard.last, *first);
+    guard.first = guard.last;
+    return guard.last;
+}
+
+//-----------------------------------------------------------------------------
+// uninitialized_move_n
+//
+// Move-constructs count objects from first into uninitialized target.
+//
+// Returns the end of the target range.
+//
+// Trivially move constructible types are copied with a single memcpy. The
+// ranges must not overlap.
+//
+// If a constructor throws, then the already constructed target objects are
+// destroyed before the exception is propagated.
+
+template <typename T,
+          enable_if_t<is_trivially_move_constructible<T>::value, int> = 0>
+T* uninitialized_move_n(T* first, std::size_t count, T* target) noexcept
+{
+    if (count > 0)
+    {
+        std::memcpy(static_cast<void*>(target), static_cast<const void*>(first), count * sizeof(T));
+    }
+    return target + count;
+}
+
+template <typename T,
+          enable_if_t<!is_trivially_move_constructible<T>::value, int> = 0>
+T* uninitialized_move_n(T* first, std::size_t count, T* target) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+    detail::destroy_guard<T> guard{ target, target };
+    for (; count > 0; --count, ++first, ++guard.last)
+        construct_at(guard.last, std::move(*first));
+    guard.first = guard.last;
+    return guard.last;
+}
+
+//-----------------------------------------------------------------------------
+// uninitialized_value_construct_n
+//
+// Value-initializes count objects in uninitialized first.
+//
+// Returns the end of the range.
+//
+// Arithmetic, enumeration, and pointer types are zeroed with a single memset.
+//
+// If a constructor throws, then the already constructed objects are destroyed
+// before the exception is propagated.
+
+template <typename T,
+          enable_if_t<detail::is_zero_initializable<T>::value, int> = 0>
+T* uninitialized_value_construct_n(T* first, std::size_t count) noexcept
+{
+    if (count > 0)
+    {
+        std::memset(static_cast<void*>(first), 0, count * sizeof(T));
+    }
+    return first + count;
+}
+
+template <typename T,
+          enable_if_t<!detail::is_zero_initializable<T>::value, int> = 0>
+T* uninitialized_value_construct_n(T* first, std::size_t count) noexcept(std::is_nothrow_default_constructible<T>::value)
+{
+    detail::destroy_guard<T> guard{ first, first };
+    for (; count > 0; --count, ++guard.last)
+        construct_at(guard.last);
+    guard.first = guard.last;
+    return guard.last;
+}
+
+//-----------------------------------------------------------------------------
+// relocate_at [P1144]
+//
+// Moves object from source to uninitialized target and destroys source.
+//
+// Trivially relocatable types are copied with memcpy.
+
+template <typename T,
+          enable_if_t<is_trivially_relocatable<T>::value, int> = 0>
+T* relocate_at(T* source, T* target) noexcept
+{
+    std::memcpy(static_cast<void*>(target), static_cast<const void*>(source), sizeof(T));
+    return target;
+}
+
+template <typename T,
+          enable_if_t<!is_trivially_relocatable<T>::value, int> = 0>
+T* relocate_at(T* source, T* target) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+    T* result = construct_at(target, std::move(*source));
+    destroy_at(source);
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+// uninitialized_relocate_n [P1144]
+//
+// Relocates count objects from first to uninitialized target.
+//
+// Returns the end of the target range.
+//
+// Trivially relocatable types are moved with a single memmove. The ranges
+// may overlap if target precedes first.
+//
+// If a move constructor throws, then all objects in both ranges are
+// destroyed before the exception is propagated.
+
+template <typename T,
+          enable_if_t<is_trivially_relocatable<T>::value, int> = 0>
+T* uninitialized_relocate_n(T* first, std::size_t count, T* target) noexcept
+{
+    if (count > 0)
+    {
+        std::memmove(static_cast<void*>(target), static_cast<const void*>(first), count * sizeof(T));
+    }
+    return target + count;
+}
+
+template <typename T,
+          enable_if_t<!is_trivially_relocatable<T>::value, int> = 0>
+T* uninitialized_relocate_n(T* first, std::size_t count, T* target) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+    // Both guards are only non-empty if relocation was interrupted
+    detail::destroy_guard<T> source{ first, first + count };
+    detail::destroy_guard<T> guard{ target, target };
+    for (; source.first != source.last; ++source.first, ++guard.last)
+    {
+        construct_at(guard.last, std::move(*source.first));
+        destroy_at(source.first);
+    }
+    guard.first = guard.last;
+    return guard.last;
+}
+
 //-----------------------------------------------------------------------------
 // inplace_storage
 
@@ -115,6 +348,75 @@ struct is_inplace_value_compatible
 {
 };
 
+// Range checks for policy-selected accessors
+//
+// Failures are thrown out of line so the checks stay small when inlined.
+// Customized throw_traits must not return from these failures.
+
+[[noreturn]] LEAN_ATTRIBUTE_NOINLINE LEAN_ATTRIBUTE_COLD
+inline void throw_inplace_offset_out_of_range()
+{
+    throw_exception<std::out_of_range>("offset out of range");
+    std::abort();
+}
+
+[[noreturn]] LEAN_ATTRIBUTE_NOINLINE LEAN_ATTRIBUTE_COLD
+inline void throw_inplace_offset_misaligned()
+{
+    throw_exception<std::invalid_argument>("offset misaligned");
+    std::abort();
+}
+
+[[noreturn]] LEAN_ATTRIBUTE_NOINLINE LEAN_ATTRIBUTE_COLD
+inline void throw_inplace_index_out_of_range()
+{
+    throw_exception<std::out_of_range>("index out of range");
+    std::abort();
+}
+
+template <typename Policy>
+struct is_throwing_policy
+    : std::integral_constant<bool,
+                             is_checked_policy<Policy>::value && !std::is_same<Policy, checked_expected>::value>
+{
+};
+
+template <std::size_t Len, typename R, typename Policy>
+LEAN_ATTRIBUTE_ALWAYS_INLINE inline
+auto inplace_check_offset(std::size_t) noexcept
+    -> enable_if_t<!is_checked_policy<Policy>::value>
+{
+}
+
+template <std::size_t Len, typename R, typename Policy>
+auto inplace_check_offset(std::size_t offset)
+    -> enable_if_t<is_checked_policy<Policy>::value>
+{
+    static_assert(is_throwing_policy<Policy>::value, "Accessors cannot return expected");
+
+    if (LEAN_UNLIKELY(offset > Len - sizeof(R)))
+        throw_inplace_offset_out_of_range();
+    if (LEAN_UNLIKELY(offset % alignof(R) != 0))
+        throw_inplace_offset_misaligned();
+}
+
+template <std::size_t Len, typename R, typename Policy>
+LEAN_ATTRIBUTE_ALWAYS_INLINE inline
+auto inplace_check_index(std::size_t) noexcept
+    -> enable_if_t<!is_checked_policy<Policy>::value>
+{
+}
+
+template <std::size_t Len, typename R, typename Policy>
+auto inplace_check_index(std::size_t index)
+    -> enable_if_t<is_checked_policy<Policy>::value>
+{
+    static_assert(is_throwing_policy<Policy>::value, "Accessors cannot return expected");
+
+    if (LEAN_UNLIKELY(index >= Len / sizeof(R)))
+        throw_inplace_index_out_of_range();
+}
+
 } // namespace detail
 
 template <std::size_t Len, std::size_t Align = alignof(std::max_align_t)>
@@ -143,6 +445,67 @@ struct inplace_storage {
         return reinterpret_cast<add_pointer_t<add_const_t<R>>>(&member.value);
     }
 
+    //! @brief Returns pointer to R at byte offset.
+    //!
+    //! Checked policies throw std::out_of_range if R does not fit at offset,
+    //! and std::invalid_argument if offset is misaligned for R.
+    //!
+    //! The unchecked policy compiles to a pointer offset.
+    //!
+    //! The exceptions are thrown by lean-core unless LEAN_HEADER_ONLY is
+    //! defined, so LEAN_NO_EXCEPTIONS must match lean-core.
+    //!
+    //! Example:
+    //!
+    //!   auto header = storage.data<std::uint32_t, lean::unchecked>(4);
+
+    template <typename R,
+              typename Policy = default_policy,
+              enable_if_t<detail::is_inplace_storage_compatible<Len, Align, R>::value, int> = 0>
+    auto data(std::size_t offset) noexcept(!is_checked_policy<Policy>::value)
+        -> add_pointer_t<R>
+    {
+        detail::inplace_check_offset<Len, R, Policy>(offset);
+        return reinterpret_cast<add_pointer_t<R>>(member.value + offset);
+    }
+
+    template <typename R,
+              typename Policy = default_policy,
+              enable_if_t<detail::is_inplace_storage_compatible<Len, Align, R>::value, int> = 0>
+    auto data(std::size_t offset) const noexcept(!is_checked_policy<Policy>::value)
+        -> add_pointer_t<add_const_t<R>>
+    {
+        detail::inplace_check_offset<Len, R, Policy>(offset);
+        return reinterpret_cast<add_pointer_t<add_const_t<R>>>(member.value + offset);
+    }
+
+    //! @brief Returns element at index when storage is viewed as an array of R.
+    //!
+    //! Checked policies throw std::out_of_range if index is beyond the last
+    //! whole R in the storage.
+    //!
+    //! The unchecked policy compiles to a pointer offset.
+
+    template <typename R,
+              typename Policy = default_policy,
+              enable_if_t<detail::is_inplace_storage_compatible<Len, Align, R>::value, int> = 0>
+    auto at(std::size_t index) noexcept(!is_checked_policy<Policy>::value)
+        -> add_lvalue_reference_t<R>
+    {
+        detail::inplace_check_index<Len, R, Policy>(index);
+        return reinterpret_cast<add_pointer_t<R>>(member.value)[index];
+    }
+
+    template <typename R,
+              typename Policy = default_policy,
+              enable_if_t<detail::is_inplace_storage_compatible<Len, Align, R>::value, int> = 0>
+    auto at(std::size_t index) const noexcept(!is_checked_policy<Policy>::value)
+        -> add_lvalue_reference_t<add_const_t<R>>
+    {
+        detail::inplace_check_index<Len, R, Policy>(index);
+        return reinterpret_cast<add_pointer_t<add_const_t<R>>>(member.value)[index];
+    }
+
 private:
     alignas (Align) struct member
     {
@@ -164,6 +527,54 @@ private:
 //-----------------------------------------------------------------------------
 // inplace_value
 
+namespace detail
+{
+
+// The lifetime of the value is managed by the owner, so the union destructor
+// must not be deleted when the value is not trivially destructible.
+
+template <typename T, bool = std::is_trivially_destructible<T>::value>
+union inplace_value_member
+{
+    constexpr inplace_value_member() noexcept : dummy{} {}
+    constexpr inplace_value_member(const inplace_value_member&) noexcept = delete;
+    constexpr inplace_value_member(inplace_value_member&&) noexcept = delete;
+
+    template <typename... Args,
+              typename = enable_if_t<!std::is_same<inplace_value_member, remove_cvref_t<type_front_t<Args...>>>::value>>
+    explicit constexpr inplace_value_member(Args&&... args)
+        : value(std::forward<Args>(args)...)
+    {
+    }
+
+    // Dummy to prevent value from being default-initialized
+    unsigned char dummy;
+    T value;
+};
+
+template <typename T>
+union inplace_value_member<T, false>
+{
+    constexpr inplace_value_member() noexcept : dummy{} {}
+    constexpr inplace_value_member(const inplace_value_member&) noexcept = delete;
+    constexpr inplace_value_member(inplace_value_member&&) noexcept = delete;
+
+    template <typename... Args,
+              typename = enable_if_t<!std::is_same<inplace_value_member, remove_cvref_t<type_front_t<Args...>>>::value>>
+    explicit constexpr inplace_value_member(Args&&... args)
+        : value(std::forward<Args>(args)...)
+    {
+    }
+
+    ~inplace_value_member() {}
+
+    // Dummy to prevent value from being default-initialized
+    unsigned char dummy;
+    T value;
+};
+
+} // namespace detail
+
 template <typename T>
 struct inplace_value {
     using value_type = remove_const_t<T>;
@@ -197,23 +608,7 @@ struct inplace_value {
     }
 
 private:
-    union member
-    {
-        constexpr member() noexcept = default;
-        constexpr member(const member&) noexcept = delete;
-        constexpr member(member&&) noexcept = delete;
-
-        template <typename... Args,
-                  typename = enable_if_t<!std::is_same<member, remove_cvref_t<type_front_t<Args...>>>::value>>
-        explicit constexpr member(Args&&... args)
-            : value(std::forward<Args>(args)...)
-        {
-        }
-
-        // Dummy to prevent value from being default-initialized
-        unsigned char dummy {};
-        value_type value;
-    } member;
+    detail::inplace_value_member<value_type> member;
 };
 
 //-----------------------------------------------------------------------------
@@ -223,6 +618,9 @@ template <typename... Types>
 struct inplace_union {
     using value_type = type_max_with_t<type_sizeof, Types...>;
 
+    // The largest type may not have the strictest alignment
+    static constexpr std::size_t alignment = alignof(type_max_with_t<type_alignof, Types...>);
+
     constexpr inplace_union() noexcept = default;
 
     template <typename... Args,
@@ -237,35 +635,107 @@ struct inplace_union {
     template <typename R>
     LEAN_CONSTEXPR_CXX14
     auto data() noexcept
-        -> enable_if_t<detail::is_inplace_value_compatible<value_type, R>::value &&
+        -> enable_if_t<detail::is_inplace_storage_compatible<sizeof(value_type), alignment, R>::value &&
                        type_contains<R, Types...>::value,
                        add_pointer_t<R>>
     {
-        return member.template data<R>();
+        return reinterpret_cast<add_pointer_t<R>>(member.data());
     }
 
     template <typename R>
     constexpr auto data() const noexcept
-        -> enable_if_t<detail::is_inplace_value_compatible<value_type, R>::value &&
+        -> enable_if_t<detail::is_inplace_storage_compatible<sizeof(value_type), alignment, R>::value &&
                        type_contains<R, Types...>::value,
                        add_pointer_t<add_const_t<R>>>
     {
-        return member.template data<R>();
+        return reinterpret_cast<add_pointer_t<add_const_t<R>>>(member.data());
     }
 
 private:
-    inplace_value<value_type> member;
+    alignas(alignment) inplace_value<value_type> member;
+};
+
+//-----------------------------------------------------------------------------
+// cache_padded
+//
+//! @brief Value that does not share cache lines with other objects.
+//!
+//! The value is aligned to, and padded up to a multiple of, the destructive
+//! interference size to prevent false sharing between adjacent objects, for
+//! instance between elements of an array of flags written by different
+//! threads.
+//!
+//! Dynamic allocation only respects the alignment from C++17.
+
+template <typename T>
+struct alignas(hardware_destructive_interference_size) cache_padded
+{
+    using value_type = T;
+
+    //! @brief Creates value-initialized value.
+
+    cache_padded() noexcept(std::is_nothrow_default_constructible<T>::value)
+    {
+        construct_at(member.data());
+    }
+
+    //! @brief Creates value from arguments.
+
+    template <typename... Args,
+              typename = enable_if_t<!std::is_same<cache_padded, remove_cvref_t<type_front_t<Args...>>>::value>>
+    explicit cache_padded(Args&&... args) noexcept(std::is_nothrow_constructible<T, Args...>::value)
+    {
+        construct_at(member.data(), std::forward<Args>(args)...);
+    }
+
+    cache_padded(const cache_padded&) = delete;
+    cache_padded(cache_padded&&) = delete;
+    cache_padded& operator=(const cache_padded&) = delete;
+    cache_padded& operator=(cache_padded&&) = delete;
+
+    ~cache_padded()
+    {
+        destroy_at(member.data());
+    }
+
+    // Accessors
+
+    T& get() noexcept { return *member.data(); }
+    const T& get() const noexcept { return *member.data(); }
+
+    T& operator*() noexcept { return get(); }
+    const T& operator*() const noexcept { return get(); }
+
+    T* operator->() noexcept { return member.data(); }
+    const T* operator->() const noexcept { return member.data(); }
+
+private:
+    inplace_value<T> member;
 };
 
 } // namespace v1
 
+//-----------------------------------------------------------------------------
+// std::unique_ptr with the default deleter only holds a pointer
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T, std::default_delete<T>>>
+    : public std::true_type {};
+
 //-----------------------------------------------------------------------------
 
 using v1::construct_at;
 using v1::destroy_at;
+using v1::destroy_n;
+using v1::uninitialized_copy_n;
+using v1::uninitialized_move_n;
+using v1::uninitialized_value_construct_n;
+using v1::relocate_at;
+using v1::uninitialized_relocate_n;
 using v1::inplace_storage;
 using v1::inplace_value;
 using v1::inplace_union;
+using v1::cache_padded;
 
 } // namespace lean
 
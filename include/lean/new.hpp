@@ -0,0 +1,126 @@
+#ifndef LEAN_NEW_HPP
+#define LEAN_NEW_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uintptr_t
+#include <new>
+#include <utility>
+#include <lean/detail/config.hpp>
+
+//-----------------------------------------------------------------------------
+// Hardware interference size [P0154]
+//
+// std::hardware_destructive_interference_size is not used even if available
+// because its value depends on compiler flags, which makes it unsuitable for
+// the layout of types shared between translation units.
+//
+// The values can be changed by defining the macros before inclusion.
+//
+// Some processors prefetch cache lines in pairs, so the destructive size is
+// twice the cache line size on those.
+
+#if !defined(LEAN_HARDWARE_DESTRUCTIVE_INTERFERENCE_SIZE)
+# if defined(__x86_64__) || defined(_M_X64) || defined(__powerpc64__)
+#  define LEAN_HARDWARE_DESTRUCTIVE_INTERFERENCE_SIZE 128
+# elif defined(__aarch64__) && defined(__APPLE__)
+#  define LEAN_HARDWARE_DESTRUCTIVE_INTERFERENCE_SIZE 128
+# else
+#  define LEAN_HARDWARE_DESTRUCTIVE_INTERFERENCE_SIZE 64
+# endif
+#endif
+
+#if !defined(LEAN_HARDWARE_CONSTRUCTIVE_INTERFERENCE_SIZE)
+# define LEAN_HARDWARE_CONSTRUCTIVE_INTERFERENCE_SIZE 64
+#endif
+
+namespace lean
+{
+namespace v1
+{
+
+//! @brief Minimum offset between objects to avoid false sharing.
+
+constexpr std::size_t hardware_destructive_interference_size = LEAN_HARDWARE_DESTRUCTIVE_INTERFERENCE_SIZE;
+
+//! @brief Maximum size of contiguous memory to promote true sharing.
+
+constexpr std::size_t hardware_constructive_interference_size = LEAN_HARDWARE_CONSTRUCTIVE_INTERFERENCE_SIZE;
+
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// Over-aligned allocation
+//
+// New-expressions ignore extended alignment before C++17, so the object is
+// placed manually within a larger allocation. The start of the allocation is
+// stored immediately before the object.
+
+#if defined(__cpp_aligned_new)
+
+template <typename T, typename... Args>
+T *aligned_new(Args&&... args)
+{
+    return new T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void aligned_delete(T *pointer) noexcept
+{
+    delete pointer;
+}
+
+#else
+
+template <typename T, typename... Args>
+T *aligned_new(Args&&... args)
+{
+    static_assert(alignof(T) >= 2 * sizeof(void *), "T must be over-aligned");
+
+    void *allocation = ::operator new(sizeof(T) + alignof(T));
+    const auto address = reinterpret_cast<std::uintptr_t>(allocation);
+    auto storage = reinterpret_cast<void *>(address + alignof(T) - address % alignof(T));
+    static_cast<void **>(storage)[-1] = allocation;
+    LEAN_TRY
+    {
+        return ::new (storage) T(std::forward<Args>(args)...);
+    }
+    LEAN_CATCH_ALL
+    {
+        ::operator delete(allocation);
+        LEAN_RETHROW;
+    }
+}
+
+template <typename T>
+void aligned_delete(T *pointer) noexcept
+{
+    if (pointer)
+    {
+        void *allocation = reinterpret_cast<void **>(pointer)[-1];
+        pointer->~T();
+        ::operator delete(allocation);
+    }
+}
+
+#endif
+
+} // namespace detail
+} // namespace v1
+
+using v1::hardware_destructive_interference_size;
+using v1::hardware_constructive_interference_size;
+
+} // namespace lean
+
+#endif // LEAN_NEW_HPP
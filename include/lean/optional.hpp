@@ -0,0 +1,604 @@
+#ifndef LEAN_OPTIONAL_HPP
+#define LEAN_OPTIONAL_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <exception>
+#include <new>
+#include <lean/detail/config.hpp>
+#include <lean/detail/special_members.hpp>
+#include <lean/memory.hpp>
+#include <lean/throw.hpp>
+#include <lean/type_traits.hpp>
+#include <lean/utility.hpp>
+
+namespace lean
+{
+
+//-----------------------------------------------------------------------------
+// optional_traits
+//
+//! @brief Customization point for the empty state of optional<T>.
+//!
+//! By default an optional stores a flag next to the value. Traits with a
+//!
+//!   static constexpr T sentinel() noexcept;
+//!
+//! function make optional use the sentinel value as the empty state instead,
+//! so the optional has the same size as T.
+//!
+//! Specialize lean::optional_traits<T> to change the default for T, or pass
+//! traits as the second template parameter of optional.
+//!
+//! Example:
+//!
+//!   using index = lean::optional<std::int32_t, lean::optional_sentinel<std::int32_t, -1>>;
+//!   static_assert(sizeof(index) == sizeof(std::int32_t), "");
+
+template <typename T>
+struct optional_traits
+{
+};
+
+//! @brief Traits for optional with constant sentinel value.
+
+template <typename T, T Sentinel>
+struct optional_sentinel
+{
+    static constexpr T sentinel() noexcept { return Sentinel; }
+};
+
+namespace v1
+{
+
+template <typename T, typename Traits>
+class optional;
+
+//-----------------------------------------------------------------------------
+// bad_optional_access
+
+struct bad_optional_access : public std::exception
+{
+    const char *what() const noexcept override
+    {
+        return "bad optional access";
+    }
+};
+
+//-----------------------------------------------------------------------------
+// nullopt
+
+struct nullopt_t
+{
+    struct tag {};
+    explicit constexpr nullopt_t(tag) noexcept {}
+};
+
+constexpr nullopt_t nullopt{ nullopt_t::tag{} };
+
+namespace detail
+{
+
+template <typename Traits, typename = void>
+struct has_optional_sentinel : std::false_type {};
+
+template <typename Traits>
+struct has_optional_sentinel<Traits, void_t<decltype(Traits::sentinel())>> : std::true_type {};
+
+//-----------------------------------------------------------------------------
+// Storage and lifetime management
+//
+// The storage has the layout of inplace_value<T> but is kept as raw bytes,
+// so the optional is trivially copyable when T is.
+
+template <typename T, typename Traits, bool = has_optional_sentinel<Traits>::value>
+struct optional_storage
+{
+    using is_trivially_destructible = std::is_trivially_destructible<T>;
+
+    constexpr bool has_value() const noexcept
+    {
+        return engaged;
+    }
+
+    T *pointer() noexcept
+    {
+        return reinterpret_cast<T *>(&storage);
+    }
+
+    const T *pointer() const noexcept
+    {
+        return reinterpret_cast<const T *>(&storage);
+    }
+
+    // Parentheses rather than construct_at braces, so arguments are not
+    // captured by initializer-list constructors
+    template <typename... Args>
+    void construct(Args&&... args)
+    {
+        ::new (static_cast<void *>(pointer())) T(std::forward<Args>(args)...);
+        engaged = true;
+    }
+
+    void destroy() noexcept
+    {
+        if (engaged)
+        {
+            destroy(is_trivially_destructible{});
+            engaged = false;
+        }
+    }
+
+    alignas(inplace_value<T>) unsigned char storage[sizeof(inplace_value<T>)];
+    bool engaged = false;
+
+private:
+    void destroy(std::true_type) noexcept
+    {
+    }
+
+    void destroy(std::false_type) noexcept
+    {
+        destroy_at(pointer());
+    }
+};
+
+// The sentinel value represents the empty state, so the value is always
+// constructed.
+
+template <typename T, typename Traits>
+struct optional_storage<T, Traits, true>
+{
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+    static_assert(std::is_trivially_destructible<T>::value, "T must be trivially destructible");
+
+    using is_trivially_destructible = std::true_type;
+
+    constexpr bool has_value() const noexcept
+    {
+        return !(value == Traits::sentinel());
+    }
+
+    T *pointer() noexcept
+    {
+        return &value;
+    }
+
+    const T *pointer() const noexcept
+    {
+        return &value;
+    }
+
+    template <typename... Args>
+    void construct(Args&&... args)
+    {
+        ::new (static_cast<void *>(pointer())) T(std::forward<Args>(args)...);
+    }
+
+    void destroy() noexcept
+    {
+        value = Traits::sentinel();
+    }
+
+    T value = Traits::sentinel();
+};
+
+template <typename T, typename Traits>
+struct optional_base
+    : optional_storage<T, Traits>
+{
+    void copy_construct(const optional_base& other)
+    {
+        if (other.has_value())
+            this->construct(*other.pointer());
+    }
+
+    void move_construct(optional_base&& other)
+    {
+        if (other.has_value())
+            this->construct(std::move(*other.pointer()));
+    }
+
+    void copy_assign(const optional_base& other)
+    {
+        if (this->has_value() && other.has_value())
+        {
+            *this->pointer() = *other.pointer();
+        }
+        else
+        {
+            this->destroy();
+            copy_construct(other);
+        }
+    }
+
+    void move_assign(optional_base&& other)
+    {
+        if (this->has_value() && other.has_value())
+        {
+            *this->pointer() = std::move(*other.pointer());
+        }
+        else
+        {
+            this->destroy();
+            move_construct(std::move(other));
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Destructor is trivial if the value is trivially destructible.
+
+template <bool, typename T, typename Traits>
+struct optional_destructor
+    : optional_base<T, Traits>
+{
+};
+
+template <typename T, typename Traits>
+struct optional_destructor<false, T, Traits>
+    : optional_base<T, Traits>
+{
+    optional_destructor() = default;
+    optional_destructor(const optional_destructor&) = default;
+    optional_destructor(optional_destructor&&) = default;
+    optional_destructor& operator=(const optional_destructor&) = default;
+    optional_destructor& operator=(optional_destructor&&) = default;
+
+    ~optional_destructor()
+    {
+        this->destroy();
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Copy and move are trivial if the value is trivially copyable.
+
+template <typename T, typename Traits>
+using optional_destructor_base = optional_destructor<optional_storage<T, Traits>::is_trivially_destructible::value,
+                                                     T,
+                                                     Traits>;
+
+template <bool, typename T, typename Traits>
+struct optional_copy
+    : optional_destructor_base<T, Traits>
+{
+};
+
+template <typename T, typename Traits>
+struct optional_copy<false, T, Traits>
+    : optional_destructor_base<T, Traits>
+{
+    optional_copy() = default;
+
+    optional_copy(const optional_copy& other)
+        noexcept(std::is_nothrow_copy_constructible<T>::value)
+        : optional_destructor_base<T, Traits>()
+    {
+        this->copy_construct(other);
+    }
+
+    optional_copy(optional_copy&& other)
+        noexcept(std::is_nothrow_move_constructible<T>::value)
+        : optional_destructor_base<T, Traits>()
+    {
+        this->move_construct(std::move(other));
+    }
+
+    optional_copy& operator=(const optional_copy& other)
+    {
+        this->copy_assign(other);
+        return *this;
+    }
+
+    optional_copy& operator=(optional_copy&& other)
+        noexcept(conjunction<std::is_nothrow_move_constructible<T>,
+                             std::is_nothrow_move_assignable<T>>::value)
+    {
+        this->move_assign(std::move(other));
+        return *this;
+    }
+};
+
+template <typename T, typename Traits>
+using optional_copy_base = optional_copy<std::is_trivially_copyable<T>::value, T, Traits>;
+
+template <typename T>
+struct is_optional : std::false_type {};
+
+template <typename T, typename Traits>
+struct is_optional<optional<T, Traits>> : std::true_type {};
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+// optional
+//
+//! @brief Object that may contain a value.
+//!
+//! The optional is trivially destructible and trivially copyable if T is.
+//!
+//! If Traits provides a sentinel value, the sentinel represents the empty
+//! state and no flag is stored. Assigning the sentinel value makes the
+//! optional empty.
+
+template <typename T, typename Traits = optional_traits<T>>
+class optional
+    : private detail::optional_copy_base<T, Traits>
+    , private detail::enable_copy<conjunction<std::is_copy_constructible<T>,
+                                              std::is_copy_assignable<T>>::value>
+    , private detail::enable_move<conjunction<std::is_move_constructible<T>,
+                                              std::is_move_assignable<T>>::value>
+{
+    static_assert(!std::is_reference<T>::value, "T must not be a reference");
+
+    template <typename U>
+    using enable_value = enable_if_t<!detail::is_optional<decay_t<U>>::value &&
+                                     !std::is_same<decay_t<U>, nullopt_t>::value &&
+                                     !std::is_same<decay_t<U>, in_place_t>::value &&
+                                     std::is_constructible<T, U>::value, int>;
+
+public:
+    using value_type = T;
+    using traits_type = Traits;
+
+    //! @brief Creates empty object.
+
+    optional() noexcept = default;
+
+    //! @brief Creates empty object.
+
+    optional(nullopt_t) noexcept
+    {
+    }
+
+    //! @brief Creates object with given value.
+
+    template <typename U = T, enable_value<U> = 0>
+    optional(U&& value) noexcept(std::is_nothrow_constructible<T, U>::value)
+    {
+        this->construct(std::forward<U>(value));
+    }
+
+    //! @brief Creates object with in-place construction of value.
+
+    template <typename... Args,
+              typename = enable_if_t<std::is_constructible<T, Args...>::value>>
+    explicit optional(in_place_t, Args&&... args)
+    {
+        this->construct(std::forward<Args>(args)...);
+    }
+
+    //! @brief Destroys value.
+
+    optional& operator=(nullopt_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    //! @brief Assigns given value.
+
+    template <typename U = T, enable_value<U> = 0>
+    optional& operator=(U&& value)
+    {
+        if (has_value())
+        {
+            **this = std::forward<U>(value);
+        }
+        else
+        {
+            this->construct(std::forward<U>(value));
+        }
+        return *this;
+    }
+
+    //! @brief Recreates object with given value.
+
+    template <typename... Args>
+    T& emplace(Args&&... args)
+    {
+        reset();
+        this->construct(std::forward<Args>(args)...);
+        return **this;
+    }
+
+    //! @brief Destroys value.
+
+    void reset() noexcept
+    {
+        this->destroy();
+    }
+
+    //! @brief Checks if object contains a value.
+
+    constexpr bool has_value() const noexcept
+    {
+        return base_type::has_value();
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    //! @brief Returns value.
+    //!
+    //! @throws bad_optional_access if empty.
+
+    T& value() &
+    {
+        if (LEAN_UNLIKELY(!has_value()))
+            throw_exception<bad_optional_access>();
+        return **this;
+    }
+
+    const T& value() const &
+    {
+        if (LEAN_UNLIKELY(!has_value()))
+            throw_exception<bad_optional_access>();
+        return **this;
+    }
+
+    T&& value() &&
+    {
+        return std::move(value());
+    }
+
+    const T&& value() const &&
+    {
+        return std::move(value());
+    }
+
+    //! @brief Returns value or given default value if empty.
+
+    template <typename U>
+    T value_or(U&& other) const &
+    {
+        return has_value() ? **this : static_cast<T>(std::forward<U>(other));
+    }
+
+    template <typename U>
+    T value_or(U&& other) &&
+    {
+        return has_value() ? std::move(**this) : static_cast<T>(std::forward<U>(other));
+    }
+
+    //! @brief Returns value.
+    //!
+    //! @pre Object contains a value.
+
+    T& operator*() & noexcept
+    {
+        return *this->pointer();
+    }
+
+    const T& operator*() const & noexcept
+    {
+        return *this->pointer();
+    }
+
+    T&& operator*() && noexcept
+    {
+        return std::move(*this->pointer());
+    }
+
+    const T&& operator*() const && noexcept
+    {
+        return std::move(*this->pointer());
+    }
+
+    T *operator->() noexcept
+    {
+        return this->pointer();
+    }
+
+    const T *operator->() const noexcept
+    {
+        return this->pointer();
+    }
+
+    //! @brief Exchanges values.
+
+    void swap(optional& other)
+    {
+        optional temporary(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temporary);
+    }
+
+    friend bool operator==(const optional& lhs, const optional& rhs)
+    {
+        if (lhs.has_value() != rhs.has_value())
+            return false;
+        return !lhs.has_value() || (*lhs == *rhs);
+    }
+
+    friend bool operator!=(const optional& lhs, const optional& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator==(const optional& lhs, nullopt_t) noexcept
+    {
+        return !lhs.has_value();
+    }
+
+    friend bool operator==(nullopt_t, const optional& rhs) noexcept
+    {
+        return !rhs.has_value();
+    }
+
+    friend bool operator!=(const optional& lhs, nullopt_t) noexcept
+    {
+        return lhs.has_value();
+    }
+
+    friend bool operator!=(nullopt_t, const optional& rhs) noexcept
+    {
+        return rhs.has_value();
+    }
+
+    friend bool operator==(const optional& lhs, const T& rhs)
+    {
+        return lhs.has_value() && (*lhs == rhs);
+    }
+
+    friend bool operator==(const T& lhs, const optional& rhs)
+    {
+        return rhs.has_value() && (lhs == *rhs);
+    }
+
+    friend bool operator!=(const optional& lhs, const T& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator!=(const T& lhs, const optional& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    using base_type = detail::optional_copy_base<T, Traits>;
+};
+
+template <typename T, typename Traits>
+void swap(optional<T, Traits>& lhs, optional<T, Traits>& rhs)
+{
+    lhs.swap(rhs);
+}
+
+//! @brief Creates optional with given value.
+
+template <typename T>
+optional<decay_t<T>> make_optional(T&& value)
+{
+    return optional<decay_t<T>>(std::forward<T>(value));
+}
+
+} // namespace v1
+
+template <typename T, typename Traits>
+struct is_trivially_relocatable<v1::optional<T, Traits>>
+    : is_trivially_relocatable<T>
+{
+};
+
+using v1::bad_optional_access;
+using v1::nullopt_t;
+using v1::nullopt;
+using v1::optional;
+using v1::make_optional;
+
+} // namespace lean
+
+#endif // LEAN_OPTIONAL_HPP
@@ -11,6 +11,11 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
+#include <cstdlib> // std::abort
+#include <exception>
+#include <string>
+#include <tuple>
 #include <lean/detail/config.hpp>
 #include <lean/type_traits.hpp>
 #include <lean/utility.hpp>
@@ -20,6 +25,148 @@ namespace lean
 namespace v1
 {
 
+//-----------------------------------------------------------------------------
+// Throw handler
+
+//! @brief Function receiving a constructed exception.
+//!
+//! what is the message if the exception is derived from std::exception,
+//! otherwise null.
+
+using throw_visitor = void (*)(const void *exception, const char *what);
+
+//! @brief Description of exception passed to throw handler.
+//!
+//! The exception is not constructed, so throwing does not pay for its
+//! construction, such as the allocation of the message of std::runtime_error.
+//! The handler can inspect the constructor arguments with throw_arguments(),
+//! or construct the exception with throw_visit().
+//!
+//! The arguments are only valid during the handler call.
+
+struct throw_context
+{
+    //! Unique identifier of the exception type. Compare with throw_type_id<E>().
+    const void *type;
+    //! Unique identifier of the argument types. Compare with throw_arguments_id<Args...>().
+    const void *arguments_type;
+    //! Pointer to std::tuple<const Args&...> with the constructor arguments.
+    const void *arguments;
+    //! Constructs the exception and passes it to visitor. Use throw_visit().
+    void (*visit)(const throw_context&, throw_visitor);
+};
+
+//! @brief Handler invoked instead of throwing when exceptions are disabled.
+//!
+//! The handler must not return.
+
+using throw_handler = void (*)(const throw_context&);
+
+namespace detail
+{
+
+template <typename E>
+struct throw_type_tag
+{
+    static constexpr char id = 0;
+};
+
+template <typename E>
+constexpr char throw_type_tag<E>::id;
+
+[[noreturn]] inline void default_throw_handler(const throw_context&) noexcept
+{
+    std::abort();
+}
+
+inline std::atomic<throw_handler>& throw_handler_storage() noexcept
+{
+    static std::atomic<throw_handler> handler{ &default_throw_handler };
+    return handler;
+}
+
+template <typename E>
+auto throw_what(const E& exception) noexcept
+    -> enable_if_t<std::is_base_of<std::exception, E>::value, const char *>
+{
+    return exception.what();
+}
+
+template <typename E>
+auto throw_what(const E&) noexcept
+    -> enable_if_t<!std::is_base_of<std::exception, E>::value, const char *>
+{
+    return nullptr;
+}
+
+} // namespace detail
+
+//! @brief Returns unique identifier of exception type.
+
+template <typename E>
+constexpr const void *throw_type_id() noexcept
+{
+    return &detail::throw_type_tag<E>::id;
+}
+
+//! @brief Returns unique identifier of constructor argument types.
+//!
+//! Arguments are identified by their decayed types, so a string literal is
+//! passed as const char *.
+
+template <typename... Args>
+constexpr const void *throw_arguments_id() noexcept
+{
+    return throw_type_id<std::tuple<Args...>>();
+}
+
+//! @brief Returns constructor arguments passed to throw handler.
+//!
+//! Returns null if the arguments do not have the given decayed types.
+//!
+//! Example:
+//!
+//!   if (auto arguments = lean::throw_arguments<const char *>(context))
+//!     std::fputs(std::get<0>(*arguments), stderr);
+
+template <typename... Args>
+const std::tuple<const Args&...> *throw_arguments(const throw_context& context) noexcept
+{
+    return (context.arguments_type == throw_arguments_id<Args...>())
+        ? static_cast<const std::tuple<const Args&...> *>(context.arguments)
+        : nullptr;
+}
+
+//! @brief Constructs exception passed to throw handler and calls visitor.
+//!
+//! The exception is only valid during the visitor call.
+
+inline void throw_visit(const throw_context& context, throw_visitor visitor)
+{
+    context.visit(context, visitor);
+}
+
+//! @brief Installs throw handler.
+//!
+//! The default handler calls std::abort().
+//!
+//! Returns the previous handler.
+
+inline throw_handler set_throw_handler(throw_handler handler) noexcept
+{
+    return detail::throw_handler_storage().exchange(handler ? handler : &detail::default_throw_handler,
+                                                    std::memory_order_acq_rel);
+}
+
+//! @brief Returns current throw handler.
+
+inline throw_handler get_throw_handler() noexcept
+{
+    return detail::throw_handler_storage().load(std::memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+
 template <typename E>
 struct throw_abi
 {
@@ -28,13 +175,51 @@ private:
     template <typename, typename>
     friend struct throw_traits;
 
+#if defined(LEAN_NO_EXCEPTIONS)
+
+    // Passes constructor arguments to throw handler
+    template <typename... Args>
+    [[noreturn]] LEAN_ATTRIBUTE_NOINLINE LEAN_ATTRIBUTE_COLD
+    static void invoke(Args... args)
+    {
+        const std::tuple<const decay_t<Args>&...> arguments{ args... };
+        const throw_context context{ throw_type_id<E>(),
+                                     throw_arguments_id<decay_t<Args>...>(),
+                                     &arguments,
+                                     &visit<decay_t<Args>...> };
+        get_throw_handler()(context);
+        // Handler must not return
+        std::abort();
+    }
+
+    template <typename... Args>
+    static void visit(const throw_context& context, throw_visitor visitor)
+    {
+        construct(*static_cast<const std::tuple<const Args&...> *>(context.arguments),
+                  visitor,
+                  index_sequence_for<Args...>{});
+    }
+
+    template <typename... Args, std::size_t... Indices>
+    static void construct(const std::tuple<const Args&...>& arguments,
+                          throw_visitor visitor,
+                          index_sequence<Indices...>)
+    {
+        const E exception{std::get<Indices>(arguments)...};
+        visitor(&exception, detail::throw_what(exception));
+    }
+
+#else
+
     // Throws exception
     template <typename... Args>
-    [[noreturn]] LEAN_ATTRIBUTE_NOINLINE
+    [[noreturn]] LEAN_ATTRIBUTE_NOINLINE LEAN_ATTRIBUTE_COLD
     static void invoke(Args... args)
     {
         throw E{args...};
     }
+
+#endif
 };
 
 //! @brief Override throw invocation.
@@ -74,6 +259,8 @@ struct throw_traits
 //! Prevents inlining of exception construction at the call-site to reduce
 //! binary size.
 //!
+//! Invokes the throw handler instead if LEAN_NO_EXCEPTIONS is defined.
+//!
 //! Replace
 //!
 //!   throw std::runtime_error("warp core failure");
@@ -93,10 +280,106 @@ auto throw_exception(Args&&... args) -> typename throw_traits<E>::result_type
 
 LEAN_WARNING_SCOPE_END
 
+//-----------------------------------------------------------------------------
+// Lazy exception
+
+//! @brief Exception whose message is formatted on the first call to what().
+//!
+//! Stores the formatter and its arguments instead of the formatted message,
+//! so throwing only allocates the exception object. Exceptions that are
+//! caught and discarded never pay for formatting.
+//!
+//! The formatter is invoked as formatter(args...) and must return a value
+//! convertible to std::string. Arguments are stored by value, so pointer
+//! arguments such as C strings must outlive the exception.
+//!
+//! If formatting fails then what() returns the empty message of E.
+//!
+//! The first call to what() must not race with other calls to what().
+
+template <typename E, typename Formatter, typename... Args>
+class lazy_exception : public E
+{
+    static_assert(std::is_base_of<std::exception, E>::value, "E must be derived from std::exception");
+    static_assert(std::is_constructible<E, const char *>::value, "E must be constructible from message");
+
+public:
+    template <typename F, typename... Brgs>
+    explicit lazy_exception(F&& formatter, Brgs&&... args)
+        : E(""),
+          formatter(std::forward<F>(formatter)),
+          arguments(std::forward<Brgs>(args)...)
+    {
+    }
+
+    const char *what() const noexcept override
+    {
+        if (!formatted)
+        {
+            LEAN_TRY
+            {
+                message = format(index_sequence_for<Args...>{});
+                formatted = true;
+            }
+            LEAN_CATCH_ALL
+            {
+                return E::what();
+            }
+        }
+        return message.c_str();
+    }
+
+private:
+    template <std::size_t... Indices>
+    std::string format(index_sequence<Indices...>) const
+    {
+        return formatter(std::get<Indices>(arguments)...);
+    }
+
+    Formatter formatter;
+    std::tuple<Args...> arguments;
+    mutable std::string message;
+    mutable bool formatted = false;
+};
+
+//! @brief Throws exception with lazily formatted message.
+//!
+//! The exception can be caught as E. The throw goes through throw_traits of
+//! the lazy_exception type.
+//!
+//! Replace
+//!
+//!   throw std::out_of_range("index " + std::to_string(index) + " out of range");
+//!
+//! with
+//!
+//!   throw_lazy_exception<std::out_of_range>(
+//!       [] (std::size_t index) { return "index " + std::to_string(index) + " out of range"; },
+//!       index);
+
+template <typename E, typename Formatter, typename... Args>
+auto throw_lazy_exception(Formatter&& formatter, Args&&... args)
+    -> typename throw_traits<lazy_exception<E, decay_t<Formatter>, decay_t<Args>...>>::result_type
+{
+    return throw_exception<lazy_exception<E, decay_t<Formatter>, decay_t<Args>...>>(std::forward<Formatter>(formatter),
+                                                                                    std::forward<Args>(args)...);
+}
+
 } // namespace v1
 
+using v1::throw_context;
+using v1::throw_handler;
+using v1::throw_visitor;
+using v1::throw_type_id;
+using v1::throw_arguments_id;
+using v1::throw_arguments;
+using v1::throw_visit;
+using v1::set_throw_handler;
+using v1::get_throw_handler;
 using v1::throw_traits;
 using v1::throw_exception;
+using v1::lazy_exception;
+using v1::throw_lazy_exception;
 
 } // namespace lean
 
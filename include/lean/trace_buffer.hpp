@@ -0,0 +1,434 @@
+#ifndef LEAN_TRACE_BUFFER_HPP
+#define LEAN_TRACE_BUFFER_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <lean/atomic.hpp>
+#include <lean/memory.hpp>
+#include <lean/new.hpp>
+#include <lean/detail/thread_record_registry.hpp>
+
+#if LEAN_CXX >= LEAN_LIB_ATOMIC_WAIT
+
+namespace lean
+{
+namespace v1
+{
+
+//! @brief Kind of trace event.
+//!
+//! The values are the Chrome trace event phases.
+
+enum class trace_phase : std::uint8_t
+{
+    instant = 'i',
+    begin = 'B',
+    end = 'E'
+};
+
+//! @brief Fixed-size trace event.
+//!
+//! Records are written to trace files as is, so the file format uses the
+//! byte order of the producing machine.
+
+struct trace_record
+{
+    //! Nanoseconds of the steady clock.
+    std::uint64_t timestamp;
+    //! User-defined event identifier.
+    std::uint32_t event;
+    //! Sequence number of the producing thread within the trace buffer.
+    std::uint16_t thread;
+    trace_phase phase;
+    std::uint8_t reserved;
+    //! User-defined payload.
+    std::uint64_t payload[2];
+};
+
+static_assert(sizeof(trace_record) == 32, "trace_record must be 32 bytes");
+
+//! @brief Per-thread rings of trace records.
+//!
+//! Each producing thread writes to its own single-producer single-consumer
+//! ring, so recording costs a clock read and a few stores. A record is
+//! dropped when the ring of the thread is full, so producers never block.
+//!
+//! Rings are drained by one consumer at a time, usually a trace_collector.
+//!
+//! Threads that have used the buffer may outlive it, but must not use it
+//! during or after its destruction.
+//!
+//! Example:
+//!
+//!   lean::trace_buffer buffer;
+//!   lean::trace_collector collector(buffer, file, std::chrono::milliseconds(10));
+//!
+//!   // Producer
+//!   buffer.begin(parse_event);
+//!   ...
+//!   buffer.end(parse_event, bytes);
+
+class trace_buffer
+{
+    struct ring;
+
+public:
+    //! @brief Creates buffer.
+    //!
+    //! @param capacity Number of records in each per-thread ring. Rounded up
+    //!                 to a power of two.
+
+    explicit trace_buffer(std::size_t capacity = 4096)
+        : capacity(round_up(capacity))
+    {
+    }
+
+    trace_buffer(const trace_buffer&) = delete;
+    trace_buffer& operator=(const trace_buffer&) = delete;
+
+    //! @brief Records event from the calling thread.
+    //!
+    //! Returns false if the record was dropped because the ring was full.
+    //!
+    //! @throws std::bad_alloc if the ring of the calling thread cannot be
+    //!         allocated on its first record.
+
+    bool record(trace_phase phase,
+                std::uint32_t event,
+                std::uint64_t first = 0,
+                std::uint64_t second = 0)
+    {
+        ring& self = local_ring();
+        auto& producer = *self.producer;
+        const std::size_t position = producer.head.load(std::memory_order_relaxed);
+        if (LEAN_UNLIKELY(position - producer.cached_tail == capacity))
+        {
+            producer.cached_tail = self.tail->load(std::memory_order_acquire);
+            if (position - producer.cached_tail == capacity)
+            {
+                producer.dropped.store(producer.dropped.load(std::memory_order_relaxed) + 1,
+                                       std::memory_order_relaxed);
+                return false;
+            }
+        }
+        trace_record& item = self.records[position & (capacity - 1)];
+        item.timestamp = now();
+        item.event = event;
+        item.thread = self.thread;
+        item.phase = phase;
+        item.reserved = 0;
+        item.payload[0] = first;
+        item.payload[1] = second;
+        producer.head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool instant(std::uint32_t event, std::uint64_t first = 0, std::uint64_t second = 0)
+    {
+        return record(trace_phase::instant, event, first, second);
+    }
+
+    bool begin(std::uint32_t event, std::uint64_t first = 0, std::uint64_t second = 0)
+    {
+        return record(trace_phase::begin, event, first, second);
+    }
+
+    bool end(std::uint32_t event, std::uint64_t first = 0, std::uint64_t second = 0)
+    {
+        return record(trace_phase::end, event, first, second);
+    }
+
+    //! @brief Passes all pending records to function and removes them.
+    //!
+    //! Records from one thread are passed in order. Returns the number of
+    //! records.
+
+    template <typename F>
+    std::size_t drain(F&& function)
+    {
+        std::lock_guard<std::mutex> lock(consumer_mutex);
+        std::size_t count = 0;
+        for (ring *current = rings.front();
+             current;
+             current = current->next)
+        {
+            const std::size_t first = current->tail->load(std::memory_order_relaxed);
+            const std::size_t last = current->producer->head.load(std::memory_order_acquire);
+            for (std::size_t position = first; position != last; ++position)
+            {
+                function(static_cast<const trace_record&>(current->records[position & (capacity - 1)]));
+            }
+            current->tail->store(last, std::memory_order_release);
+            count += last - first;
+        }
+        return count;
+    }
+
+    //! @brief Returns the number of records dropped because of full rings.
+
+    std::uint64_t dropped() const noexcept
+    {
+        std::uint64_t result = 0;
+        for (ring *current = rings.front();
+             current;
+             current = current->next)
+        {
+            result += current->producer->dropped.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    static std::uint64_t now() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    // Written by the producer
+    struct producer_type
+    {
+        lean::atomic<std::size_t> head{ 0 };
+        // Last observed consumer position, to avoid reading the consumer
+        // cache line on every record
+        std::size_t cached_tail = 0;
+        lean::atomic<std::uint64_t> dropped{ 0 };
+    };
+
+    struct ring
+    {
+        ring(std::size_t capacity, lean::atomic<unsigned int>& threads)
+            : records(new trace_record[capacity]),
+              thread(next_thread(threads))
+        {
+        }
+
+        // The new owner is a different thread
+        void reacquire(std::size_t, lean::atomic<unsigned int>& threads) noexcept
+        {
+            thread = next_thread(threads);
+        }
+
+        static std::uint16_t next_thread(lean::atomic<unsigned int>& threads) noexcept
+        {
+            return static_cast<std::uint16_t>(threads.fetch_add(1, std::memory_order_relaxed));
+        }
+
+        cache_padded<producer_type> producer;
+        // Written by the consumer
+        cache_padded<lean::atomic<std::size_t>> tail;
+        std::unique_ptr<trace_record[]> records;
+        std::atomic<bool> in_use{ true };
+        // Only accessed by the owning thread
+        std::uint16_t thread;
+        ring *next = nullptr;
+    };
+
+    // Rings of exited threads are reused with their pending records, and
+    // the last observed consumer position is still valid. The new owner is
+    // given a new thread number.
+    ring& local_ring()
+    {
+        return rings.local(capacity, threads);
+    }
+
+    static std::size_t round_up(std::size_t value) noexcept
+    {
+        std::size_t result = 1;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+private:
+    const std::size_t capacity;
+    lean::atomic<unsigned int> threads{ 0 };
+    std::mutex consumer_mutex;
+    detail::thread_record_registry<trace_buffer, ring> rings;
+};
+
+//-----------------------------------------------------------------------------
+// Trace files
+//
+// A trace file is a 16 byte header followed by trace records. The header
+// contains the magic "LEANTRCE", the format version, and the record size as
+// 32-bit integers.
+
+namespace detail
+{
+
+constexpr char trace_magic[] = "LEANTRCE";
+constexpr std::uint32_t trace_version = 1;
+
+// Writes text as the contents of a JSON string
+inline void write_json_string(const char *text, std::FILE *output)
+{
+    for (; *text; ++text)
+    {
+        const unsigned char current = static_cast<unsigned char>(*text);
+        if ((current == '"') || (current == '\\'))
+        {
+            std::fputc('\\', output);
+            std::fputc(current, output);
+        }
+        else if (current < 0x20)
+        {
+            std::fprintf(output, "\\u%04x", static_cast<unsigned int>(current));
+        }
+        else
+        {
+            std::fputc(current, output);
+        }
+    }
+}
+
+} // namespace detail
+
+//! @brief Drains a trace buffer into a trace file from a background thread.
+//!
+//! Remaining records are written when the collector is destroyed. The file
+//! is not closed by the collector.
+
+class trace_collector
+{
+public:
+    trace_collector(trace_buffer& buffer,
+                    std::FILE *output,
+                    std::chrono::milliseconds interval)
+        : buffer(buffer),
+          output(output)
+    {
+        const std::uint32_t header[2] = { detail::trace_version, sizeof(trace_record) };
+        std::fwrite(detail::trace_magic, 1, 8, output);
+        std::fwrite(header, sizeof(header), 1, output);
+        worker = std::thread([this, interval] { run(interval); });
+    }
+
+    trace_collector(const trace_collector&) = delete;
+    trace_collector& operator=(const trace_collector&) = delete;
+
+    ~trace_collector()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        condition.notify_one();
+        worker.join();
+    }
+
+    //! @brief Returns the number of written records.
+
+    std::uint64_t size() const noexcept
+    {
+        return written.load(std::memory_order_relaxed);
+    }
+
+private:
+    void run(std::chrono::milliseconds interval)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!condition.wait_for(lock, interval, [this] { return stopped; }))
+        {
+            collect();
+        }
+        collect();
+    }
+
+    void collect()
+    {
+        auto count = buffer.drain([this] (const trace_record& item) {
+            std::fwrite(&item, sizeof(item), 1, output);
+        });
+        std::fflush(output);
+        written.fetch_add(count, std::memory_order_relaxed);
+    }
+
+private:
+    trace_buffer& buffer;
+    std::FILE *output;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopped = false;
+    std::atomic<std::uint64_t> written{ 0 };
+    std::thread worker;
+};
+
+//! @brief Converts trace file to Chrome trace JSON.
+//!
+//! Event names are obtained from name, or are the event identifiers if name
+//! is null or returns null. Names are escaped as JSON strings. The payload
+//! is written as arguments.
+//!
+//! Returns false if input is not a trace file.
+
+inline bool write_chrome_trace(std::FILE *input,
+                               std::FILE *output,
+                               const char *(*name)(std::uint32_t) = nullptr)
+{
+    char magic[8];
+    std::uint32_t header[2];
+    if ((std::fread(magic, sizeof(magic), 1, input) != 1) ||
+        (std::memcmp(magic, detail::trace_magic, sizeof(magic)) != 0) ||
+        (std::fread(header, sizeof(header), 1, input) != 1) ||
+        (header[0] != detail::trace_version) ||
+        (header[1] != sizeof(trace_record)))
+        return false;
+
+    std::fputs("{\"traceEvents\":[", output);
+    const char *separator = "\n";
+    trace_record item;
+    while (std::fread(&item, sizeof(item), 1, input) == 1)
+    {
+        std::fprintf(output, "%s{\"name\":\"", separator);
+        const char *label = name ? name(item.event) : nullptr;
+        if (label)
+            detail::write_json_string(label, output);
+        else
+            std::fprintf(output, "%lu", static_cast<unsigned long>(item.event));
+        std::fprintf(output,
+                     "\",\"ph\":\"%c\",\"ts\":%llu.%03u,\"pid\":0,\"tid\":%u%s"
+                     ",\"args\":{\"payload0\":%llu,\"payload1\":%llu}}",
+                     static_cast<char>(item.phase),
+                     static_cast<unsigned long long>(item.timestamp / 1000),
+                     static_cast<unsigned int>(item.timestamp % 1000),
+                     static_cast<unsigned int>(item.thread),
+                     (item.phase == trace_phase::instant) ? ",\"s\":\"t\"" : "",
+                     static_cast<unsigned long long>(item.payload[0]),
+                     static_cast<unsigned long long>(item.payload[1]));
+        separator = ",\n";
+    }
+    std::fputs("\n]}\n", output);
+    return true;
+}
+
+} // namespace v1
+
+using v1::trace_phase;
+using v1::trace_record;
+using v1::trace_buffer;
+using v1::trace_collector;
+using v1::write_chrome_trace;
+
+} // namespace lean
+
+#endif // LEAN_LIB_ATOMIC_WAIT
+#endif // LEAN_TRACE_BUFFER_HPP
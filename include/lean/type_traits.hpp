@@ -76,6 +76,38 @@ template <>
 struct is_trivially_move_constructible<void>
     : public std::false_type {};
 
+//-----------------------------------------------------------------------------
+// is_trivially_relocatable [P1144]
+//
+// Checks if moving an object to a new location and destroying the old one is
+// equivalent to copying its bytes.
+//
+// Trivially copyable types are trivially relocatable. Types that are not
+// trivially copyable, but are relocatable by memcpy nevertheless, can opt in
+// with a specialization.
+//
+//   namespace lean {
+//
+//   template <>
+//   struct is_trivially_relocatable<my_type> : std::true_type {};
+//
+//   }
+
+template <typename T>
+struct is_trivially_relocatable
+    : public bool_constant<std::is_trivially_move_constructible<T>::value &&
+                           std::is_trivially_destructible<T>::value>
+{
+};
+
+template <>
+struct is_trivially_relocatable<void>
+    : public std::false_type {};
+
+template <typename T>
+struct is_trivially_relocatable<const T>
+    : public is_trivially_relocatable<T> {};
+
 } // namespace lean
 
 //-----------------------------------------------------------------------------
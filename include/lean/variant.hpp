@@ -0,0 +1,730 @@
+#ifndef LEAN_VARIANT_HPP
+#define LEAN_VARIANT_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef> // std::size_t
+#include <exception>
+#include <limits>
+#include <lean/detail/config.hpp>
+#include <lean/detail/invoke_traits.hpp>
+#include <lean/detail/special_members.hpp>
+#include <lean/memory.hpp>
+#include <lean/throw.hpp>
+#include <lean/type_traits.hpp>
+#include <lean/utility.hpp>
+
+namespace lean
+{
+namespace v1
+{
+
+template <typename...>
+class variant;
+
+//-----------------------------------------------------------------------------
+// bad_variant_access
+
+struct bad_variant_access : public std::exception
+{
+    const char *what() const noexcept override
+    {
+        return "bad variant access";
+    }
+};
+
+constexpr std::size_t variant_npos = std::size_t(-1);
+
+//-----------------------------------------------------------------------------
+// variant_size
+
+template <typename>
+struct variant_size;
+
+template <typename... Types>
+struct variant_size<variant<Types...>>
+    : integral_constant<std::size_t, sizeof...(Types)>
+{
+};
+
+template <typename T>
+struct variant_size<const T> : variant_size<T> {};
+
+//-----------------------------------------------------------------------------
+// variant_alternative
+
+template <std::size_t, typename>
+struct variant_alternative;
+
+template <std::size_t I, typename... Types>
+struct variant_alternative<I, variant<Types...>>
+    : type_element<I, Types...>
+{
+};
+
+template <std::size_t I, typename T>
+using variant_alternative_t = typename variant_alternative<I, T>::type;
+
+template <std::size_t I, typename T>
+struct variant_alternative<I, const T>
+{
+    using type = add_const_t<variant_alternative_t<I, T>>;
+};
+
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// Smallest unsigned integer that can hold all alternative indices and the
+// valueless marker.
+
+template <std::size_t N>
+using variant_index_t = conditional_t<(N < std::numeric_limits<unsigned char>::max()),
+                                      unsigned char,
+                                      conditional_t<(N < std::numeric_limits<unsigned short>::max()),
+                                                    unsigned short,
+                                                    unsigned int>>;
+
+//-----------------------------------------------------------------------------
+// Jump table dispatch
+//
+// Visitor is invoked with integral_constant<std::size_t, I> and the variant.
+//
+// The table contains one function pointer per alternative, so dispatching
+// is a single indirect call regardless of the number of alternatives.
+
+template <typename R, typename Visitor, typename Variant, typename>
+struct variant_dispatch;
+
+template <typename R, typename Visitor, typename Variant, std::size_t... Ints>
+struct variant_dispatch<R, Visitor, Variant, index_sequence<Ints...>>
+{
+    using function_type = R (*)(Visitor&&, Variant&&);
+
+    template <std::size_t I>
+    static R call(Visitor&& visitor, Variant&& self)
+    {
+        return std::forward<Visitor>(visitor)(integral_constant<std::size_t, I>{},
+                                              std::forward<Variant>(self));
+    }
+
+    static R invoke(std::size_t index, Visitor&& visitor, Variant&& self)
+    {
+        static constexpr function_type table[] = { &call<Ints>... };
+        return table[index](std::forward<Visitor>(visitor), std::forward<Variant>(self));
+    }
+};
+
+template <typename R, std::size_t N, typename Visitor, typename Variant>
+R variant_invoke(std::size_t index, Visitor&& visitor, Variant&& self)
+{
+    return variant_dispatch<R, Visitor, Variant, make_index_sequence<N>>::invoke(
+        index,
+        std::forward<Visitor>(visitor),
+        std::forward<Variant>(self));
+}
+
+//-----------------------------------------------------------------------------
+// Storage and lifetime management
+//
+// The storage has the layout of inplace_union<Types...> but is kept as raw
+// bytes, so the variant is trivially copyable when all alternatives are.
+//
+// Alternatives are constructed with parentheses rather than construct_at, so
+// arguments are not captured by initializer-list constructors.
+
+template <typename... Types>
+struct variant_base
+{
+    static_assert(sizeof...(Types) > 0, "variant must have at least one alternative");
+
+    using index_type = variant_index_t<sizeof...(Types)>;
+    static constexpr index_type valueless = std::numeric_limits<index_type>::max();
+    static constexpr std::size_t size = sizeof...(Types);
+
+    template <std::size_t I>
+    using alternative = type_element_t<I, Types...>;
+
+    using is_trivially_destructible = conjunction<std::is_trivially_destructible<Types>...>;
+
+    template <std::size_t I>
+    alternative<I> *pointer() noexcept
+    {
+        return reinterpret_cast<alternative<I> *>(&storage);
+    }
+
+    template <std::size_t I>
+    const alternative<I> *pointer() const noexcept
+    {
+        return reinterpret_cast<const alternative<I> *>(&storage);
+    }
+
+    template <std::size_t I, typename... Args>
+    void construct(Args&&... args)
+    {
+        ::new (static_cast<void *>(pointer<I>())) alternative<I>(std::forward<Args>(args)...);
+        current = I;
+    }
+
+    void destroy() noexcept
+    {
+        destroy(is_trivially_destructible{});
+        current = valueless;
+    }
+
+    void copy_construct(const variant_base& other)
+    {
+        current = valueless;
+        if (other.current != valueless)
+        {
+            variant_invoke<void, size>(other.current, copy_construct_op{ this }, other);
+        }
+    }
+
+    void move_construct(variant_base&& other)
+    {
+        current = valueless;
+        if (other.current != valueless)
+        {
+            variant_invoke<void, size>(other.current, move_construct_op{ this }, std::move(other));
+        }
+    }
+
+    void copy_assign(const variant_base& other)
+    {
+        if ((current == other.current) && (current != valueless))
+        {
+            variant_invoke<void, size>(current, copy_assign_op{ this }, other);
+        }
+        else
+        {
+            destroy();
+            copy_construct(other);
+        }
+    }
+
+    void move_assign(variant_base&& other)
+    {
+        if ((current == other.current) && (current != valueless))
+        {
+            variant_invoke<void, size>(current, move_assign_op{ this }, std::move(other));
+        }
+        else
+        {
+            destroy();
+            move_construct(std::move(other));
+        }
+    }
+
+    bool equal(const variant_base& other) const
+    {
+        if (current != other.current)
+            return false;
+        if (current == valueless)
+            return true;
+        return variant_invoke<bool, size>(current, equal_op{ this }, other);
+    }
+
+    alignas(inplace_union<Types...>) unsigned char storage[sizeof(inplace_union<Types...>)];
+    index_type current;
+
+private:
+    void destroy(std::true_type) noexcept
+    {
+    }
+
+    void destroy(std::false_type) noexcept
+    {
+        if (current != valueless)
+        {
+            variant_invoke<void, size>(current, destroy_op{}, *this);
+        }
+    }
+
+    struct destroy_op
+    {
+        template <std::size_t I>
+        void operator()(integral_constant<std::size_t, I>, variant_base& self) const noexcept
+        {
+            destroy_at(self.pointer<I>());
+        }
+    };
+
+    struct copy_construct_op
+    {
+        variant_base *self;
+
+        template <std::size_t I>
+        void operator()(integral_constant<std::size_t, I>, const variant_base& other) const
+        {
+            self->construct<I>(*other.pointer<I>());
+        }
+    };
+
+    struct move_construct_op
+    {
+        variant_base *self;
+
+        template <std::size_t I>
+        void operator()(integral_constant<std::size_t, I>, variant_base&& other) const
+        {
+            self->construct<I>(std::move(*other.pointer<I>()));
+        }
+    };
+
+    struct copy_assign_op
+    {
+        variant_base *self;
+
+        template <std::size_t I>
+        void operator()(integral_constant<std::size_t, I>, const variant_base& other) const
+        {
+            *self->pointer<I>() = *other.pointer<I>();
+        }
+    };
+
+    struct move_assign_op
+    {
+        variant_base *self;
+
+        template <std::size_t I>
+        void operator()(integral_constant<std::size_t, I>, variant_base&& other) const
+        {
+            *self->pointer<I>() = std::move(*other.pointer<I>());
+        }
+    };
+
+    struct equal_op
+    {
+        const variant_base *self;
+
+        template <std::size_t I>
+        bool operator()(integral_constant<std::size_t, I>, const variant_base& other) const
+        {
+            return *self->pointer<I>() == *other.pointer<I>();
+        }
+    };
+};
+
+//-----------------------------------------------------------------------------
+// Destructor is trivial if all alternatives are trivially destructible.
+
+template <bool, typename... Types>
+struct variant_destructor
+    : variant_base<Types...>
+{
+};
+
+template <typename... Types>
+struct variant_destructor<false, Types...>
+    : variant_base<Types...>
+{
+    variant_destructor() = default;
+    variant_destructor(const variant_destructor&) = default;
+    variant_destructor(variant_destructor&&) = default;
+    variant_destructor& operator=(const variant_destructor&) = default;
+    variant_destructor& operator=(variant_destructor&&) = default;
+
+    ~variant_destructor()
+    {
+        this->destroy();
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Copy and move are trivial if all alternatives are trivially copyable.
+
+template <typename... Types>
+using variant_destructor_base = variant_destructor<conjunction<std::is_trivially_destructible<Types>...>::value,
+                                                   Types...>;
+
+template <bool, typename... Types>
+struct variant_copy
+    : variant_destructor_base<Types...>
+{
+};
+
+template <typename... Types>
+struct variant_copy<false, Types...>
+    : variant_destructor_base<Types...>
+{
+    variant_copy() = default;
+
+    variant_copy(const variant_copy& other)
+        noexcept(conjunction<std::is_nothrow_copy_constructible<Types>...>::value)
+        : variant_destructor_base<Types...>()
+    {
+        this->copy_construct(other);
+    }
+
+    variant_copy(variant_copy&& other)
+        noexcept(conjunction<std::is_nothrow_move_constructible<Types>...>::value)
+        : variant_destructor_base<Types...>()
+    {
+        this->move_construct(std::move(other));
+    }
+
+    variant_copy& operator=(const variant_copy& other)
+    {
+        this->copy_assign(other);
+        return *this;
+    }
+
+    variant_copy& operator=(variant_copy&& other)
+        noexcept(conjunction<std::is_nothrow_move_constructible<Types>...,
+                             std::is_nothrow_move_assignable<Types>...>::value)
+    {
+        this->move_assign(std::move(other));
+        return *this;
+    }
+};
+
+template <typename... Types>
+using variant_copy_base = variant_copy<conjunction<std::is_trivially_copyable<Types>...>::value,
+                                       Types...>;
+
+struct variant_access
+{
+    template <std::size_t I, typename... Types>
+    static type_element_t<I, Types...> *pointer(variant<Types...>& self) noexcept
+    {
+        return self.template pointer<I>();
+    }
+
+    template <std::size_t I, typename... Types>
+    static const type_element_t<I, Types...> *pointer(const variant<Types...>& self) noexcept
+    {
+        return self.template pointer<I>();
+    }
+};
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+// variant
+//
+//! @brief Type-safe tagged union.
+//!
+//! The discriminator uses the smallest unsigned integer type that can hold
+//! the number of alternatives.
+//!
+//! The variant is trivially destructible and trivially copyable if all
+//! alternatives are.
+//!
+//! Alternatives are selected by exact type, not by overload resolution.
+
+template <typename... Types>
+class variant
+    : private detail::variant_copy_base<Types...>
+    , private detail::enable_copy<conjunction<std::is_copy_constructible<Types>...,
+                                              std::is_copy_assignable<Types>...>::value>
+    , private detail::enable_move<conjunction<std::is_move_constructible<Types>...,
+                                              std::is_move_assignable<Types>...>::value>
+{
+    using base = detail::variant_copy_base<Types...>;
+
+    friend struct detail::variant_access;
+
+    template <typename T>
+    using index_of = type_find<T, Types...>;
+
+public:
+    //! @brief Creates object with value-initialized first alternative.
+
+    template <typename T = type_front_t<Types...>,
+              typename = enable_if_t<std::is_default_constructible<T>::value>>
+    variant() noexcept(std::is_nothrow_default_constructible<T>::value)
+    {
+        this->template construct<0>();
+    }
+
+    //! @brief Creates object with given value.
+    //!
+    //! The decayed type of the value must be one of the alternatives.
+
+    template <typename T,
+              typename DecayT = decay_t<T>,
+              typename = enable_if_t<!std::is_same<variant, DecayT>::value &&
+                                     type_contains<DecayT, Types...>::value>>
+    variant(T&& value) noexcept(std::is_nothrow_constructible<DecayT, T>::value)
+    {
+        this->template construct<index_of<DecayT>::value>(std::forward<T>(value));
+    }
+
+#if LEAN_HAS_IN_PLACE_TYPE
+
+    //! @brief Creates object with in-place construction of value.
+
+    template <typename T,
+              typename... Args,
+              typename = enable_if_t<type_contains<T, Types...>::value &&
+                                     std::is_constructible<T, Args...>::value>>
+    explicit variant(lean::in_place_type_t<T>, Args&&... args)
+    {
+        this->template construct<index_of<T>::value>(std::forward<Args>(args)...);
+    }
+
+#endif
+
+    //! @brief Assigns given value.
+    //!
+    //! Assigns directly to the current alternative if it has the same type.
+
+    template <typename T,
+              typename DecayT = decay_t<T>,
+              typename = enable_if_t<!std::is_same<variant, DecayT>::value &&
+                                     type_contains<DecayT, Types...>::value>>
+    variant& operator=(T&& value)
+    {
+        if (holds<DecayT>())
+        {
+            *this->template pointer<index_of<DecayT>::value>() = std::forward<T>(value);
+        }
+        else
+        {
+            emplace<index_of<DecayT>::value>(std::forward<T>(value));
+        }
+        return *this;
+    }
+
+    //! @brief Returns the index of the current alternative.
+    //!
+    //! Returns variant_npos if valueless.
+
+    constexpr std::size_t index() const noexcept
+    {
+        return valueless_by_exception() ? variant_npos : std::size_t(this->current);
+    }
+
+    //! @brief Checks if object has no value.
+    //!
+    //! The object becomes valueless if an exception is thrown during
+    //! emplacement.
+
+    constexpr bool valueless_by_exception() const noexcept
+    {
+        return this->current == base::valueless;
+    }
+
+    //! @brief Checks if the current alternative has type T.
+
+    template <typename T>
+    bool holds() const noexcept
+    {
+        return this->current == index_of<T>::value;
+    }
+
+    //! @brief Recreates object with alternative of type T.
+
+    template <typename T,
+              typename... Args,
+              typename = enable_if_t<type_contains<T, Types...>::value>>
+    T& emplace(Args&&... args)
+    {
+        return emplace<index_of<T>::value>(std::forward<Args>(args)...);
+    }
+
+    //! @brief Recreates object with alternative at index I.
+
+    template <std::size_t I,
+              typename... Args>
+    variant_alternative_t<I, variant>& emplace(Args&&... args)
+    {
+        static_assert(I < sizeof...(Types), "I must be a valid index");
+
+        this->destroy();
+        this->template construct<I>(std::forward<Args>(args)...);
+        return *this->template pointer<I>();
+    }
+
+    //! @brief Exchanges values.
+
+    void swap(variant& other)
+    {
+        variant temporary(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temporary);
+    }
+
+    friend bool operator==(const variant& lhs, const variant& rhs)
+    {
+        return lhs.equal(rhs);
+    }
+
+    friend bool operator!=(const variant& lhs, const variant& rhs)
+    {
+        return !lhs.equal(rhs);
+    }
+};
+
+//-----------------------------------------------------------------------------
+// holds_alternative
+
+template <typename T, typename... Types>
+bool holds_alternative(const variant<Types...>& self) noexcept
+{
+    return self.template holds<T>();
+}
+
+//-----------------------------------------------------------------------------
+// get_if
+
+template <std::size_t I, typename... Types>
+add_pointer_t<variant_alternative_t<I, variant<Types...>>>
+get_if(variant<Types...> *self) noexcept
+{
+    return (self && self->index() == I) ? detail::variant_access::pointer<I>(*self) : nullptr;
+}
+
+template <std::size_t I, typename... Types>
+add_pointer_t<const variant_alternative_t<I, variant<Types...>>>
+get_if(const variant<Types...> *self) noexcept
+{
+    return (self && self->index() == I) ? detail::variant_access::pointer<I>(*self) : nullptr;
+}
+
+template <typename T, typename... Types>
+add_pointer_t<T> get_if(variant<Types...> *self) noexcept
+{
+    return get_if<type_find<T, Types...>::value>(self);
+}
+
+template <typename T, typename... Types>
+add_pointer_t<const T> get_if(const variant<Types...> *self) noexcept
+{
+    return get_if<type_find<T, Types...>::value>(self);
+}
+
+//-----------------------------------------------------------------------------
+// get
+//
+// Throws bad_variant_access if the alternative is not the current one.
+
+template <std::size_t I, typename... Types>
+variant_alternative_t<I, variant<Types...>>& get(variant<Types...>& self)
+{
+    if (LEAN_UNLIKELY(self.index() != I))
+        throw_exception<bad_variant_access>();
+    return *detail::variant_access::pointer<I>(self);
+}
+
+template <std::size_t I, typename... Types>
+const variant_alternative_t<I, variant<Types...>>& get(const variant<Types...>& self)
+{
+    if (LEAN_UNLIKELY(self.index() != I))
+        throw_exception<bad_variant_access>();
+    return *detail::variant_access::pointer<I>(self);
+}
+
+template <std::size_t I, typename... Types>
+variant_alternative_t<I, variant<Types...>>&& get(variant<Types...>&& self)
+{
+    return std::move(get<I>(self));
+}
+
+template <std::size_t I, typename... Types>
+const variant_alternative_t<I, variant<Types...>>&& get(const variant<Types...>&& self)
+{
+    return std::move(get<I>(self));
+}
+
+template <typename T, typename... Types>
+T& get(variant<Types...>& self)
+{
+    return get<type_find<T, Types...>::value>(self);
+}
+
+template <typename T, typename... Types>
+const T& get(const variant<Types...>& self)
+{
+    return get<type_find<T, Types...>::value>(self);
+}
+
+template <typename T, typename... Types>
+T&& get(variant<Types...>&& self)
+{
+    return get<type_find<T, Types...>::value>(std::move(self));
+}
+
+template <typename T, typename... Types>
+const T&& get(const variant<Types...>&& self)
+{
+    return get<type_find<T, Types...>::value>(std::move(self));
+}
+
+//-----------------------------------------------------------------------------
+// visit
+//
+// Invokes visitor with the current alternative via a jump table.
+//
+// The visitor must return the same type for all alternatives.
+
+namespace detail
+{
+
+template <typename R, typename Visitor>
+struct variant_visitor
+{
+    Visitor&& visitor;
+
+    template <std::size_t I, typename Variant>
+    R operator()(integral_constant<std::size_t, I>, Variant&& self) const
+    {
+        using alternative_type = variant_alternative_t<I, remove_cvref_t<Variant>>;
+        return v1::invoke(std::forward<Visitor>(visitor),
+                            static_cast<copy_cvref_t<Variant&&, alternative_type>>(*variant_access::pointer<I>(self)));
+    }
+};
+
+template <typename Visitor, typename Variant>
+using variant_visit_result_t = decltype(v1::invoke(std::declval<Visitor>(),
+                                                     get<0>(std::declval<Variant>())));
+
+} // namespace detail
+
+template <typename Visitor, typename Variant>
+auto visit(Visitor&& visitor, Variant&& self)
+    -> detail::variant_visit_result_t<Visitor, Variant>
+{
+    using result_type = detail::variant_visit_result_t<Visitor, Variant>;
+    using visitor_type = detail::variant_visitor<result_type, Visitor>;
+
+    if (LEAN_UNLIKELY(self.valueless_by_exception()))
+        throw_exception<bad_variant_access>();
+
+    return detail::variant_invoke<result_type, variant_size<remove_cvref_t<Variant>>::value>(
+        self.index(),
+        visitor_type{ std::forward<Visitor>(visitor) },
+        std::forward<Variant>(self));
+}
+
+} // namespace v1
+
+//-----------------------------------------------------------------------------
+
+template <typename... Types>
+struct is_trivially_relocatable<v1::variant<Types...>>
+    : public conjunction<is_trivially_relocatable<Types>...> {};
+
+using v1::variant;
+using v1::variant_npos;
+using v1::variant_size;
+using v1::variant_alternative;
+using v1::variant_alternative_t;
+using v1::bad_variant_access;
+using v1::holds_alternative;
+using v1::get_if;
+using v1::get;
+using v1::visit;
+
+} // namespace lean
+
+#endif // LEAN_VARIANT_HPP
@@ -0,0 +1,123 @@
+#ifndef LEAN_WAIT_STATISTICS_HPP
+#define LEAN_WAIT_STATISTICS_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Instrumentation of lean::atomic wait and notify.
+//
+// Counters are only updated when LEAN_WAIT_STATISTICS is defined for the
+// whole program, and only by the futex backend. Otherwise all counters stay
+// zero and the instrumentation has no cost.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <lean/atomic.hpp>
+#include <lean/detail/config.hpp>
+#include <lean/detail/wait_statistics.hpp>
+
+namespace lean
+{
+namespace v1
+{
+
+//! @brief Returns snapshots of all registered wait counters.
+
+inline std::vector<wait_statistics> snapshot_wait_statistics()
+{
+    std::vector<wait_statistics> result;
+    wait_counters::for_each([&result] (const wait_counters& counters) {
+        result.push_back(counters.snapshot());
+    });
+    return result;
+}
+
+//! @brief Writes one line per registered wait counters.
+
+inline void dump_wait_statistics(std::FILE *output)
+{
+    for (const auto& item : snapshot_wait_statistics())
+    {
+        std::fprintf(output,
+                     "%s: waits=%llu wait_syscalls=%llu spurious=%llu wait_ns=%llu max_wait_ns=%llu"
+                     " p50_wait_ns=%llu p99_wait_ns=%llu"
+                     " notifies=%llu wake_syscalls=%llu no_waiters=%llu\n",
+                     item.name,
+                     static_cast<unsigned long long>(item.waits),
+                     static_cast<unsigned long long>(item.wait_syscalls),
+                     static_cast<unsigned long long>(item.spurious_wakeups),
+                     static_cast<unsigned long long>(item.wait_nanoseconds),
+                     static_cast<unsigned long long>(item.max_wait_nanoseconds),
+                     static_cast<unsigned long long>(item.p50_wait_nanoseconds),
+                     static_cast<unsigned long long>(item.p99_wait_nanoseconds),
+                     static_cast<unsigned long long>(item.notifies),
+                     static_cast<unsigned long long>(item.wake_syscalls),
+                     static_cast<unsigned long long>(item.notifies_without_waiters));
+    }
+    std::fflush(output);
+}
+
+//! @brief Dumps wait statistics periodically from a background thread.
+//!
+//! A final dump is written when the reporter is destroyed.
+
+class wait_statistics_reporter
+{
+public:
+    explicit wait_statistics_reporter(std::chrono::milliseconds interval,
+                                      std::FILE *output = stderr)
+        : worker([this, interval, output] { run(interval, output); })
+    {
+    }
+
+    wait_statistics_reporter(const wait_statistics_reporter&) = delete;
+    wait_statistics_reporter& operator=(const wait_statistics_reporter&) = delete;
+
+    ~wait_statistics_reporter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        condition.notify_one();
+        worker.join();
+    }
+
+private:
+    void run(std::chrono::milliseconds interval, std::FILE *output)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!condition.wait_for(lock, interval, [this] { return stopped; }))
+        {
+            dump_wait_statistics(output);
+        }
+        dump_wait_statistics(output);
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopped = false;
+    std::thread worker;
+};
+
+} // namespace v1
+
+using v1::dump_wait_statistics;
+using v1::snapshot_wait_statistics;
+using v1::wait_statistics_reporter;
+
+} // namespace lean
+
+#endif // LEAN_WAIT_STATISTICS_HPP
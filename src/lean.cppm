@@ -0,0 +1,347 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// C++20 named module with the public API
+//
+//   import lean;
+//
+// The headers are included in the global module fragment, so the module and
+// the headers can be used together in the same program.
+
+module;
+
+#include <lean/any.hpp>
+#include <lean/atomic.hpp>
+#include <lean/checked.hpp>
+#include <lean/epoch.hpp>
+#include <lean/expected.hpp>
+#include <lean/function_traits.hpp>
+#include <lean/functional.hpp>
+#include <lean/hazard_pointer.hpp>
+#include <lean/intrusive_ptr.hpp>
+#include <lean/latency_histogram.hpp>
+#include <lean/memory.hpp>
+#include <lean/new.hpp>
+#include <lean/optional.hpp>
+#include <lean/throw.hpp>
+#include <lean/trace_buffer.hpp>
+#include <lean/tuple.hpp>
+#include <lean/type_traits.hpp>
+#include <lean/utility.hpp>
+#include <lean/variant.hpp>
+#include <lean/wait_statistics.hpp>
+
+export module lean;
+
+export namespace lean
+{
+
+// <lean/any.hpp>
+
+using lean::unique_any;
+using lean::any_cast;
+
+// <lean/atomic.hpp>
+
+using lean::atomic;
+using lean::atomic_notify_one;
+using lean::atomic_wait;
+using lean::atomic_wait_explicit;
+
+// <lean/checked.hpp>
+
+using lean::add;
+using lean::sub;
+using lean::mul;
+using lean::narrow;
+using lean::unchecked;
+using lean::checked;
+using lean::checked_expected;
+using lean::is_checked_policy;
+using lean::default_policy;
+
+// <lean/epoch.hpp>
+
+using lean::epoch_domain;
+
+// <lean/expected.hpp>
+
+using lean::unexpected;
+using lean::make_unexpected;
+using lean::unexpect_t;
+using lean::unexpect;
+using lean::bad_expected_access;
+using lean::expected;
+using lean::try_invoke;
+
+// <lean/function_traits.hpp>
+
+using lean::function_type;
+using lean::function_type_t;
+using lean::function_return;
+using lean::function_return_t;
+using lean::function_arguments;
+using lean::function_arguments_t;
+using lean::function_rebind;
+using lean::function_rebind_t;
+using lean::is_function_const;
+using lean::is_function_const_t;
+using lean::is_function_volatile;
+using lean::is_function_volatile_t;
+using lean::is_function_lvalue_reference;
+using lean::is_function_lvalue_reference_t;
+using lean::is_function_rvalue_reference;
+using lean::is_function_rvalue_reference_t;
+using lean::is_function_reference;
+using lean::is_function_reference_t;
+using lean::is_function_ellipsis;
+using lean::is_function_ellipsis_t;
+using lean::add_function_const;
+using lean::add_function_const_t;
+using lean::add_function_volatile;
+using lean::add_function_volatile_t;
+using lean::add_function_cv;
+using lean::add_function_cv_t;
+using lean::add_function_lvalue_reference;
+using lean::add_function_lvalue_reference_t;
+using lean::add_function_rvalue_reference;
+using lean::add_function_rvalue_reference_t;
+using lean::add_function_ellipsis;
+using lean::add_function_ellipsis_t;
+using lean::remove_function_const;
+using lean::remove_function_const_t;
+using lean::remove_function_volatile;
+using lean::remove_function_volatile_t;
+using lean::remove_function_cv;
+using lean::remove_function_cv_t;
+using lean::remove_function_reference;
+using lean::remove_function_reference_t;
+using lean::remove_function_cvref;
+using lean::remove_function_cvref_t;
+using lean::remove_function_ellipsis;
+using lean::remove_function_ellipsis_t;
+
+// <lean/functional.hpp>
+
+using lean::invoke;
+using lean::invoke_r;
+
+// <lean/hazard_pointer.hpp>
+
+using lean::hazard_pointer_domain;
+
+// <lean/intrusive_ptr.hpp>
+
+using lean::thread_safe;
+using lean::thread_unsafe;
+using lean::ref_counted;
+using lean::intrusive_ptr;
+using lean::make_intrusive;
+
+// <lean/latency_histogram.hpp>
+
+using lean::latency_histogram;
+
+// <lean/memory.hpp>
+
+using lean::construct_at;
+using lean::destroy_at;
+using lean::destroy_n;
+using lean::uninitialized_copy_n;
+using lean::uninitialized_move_n;
+using lean::uninitialized_value_construct_n;
+using lean::relocate_at;
+using lean::uninitialized_relocate_n;
+using lean::inplace_storage;
+using lean::inplace_value;
+using lean::inplace_union;
+using lean::cache_padded;
+
+// <lean/new.hpp>
+
+using lean::hardware_destructive_interference_size;
+using lean::hardware_constructive_interference_size;
+
+// <lean/optional.hpp>
+
+using lean::optional_traits;
+using lean::optional_sentinel;
+using lean::bad_optional_access;
+using lean::nullopt_t;
+using lean::nullopt;
+using lean::optional;
+using lean::make_optional;
+
+// <lean/throw.hpp>
+
+using lean::throw_context;
+using lean::throw_handler;
+using lean::throw_visitor;
+using lean::throw_type_id;
+using lean::throw_arguments_id;
+using lean::throw_arguments;
+using lean::throw_visit;
+using lean::set_throw_handler;
+using lean::get_throw_handler;
+using lean::throw_traits;
+using lean::throw_exception;
+using lean::lazy_exception;
+using lean::throw_lazy_exception;
+
+// <lean/trace_buffer.hpp>
+
+using lean::trace_phase;
+using lean::trace_record;
+using lean::trace_buffer;
+using lean::trace_collector;
+using lean::write_chrome_trace;
+
+// <lean/tuple.hpp>
+
+using lean::apply_r;
+
+// <lean/type_traits.hpp>
+
+using lean::template_size;
+using lean::template_element;
+using lean::template_element_t;
+using lean::template_rebind;
+using lean::template_rebind_t;
+using lean::prototype;
+using lean::integral_constant;
+using lean::bool_constant;
+using lean::add_const;
+using lean::add_pointer;
+using lean::add_lvalue_reference;
+using lean::add_rvalue_reference;
+using lean::add_volatile;
+using lean::conditional;
+using lean::decay;
+using lean::enable_if;
+using lean::is_function;
+using lean::is_same;
+using lean::remove_const;
+using lean::remove_cv;
+using lean::remove_pointer;
+using lean::remove_reference;
+using lean::add_const_t;
+using lean::add_pointer_t;
+using lean::add_lvalue_reference_t;
+using lean::add_rvalue_reference_t;
+using lean::add_volatile_t;
+using lean::conditional_t;
+using lean::decay_t;
+using lean::enable_if_t;
+using lean::remove_const_t;
+using lean::remove_cv_t;
+using lean::remove_pointer_t;
+using lean::remove_reference_t;
+using lean::conjunction;
+using lean::disjunction;
+using lean::negation;
+using lean::remove_cvref;
+using lean::remove_cvref_t;
+using lean::add_type_const;
+using lean::add_type_volatile;
+using lean::add_type_cv;
+using lean::remove_member_pointer;
+using lean::remove_member_pointer_t;
+using lean::copy_const;
+using lean::copy_const_t;
+using lean::copy_volatile;
+using lean::copy_volatile_t;
+using lean::copy_cv;
+using lean::copy_cv_t;
+using lean::copy_reference;
+using lean::copy_reference_t;
+using lean::copy_cvref;
+using lean::copy_cvref_t;
+using lean::void_t;
+using lean::is_complete;
+using lean::type_identity;
+using lean::type_identity_t;
+using lean::type_t;
+using lean::type_eval;
+using lean::type_eval_t;
+using lean::type_bind_projection;
+using lean::type_contains;
+using lean::type_find;
+using lean::type_fold_left;
+using lean::type_fold_left_t;
+using lean::type_front;
+using lean::type_front_t;
+using lean::type_element;
+using lean::type_element_t;
+using lean::type_sizeof;
+using lean::type_alignof;
+using lean::type_predicate_min_with;
+using lean::type_predicate_min;
+using lean::type_predicate_min_with_t;
+using lean::type_predicate_min_t;
+using lean::type_predicate_max_with;
+using lean::type_predicate_max;
+using lean::type_predicate_max_with_t;
+using lean::type_predicate_max_t;
+using lean::type_min_with;
+using lean::type_min_with_t;
+using lean::type_min_t;
+using lean::type_find_min_with;
+using lean::type_find_min;
+using lean::type_max_with;
+using lean::type_max_with_t;
+using lean::type_max_t;
+using lean::type_find_max_with;
+using lean::type_find_max;
+using lean::is_mutable_reference;
+using lean::decay_forward_t;
+using lean::is_trivially_move_constructible;
+using lean::is_trivially_relocatable;
+using lean::is_invocable;
+using lean::is_nothrow_invocable;
+using lean::invoke_result;
+using lean::invoke_result_t;
+
+// <lean/utility.hpp>
+
+using lean::integer_sequence;
+using lean::index_sequence;
+using lean::make_integer_sequence;
+using lean::make_index_sequence;
+using lean::index_sequence_for;
+using lean::decay_forward;
+using lean::exchange;
+using lean::in_place_t;
+using lean::in_place;
+using lean::in_place_type_t;
+using lean::in_place_type;
+
+// <lean/variant.hpp>
+
+using lean::variant;
+using lean::variant_npos;
+using lean::variant_size;
+using lean::variant_alternative;
+using lean::variant_alternative_t;
+using lean::bad_variant_access;
+using lean::holds_alternative;
+using lean::get_if;
+using lean::get;
+using lean::visit;
+
+// <lean/wait_statistics.hpp>
+
+using lean::wait_statistics;
+using lean::wait_counters;
+using lean::wait_scope;
+using lean::snapshot_wait_statistics;
+using lean::dump_wait_statistics;
+using lean::wait_statistics_reporter;
+
+} // namespace lean
@@ -1,4 +1,6 @@
 #include "test_assert.hpp"
+#include "test_allocation.hpp"
+#include <string>
 #include <lean/any.hpp>
 
 //-----------------------------------------------------------------------------
@@ -18,6 +20,8 @@ static_assert(!std::is_copy_assignable<lean::unique_any>::value, "not copy assig
 static_assert(std::is_nothrow_move_assignable<lean::unique_any>::value, "move assignable");
 static_assert(std::is_assignable<lean::unique_any, int>::value, "value assignable");
 
+static_assert(lean::is_trivially_relocatable<lean::unique_any>::value, "trivially relocatable");
+
 void api_ctor_default()
 {
     lean::unique_any any;
@@ -210,9 +214,73 @@ void run()
 
 //-----------------------------------------------------------------------------
 
+namespace allocation_suite
+{
+
+struct small_nontrivial
+{
+    small_nontrivial() = default;
+    small_nontrivial(small_nontrivial&&) noexcept {}
+    char value = 0;
+};
+
+struct large_trivial
+{
+    char data[8 * sizeof(void *)];
+};
+
+void small_trivial_in_place()
+{
+    expect_no_allocations
+    {
+        lean::unique_any any{42};
+        lean::unique_any copy{std::move(any)};
+        copy = 43;
+        copy.emplace<void *>(nullptr);
+        assert(copy.holds<void *>());
+    }
+}
+
+void small_nontrivial_allocated()
+{
+    test_allocation::scope tracking;
+    {
+        lean::unique_any any{small_nontrivial{}};
+        assert(any.holds<small_nontrivial>());
+        lean::unique_any copy{std::move(any)};
+    }
+    assert(tracking.get().allocations == 1);
+    assert(tracking.get().deallocations == 1);
+}
+
+void large_allocated()
+{
+    test_allocation::scope tracking;
+    expect_allocations(1)
+    {
+        lean::unique_any any{large_trivial{}};
+        lean::unique_any copy{std::move(any)};
+    }
+    assert(tracking.get().allocations == 1);
+    assert(tracking.get().peak_bytes >= std::ptrdiff_t(sizeof(large_trivial)));
+    assert(tracking.get().current_bytes == 0);
+}
+
+void run()
+{
+    small_trivial_in_place();
+    small_nontrivial_allocated();
+    large_allocated();
+}
+
+} // namespace allocation_suite
+
+//-----------------------------------------------------------------------------
+
 int main()
 {
     unique_any_suite::run();
     any_cast_suite::run();
+    allocation_suite::run();
     return 0;
 }
@@ -6,6 +6,20 @@
 
 //-----------------------------------------------------------------------------
 
+namespace atomic_layout_suite
+{
+
+#if defined(LEAN_DETAIL_LINUX_ATOMIC_HPP) && LEAN_ATOMIC_PADDING
+
+static_assert(alignof(lean::atomic<int>) == lean::hardware_destructive_interference_size, "");
+static_assert(sizeof(lean::atomic<int>) == 2 * lean::hardware_destructive_interference_size, "");
+
+#endif
+
+} // namespace atomic_layout_suite
+
+//-----------------------------------------------------------------------------
+
 namespace atomic_wait_suite
 {
 
@@ -55,11 +69,38 @@ void threaded_wait_post_join()
     assert(shared.load() == true);
 }
 
+void threaded_ping_pong()
+{
+    // A lost notification blocks forever
+    constexpr int rounds = 10000;
+    lean::atomic<int> shared{ 0 };
+
+    std::thread thread(
+        [&] {
+            for (int turn = 1; turn < 2 * rounds; turn += 2)
+            {
+                shared.wait(turn - 1);
+                shared.store(turn + 1);
+                shared.notify_one();
+            }
+        });
+
+    for (int turn = 0; turn < 2 * rounds; turn += 2)
+    {
+        shared.store(turn + 1);
+        shared.notify_one();
+        shared.wait(turn + 1);
+    }
+    thread.join();
+    assert(shared.load() == 2 * rounds);
+}
+
 void run()
 {
     wait_ready();
     threaded_wait();
     threaded_wait_post_join();
+    threaded_ping_pong();
 }
 
 } // namespace atomic_wait_suite
@@ -8,7 +8,11 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include "test_assert.hpp"
+#include <cstdint>
+#include <limits>
 #include <new> // std::nothrow_t
+#include <stdexcept>
 #include <lean/checked.hpp>
 
 //-----------------------------------------------------------------------------
@@ -32,7 +36,184 @@ static_assert(!lean::v1::is_checked_policy<std::nothrow_t>::value, "");
 
 //-----------------------------------------------------------------------------
 
+namespace v1_add_suite
+{
+
+static_assert(std::is_same<decltype(lean::add<lean::unchecked>(1, 2)), int>::value, "");
+static_assert(std::is_same<decltype(lean::add<lean::checked>(1, 2)), int>::value, "");
+static_assert(std::is_same<decltype(lean::add<lean::checked_expected>(1, 2)), lean::expected<int, std::errc>>::value, "");
+static_assert(std::is_same<decltype(lean::add<std::nothrow_t>(1, 2)), int>::value, "");
+static_assert(lean::add<lean::unchecked>(1, 2) == 3, "");
+
+void add_unchecked()
+{
+    assert(lean::add<lean::unchecked>(1, 2) == 3);
+    assert(lean::add<lean::unchecked>(std::uint8_t(200), std::uint8_t(100)) == 44);
+}
+
+void add_checked()
+{
+    assert(lean::add(1, 2) == 3);
+    assert(lean::add<lean::checked>(-1, 2) == 1);
+    assert(lean::add<lean::checked>(std::numeric_limits<int>::max(), 0) == std::numeric_limits<int>::max());
+    assert_throw_with(lean::add<lean::checked>(std::numeric_limits<int>::max(), 1), \
+                      std::overflow_error);
+    assert_throw_with(lean::add<lean::checked>(std::numeric_limits<int>::min(), -1), \
+                      std::overflow_error);
+    assert_throw_with(lean::add<lean::checked>(std::uint8_t(200), std::uint8_t(100)), \
+                      std::overflow_error);
+}
+
+void add_checked_expected()
+{
+    auto result = lean::add<lean::checked_expected>(1, 2);
+    assert(result.has_value());
+    assert(*result == 3);
+    result = lean::add<lean::checked_expected>(std::numeric_limits<int>::max(), 1);
+    assert(!result.has_value());
+    assert(result.error() == std::errc::result_out_of_range);
+}
+
+void run()
+{
+    add_unchecked();
+    add_checked();
+    add_checked_expected();
+}
+
+} // namespace v1_add_suite
+
+//-----------------------------------------------------------------------------
+
+namespace v1_sub_suite
+{
+
+void sub_unchecked()
+{
+    assert(lean::sub<lean::unchecked>(1, 2) == -1);
+    assert(lean::sub<lean::unchecked>(0U, 1U) == std::numeric_limits<unsigned int>::max());
+}
+
+void sub_checked()
+{
+    assert(lean::sub<lean::checked>(1, 2) == -1);
+    assert_throw_with(lean::sub<lean::checked>(0U, 1U), \
+                      std::overflow_error);
+    assert_throw_with(lean::sub<lean::checked>(std::numeric_limits<int>::min(), 1), \
+                      std::overflow_error);
+    assert_throw_with(lean::sub<lean::checked>(0, std::numeric_limits<int>::min()), \
+                      std::overflow_error);
+}
+
+void sub_checked_expected()
+{
+    auto result = lean::sub<lean::checked_expected>(0U, 1U);
+    assert(!result.has_value());
+    assert(result.error() == std::errc::result_out_of_range);
+}
+
+void run()
+{
+    sub_unchecked();
+    sub_checked();
+    sub_checked_expected();
+}
+
+} // namespace v1_sub_suite
+
+//-----------------------------------------------------------------------------
+
+namespace v1_mul_suite
+{
+
+void mul_unchecked()
+{
+    assert(lean::mul<lean::unchecked>(3, 4) == 12);
+    assert(lean::mul<lean::unchecked>(std::uint8_t(16), std::uint8_t(16)) == 0);
+}
+
+void mul_checked()
+{
+    assert(lean::mul<lean::checked>(-3, 4) == -12);
+    assert(lean::mul<lean::checked>(0, std::numeric_limits<int>::min()) == 0);
+    assert_throw_with(lean::mul<lean::checked>(std::numeric_limits<int>::max(), 2), \
+                      std::overflow_error);
+    assert_throw_with(lean::mul<lean::checked>(std::numeric_limits<int>::min(), -1), \
+                      std::overflow_error);
+    assert_throw_with(lean::mul<lean::checked>(std::uint8_t(16), std::uint8_t(16)), \
+                      std::overflow_error);
+}
+
+void mul_checked_expected()
+{
+    auto result = lean::mul<lean::checked_expected>(std::numeric_limits<long>::max(), 2L);
+    assert(!result.has_value());
+    assert(result.error() == std::errc::result_out_of_range);
+}
+
+void run()
+{
+    mul_unchecked();
+    mul_checked();
+    mul_checked_expected();
+}
+
+} // namespace v1_mul_suite
+
+//-----------------------------------------------------------------------------
+
+namespace v1_narrow_suite
+{
+
+static_assert(std::is_same<decltype(lean::narrow<short>(1)), short>::value, "");
+static_assert(std::is_same<decltype(lean::narrow<short, lean::checked_expected>(1)), lean::expected<short, std::errc>>::value, "");
+static_assert(lean::narrow<short, lean::unchecked>(1) == 1, "");
+
+void narrow_unchecked()
+{
+    assert((lean::narrow<std::uint8_t, lean::unchecked>(257) == 1));
+    assert((lean::narrow<unsigned int, lean::unchecked>(-1) == std::numeric_limits<unsigned int>::max()));
+}
+
+void narrow_checked()
+{
+    assert(lean::narrow<std::uint8_t>(255) == 255);
+    assert(lean::narrow<std::int8_t>(-128) == -128);
+    assert(lean::narrow<long long>(-1) == -1);
+    assert_throw_with(lean::narrow<std::uint8_t>(256), \
+                      std::overflow_error);
+    assert_throw_with(lean::narrow<std::int8_t>(-129), \
+                      std::overflow_error);
+    assert_throw_with(lean::narrow<unsigned int>(-1), \
+                      std::overflow_error);
+    assert_throw_with(lean::narrow<int>(std::numeric_limits<unsigned int>::max()), \
+                      std::overflow_error);
+}
+
+void narrow_checked_expected()
+{
+    auto result = lean::narrow<std::uint16_t, lean::checked_expected>(65536);
+    assert(!result.has_value());
+    assert(result.error() == std::errc::result_out_of_range);
+    assert((*lean::narrow<std::uint16_t, lean::checked_expected>(65535) == 65535));
+}
+
+void run()
+{
+    narrow_unchecked();
+    narrow_checked();
+    narrow_checked_expected();
+}
+
+} // namespace v1_narrow_suite
+
+//-----------------------------------------------------------------------------
+
 int main()
 {
+    v1_add_suite::run();
+    v1_sub_suite::run();
+    v1_mul_suite::run();
+    v1_narrow_suite::run();
     return 0;
 }
@@ -0,0 +1,51 @@
+###############################################################################
+#
+# Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+#
+# Distributed under the Boost Software License, Version 1.0.
+#    (See accompanying file LICENSE_1_0.txt or copy at
+#          http://www.boost.org/LICENSE_1_0.txt)
+#
+###############################################################################
+
+# Checks for branch instructions in the disassembly of a function.
+#
+#   cmake -DOBJDUMP=<objdump> -DOBJECT=<file> -DFUNCTION=<symbol>
+#         -DEXPECT=<none|some> -P check_branches.cmake
+
+foreach(variable OBJDUMP OBJECT FUNCTION EXPECT)
+  if (NOT DEFINED ${variable})
+    message(FATAL_ERROR "${variable} is not defined")
+  endif()
+endforeach()
+
+execute_process(
+  COMMAND ${OBJDUMP} -d --no-show-raw-insn ${OBJECT}
+  OUTPUT_VARIABLE disassembly
+  RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+  message(FATAL_ERROR "${OBJDUMP} failed on ${OBJECT}")
+endif()
+
+# Function body runs from its label to the next empty line
+string(FIND "${disassembly}" "<${FUNCTION}>:" start)
+if (start EQUAL -1)
+  message(FATAL_ERROR "${FUNCTION} not found in ${OBJECT}")
+endif()
+string(SUBSTRING "${disassembly}" ${start} -1 body)
+string(FIND "${body}" "\n\n" end)
+if (NOT end EQUAL -1)
+  string(SUBSTRING "${body}" 0 ${end} body)
+endif()
+
+# x86 jumps, and AArch64 conditional and unconditional branches
+set(branch_pattern "\t(j[a-z]+|b\\.[a-z]+|b|cbn?z|tbn?z)[ \t]")
+string(REGEX MATCHALL "${branch_pattern}[^\n]*" branches "${body}")
+list(LENGTH branches count)
+
+if (EXPECT STREQUAL "none" AND count GREATER 0)
+  message(FATAL_ERROR "${FUNCTION} has branches:\n${body}")
+elseif (EXPECT STREQUAL "some" AND count EQUAL 0)
+  message(FATAL_ERROR "${FUNCTION} has no branches:\n${body}")
+endif()
+message(STATUS "${FUNCTION}: ${count} branches")
@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Functions inspected by check_branches.cmake after compilation with
+// optimization. C linkage keeps the symbol names readable in the
+// disassembly.
+
+#include <cstddef>
+#include <lean/checked.hpp>
+#include <lean/memory.hpp>
+
+using storage_type = lean::inplace_storage<16 * sizeof(int), alignof(int)>;
+
+extern "C" {
+
+//-----------------------------------------------------------------------------
+// inplace_storage
+
+int lean_codegen_at_unchecked(storage_type& storage, std::size_t index)
+{
+    return storage.at<int, lean::unchecked>(index);
+}
+
+int lean_codegen_at_checked(storage_type& storage, std::size_t index)
+{
+    return storage.at<int, lean::checked>(index);
+}
+
+int *lean_codegen_data_unchecked(storage_type& storage, std::size_t offset)
+{
+    return storage.data<int, lean::unchecked>(offset);
+}
+
+int *lean_codegen_data_checked(storage_type& storage, std::size_t offset)
+{
+    return storage.data<int, lean::checked>(offset);
+}
+
+//-----------------------------------------------------------------------------
+// Arithmetic
+
+int lean_codegen_add_unchecked(int lhs, int rhs)
+{
+    return lean::add<lean::unchecked>(lhs, rhs);
+}
+
+int lean_codegen_add_checked(int lhs, int rhs)
+{
+    return lean::add<lean::checked>(lhs, rhs);
+}
+
+int lean_codegen_mul_unchecked(int lhs, int rhs)
+{
+    return lean::mul<lean::unchecked>(lhs, rhs);
+}
+
+short lean_codegen_narrow_unchecked(long value)
+{
+    return lean::narrow<short, lean::unchecked>(value);
+}
+
+short lean_codegen_narrow_checked(long value)
+{
+    return lean::narrow<short, lean::checked>(value);
+}
+
+} // extern "C"
@@ -0,0 +1,246 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "test_assert.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <lean/epoch.hpp>
+
+#if LEAN_CXX >= LEAN_LIB_ATOMIC_WAIT
+
+//-----------------------------------------------------------------------------
+
+struct node
+{
+    node(int value) : value(value) { ++alive; }
+    ~node() { value = -1; --alive; }
+
+    int value;
+
+    static std::atomic<int> alive;
+};
+
+std::atomic<int> node::alive{ 0 };
+
+//-----------------------------------------------------------------------------
+
+namespace epoch_suite
+{
+
+using namespace lean::v1;
+
+void api_retire_synchronize()
+{
+    epoch_domain domain;
+    domain.retire(new node(1));
+    domain.retire(new node(2));
+    assert(node::alive == 2);
+    domain.synchronize();
+    assert(node::alive == 0);
+}
+
+void api_retire_destructor()
+{
+    {
+        epoch_domain domain;
+        domain.retire(new node(1));
+        assert(node::alive == 1);
+    }
+    assert(node::alive == 0);
+}
+
+void api_retire_deleter()
+{
+    static int deleted = 0;
+    int value = 0;
+    epoch_domain domain;
+    domain.retire(&value, [] (void *) { ++deleted; });
+    domain.synchronize();
+    assert(deleted == 1);
+}
+
+void api_retire_batch()
+{
+    epoch_domain domain(4);
+    for (int i = 0; i < 16; ++i)
+    {
+        domain.retire(new node(i));
+    }
+    // Batches are reclaimed two epochs after retirement
+    assert(node::alive < 16);
+    domain.synchronize();
+    assert(node::alive == 0);
+}
+
+void api_reclaim()
+{
+    epoch_domain domain;
+    domain.retire(new node(1));
+    assert(domain.reclaim() == 0);
+    assert(domain.reclaim() == 1);
+    assert(node::alive == 0);
+}
+
+void api_pin()
+{
+    epoch_domain domain;
+    auto object = new node(42);
+    {
+        auto guard = domain.pin();
+        domain.retire(object);
+        // Pinned by this thread
+        assert(domain.reclaim() == 0);
+        assert(domain.reclaim() == 0);
+        assert(object->value == 42);
+    }
+    assert(domain.reclaim() == 1);
+}
+
+void api_pin_nested()
+{
+    epoch_domain domain;
+    auto object = new node(42);
+    {
+        auto outer = domain.pin();
+        domain.retire(object);
+        {
+            auto inner = domain.pin();
+        }
+        assert(domain.reclaim() == 0);
+        assert(domain.reclaim() == 0);
+        assert(object->value == 42);
+    }
+    domain.synchronize();
+    assert(node::alive == 0);
+}
+
+void api_pin_move()
+{
+    epoch_domain domain;
+    auto object = new node(42);
+    {
+        auto guard = domain.pin();
+        domain.retire(object);
+        auto other = std::move(guard);
+        assert(domain.reclaim() == 0);
+        assert(domain.reclaim() == 0);
+    }
+    domain.synchronize();
+    assert(node::alive == 0);
+}
+
+void run()
+{
+    api_retire_synchronize();
+    api_retire_destructor();
+    api_retire_deleter();
+    api_retire_batch();
+    api_reclaim();
+    api_pin();
+    api_pin_nested();
+    api_pin_move();
+}
+
+} // namespace epoch_suite
+
+//-----------------------------------------------------------------------------
+
+namespace epoch_thread_suite
+{
+
+using namespace lean::v1;
+
+void synchronize_blocked_by_reader()
+{
+    epoch_domain domain;
+    auto object = new node(42);
+    std::atomic<bool> pinned{ false };
+    std::atomic<bool> released{ false };
+
+    std::thread reader(
+        [&] {
+            auto guard = domain.pin();
+            pinned = true;
+            for (int i = 0; i < 100; ++i)
+                std::this_thread::yield();
+            assert(object->value == 42);
+            released = true;
+        });
+
+    while (!pinned)
+        std::this_thread::yield();
+    domain.retire(object);
+    domain.synchronize();
+    assert(released);
+    assert(node::alive == 0);
+
+    reader.join();
+}
+
+void reader_writer_stress()
+{
+    constexpr int readers = 4;
+    constexpr int iterations = 10000;
+
+    epoch_domain domain(16);
+    std::atomic<node *> shared{ new node(0) };
+    std::atomic<bool> done{ false };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < readers; ++i)
+    {
+        threads.emplace_back(
+            [&] {
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    auto guard = domain.pin();
+                    auto current = shared.load(std::memory_order_acquire);
+                    assert(current->value >= 0);
+                }
+            });
+    }
+
+    for (int i = 1; i <= iterations; ++i)
+    {
+        auto old = shared.exchange(new node(i), std::memory_order_acq_rel);
+        domain.retire(old);
+    }
+    done = true;
+    for (auto& thread : threads)
+        thread.join();
+
+    domain.synchronize();
+    assert(node::alive == 1);
+    delete shared.load();
+}
+
+void run()
+{
+    synchronize_blocked_by_reader();
+    reader_writer_stress();
+}
+
+} // namespace epoch_thread_suite
+
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    epoch_suite::run();
+    epoch_thread_suite::run();
+    return 0;
+}
+
+#else
+
+int main () { return 0; }
+
+#endif
@@ -0,0 +1,422 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "test_assert.hpp"
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <lean/expected.hpp>
+
+//-----------------------------------------------------------------------------
+
+struct counted
+{
+    counted() { ++constructed; }
+    counted(const counted&) { ++constructed; }
+    counted(counted&&) { ++constructed; }
+    counted& operator=(const counted&) = default;
+    counted& operator=(counted&&) = default;
+    ~counted() { ++destroyed; }
+
+    static int constructed;
+    static int destroyed;
+};
+
+int counted::constructed = 0;
+int counted::destroyed = 0;
+
+// Copy and move throw when failing is set, unless Nothrow
+template <bool Nothrow>
+struct tracked
+{
+    explicit tracked(int value = 0) : value(value) { ++constructed; }
+    tracked(const tracked& other) : value(other.value) { check(); ++constructed; }
+    tracked(tracked&& other) noexcept(Nothrow) : value(other.value) { check(); ++constructed; }
+    tracked& operator=(const tracked&) = default;
+    tracked& operator=(tracked&&) = default;
+    ~tracked() { ++destroyed; }
+
+    void check() const
+    {
+        if (!Nothrow && failing)
+            throw std::runtime_error("tracked");
+    }
+
+    int value;
+
+    static bool failing;
+    static int constructed;
+    static int destroyed;
+};
+
+template <bool Nothrow> bool tracked<Nothrow>::failing = false;
+template <bool Nothrow> int tracked<Nothrow>::constructed = 0;
+template <bool Nothrow> int tracked<Nothrow>::destroyed = 0;
+
+using throwing = tracked<false>;
+using nothrowing = tracked<true>;
+
+//-----------------------------------------------------------------------------
+
+namespace expected_traits_suite
+{
+
+using namespace lean::v1;
+
+static_assert(sizeof(expected<int, int>) == 2 * sizeof(int), "");
+static_assert(sizeof(expected<char, double>) == 2 * sizeof(double), "");
+
+// Triviality propagation
+static_assert(std::is_trivially_copyable<expected<int, std::errc>>::value, "");
+static_assert(std::is_trivially_destructible<expected<int, std::errc>>::value, "");
+static_assert(std::is_trivially_copyable<expected<void, std::errc>>::value, "");
+static_assert(!std::is_trivially_copyable<expected<std::string, int>>::value, "");
+static_assert(!std::is_trivially_destructible<expected<int, std::string>>::value, "");
+
+static_assert(lean::is_trivially_relocatable<expected<int, std::errc>>::value, "");
+static_assert(lean::is_trivially_relocatable<expected<std::unique_ptr<int>, int>>::value, "");
+static_assert(!lean::is_trivially_relocatable<expected<counted, int>>::value, "");
+
+// Copy and move propagation
+static_assert(std::is_copy_constructible<expected<std::string, int>>::value, "");
+static_assert(!std::is_copy_constructible<expected<std::unique_ptr<int>, int>>::value, "");
+static_assert(std::is_move_constructible<expected<std::unique_ptr<int>, int>>::value, "");
+static_assert(std::is_move_assignable<expected<std::unique_ptr<int>, int>>::value, "");
+
+} // namespace expected_traits_suite
+
+//-----------------------------------------------------------------------------
+
+namespace expected_suite
+{
+
+using namespace lean::v1;
+
+expected<int, std::errc> parse_digit(char input)
+{
+    if (input < '0' || input > '9')
+        return make_unexpected(std::errc::invalid_argument);
+    return input - '0';
+}
+
+void api_ctor_default()
+{
+    expected<int, std::errc> data;
+    assert(data);
+    assert(data.has_value());
+    assert(*data == 0);
+}
+
+void api_ctor_value()
+{
+    expected<std::string, int> data("alpha");
+    assert(data.has_value());
+    assert(*data == "alpha");
+    assert(data->size() == 5);
+    assert(data.value() == "alpha");
+}
+
+void api_ctor_error()
+{
+    expected<std::string, int> data(make_unexpected(42));
+    assert(!data);
+    assert(data.error() == 42);
+    assert(data == make_unexpected(42));
+}
+
+void api_ctor_inplace()
+{
+    expected<std::string, int> value(lean::in_place, 3, 'x');
+    assert(*value == "xxx");
+
+    expected<int, std::string> error(unexpect, 3, 'x');
+    assert(error.error() == "xxx");
+}
+
+void api_ctor_copy()
+{
+    expected<std::string, std::string> value("alpha");
+    auto value_copy = value;
+    assert(*value_copy == "alpha");
+
+    expected<std::string, std::string> error(make_unexpected(std::string("bravo")));
+    auto error_copy = error;
+    assert(error_copy.error() == "bravo");
+}
+
+void api_ctor_move()
+{
+    expected<std::unique_ptr<int>, int> data(std::unique_ptr<int>(new int(42)));
+    auto copy = std::move(data);
+    assert(**copy == 42);
+}
+
+void api_assign()
+{
+    expected<std::string, int> data;
+    data = "alpha";
+    assert(*data == "alpha");
+    data = make_unexpected(42);
+    assert(data.error() == 42);
+    data = make_unexpected(43);
+    assert(data.error() == 43);
+    data = std::string("bravo");
+    assert(*data == "bravo");
+
+    expected<std::string, int> error(make_unexpected(44));
+    data = error;
+    assert(data.error() == 44);
+    data = expected<std::string, int>("charlie");
+    assert(*data == "charlie");
+}
+
+void api_value()
+{
+    expected<int, std::errc> data = parse_digit('x');
+    assert_throw_with(data.value(), bad_expected_access<std::errc>);
+    try
+    {
+        data.value();
+    }
+    catch (const bad_expected_access<std::errc>& ex)
+    {
+        assert(ex.error() == std::errc::invalid_argument);
+    }
+    assert(parse_digit('7').value() == 7);
+}
+
+void api_value_or()
+{
+    assert(parse_digit('7').value_or(-1) == 7);
+    assert(parse_digit('x').value_or(-1) == -1);
+}
+
+void api_void()
+{
+    expected<void, int> data;
+    assert(data);
+    assert_nothrow(data.value());
+    data = make_unexpected(42);
+    assert(!data);
+    assert(data.error() == 42);
+    assert_throw_with(data.value(), bad_expected_access<int>);
+}
+
+void api_swap()
+{
+    expected<std::string, int> alpha("alpha");
+    expected<std::string, int> bravo(make_unexpected(42));
+    alpha.swap(bravo);
+    assert(alpha.error() == 42);
+    assert(*bravo == "alpha");
+}
+
+void api_compare()
+{
+    expected<int, int> alpha(1);
+    expected<int, int> bravo(1);
+    expected<int, int> charlie(make_unexpected(1));
+    assert(alpha == bravo);
+    assert(alpha != charlie);
+    assert(charlie == make_unexpected(1));
+    assert(charlie != make_unexpected(2));
+}
+
+void api_lifetime()
+{
+    counted::constructed = 0;
+    counted::destroyed = 0;
+    {
+        expected<counted, int> data;
+        assert(counted::constructed == 1);
+        auto copy = data;
+        assert(counted::constructed == 2);
+        data = make_unexpected(42);
+        assert(counted::destroyed == 1);
+        data = copy;
+        assert(counted::constructed == 3);
+    }
+    assert(counted::constructed == counted::destroyed);
+}
+
+void api_assign_throwing_value()
+{
+    throwing::constructed = throwing::destroyed = 0;
+    nothrowing::constructed = nothrowing::destroyed = 0;
+    {
+        expected<throwing, nothrowing> data(unexpect, 1);
+        const expected<throwing, nothrowing> copy(lean::in_place, 2);
+        expected<throwing, nothrowing> other(lean::in_place, 3);
+
+        // Error is kept if the value cannot be constructed
+        throwing::failing = true;
+        assert_throw(data = copy);
+        assert(!data.has_value());
+        assert(data.error().value == 1);
+        assert_throw(data = std::move(other));
+        assert(!data.has_value());
+        assert(data.error().value == 1);
+        throwing::failing = false;
+        assert(nothrowing::constructed == nothrowing::destroyed + 1);
+
+        data = copy;
+        assert(data.has_value());
+        assert(data->value == 2);
+        assert(nothrowing::constructed == nothrowing::destroyed);
+    }
+    assert(throwing::constructed == throwing::destroyed);
+    assert(nothrowing::constructed == nothrowing::destroyed);
+}
+
+void api_assign_throwing_error()
+{
+    throwing::constructed = throwing::destroyed = 0;
+    nothrowing::constructed = nothrowing::destroyed = 0;
+    {
+        expected<nothrowing, throwing> data(lean::in_place, 1);
+        const expected<nothrowing, throwing> copy(unexpect, 2);
+
+        // Value is kept if the error cannot be constructed
+        throwing::failing = true;
+        assert_throw(data = copy);
+        assert(data.has_value());
+        assert(data->value == 1);
+        throwing::failing = false;
+        assert(nothrowing::constructed == nothrowing::destroyed + 1);
+
+        data = copy;
+        assert(!data.has_value());
+        assert(data.error().value == 2);
+        assert(nothrowing::constructed == nothrowing::destroyed);
+    }
+    assert(throwing::constructed == throwing::destroyed);
+    assert(nothrowing::constructed == nothrowing::destroyed);
+}
+
+void run()
+{
+    api_ctor_default();
+    api_ctor_value();
+    api_ctor_error();
+    api_ctor_inplace();
+    api_ctor_copy();
+    api_ctor_move();
+    api_assign();
+    api_value();
+    api_value_or();
+    api_void();
+    api_swap();
+    api_compare();
+    api_lifetime();
+    api_assign_throwing_value();
+    api_assign_throwing_error();
+}
+
+} // namespace expected_suite
+
+//-----------------------------------------------------------------------------
+
+namespace try_invoke_suite
+{
+
+using namespace lean::v1;
+
+int parse(const std::string& input)
+{
+    return std::stoi(input);
+}
+
+struct parser
+{
+    int base;
+
+    int parse(const std::string& input) const
+    {
+        return base + std::stoi(input);
+    }
+};
+
+void invoke_value()
+{
+    auto result = try_invoke(parse, "42");
+    static_assert(std::is_same<decltype(result), expected<int, std::exception_ptr>>::value, "");
+    assert(result.has_value());
+    assert(*result == 42);
+}
+
+void invoke_exception()
+{
+    auto result = try_invoke(parse, "alpha");
+    assert(!result.has_value());
+    assert_throw_with(std::rethrow_exception(result.error()), std::invalid_argument);
+}
+
+void invoke_member()
+{
+    parser self{ 100 };
+    auto result = try_invoke(&parser::parse, self, "42");
+    assert(*result == 142);
+}
+
+void invoke_void()
+{
+    auto result = try_invoke([] { throw std::runtime_error("alpha"); });
+    static_assert(std::is_same<decltype(result), expected<void, std::exception_ptr>>::value, "");
+    assert(!result);
+
+    auto success = try_invoke([] {});
+    assert(success);
+}
+
+void invoke_lvalue_reference()
+{
+    int value = 42;
+    auto result = try_invoke([&value] () -> int& { return value; });
+    static_assert(std::is_same<decltype(result), expected<std::reference_wrapper<int>, std::exception_ptr>>::value, "");
+    assert(result.has_value());
+    assert(&result->get() == &value);
+    result->get() = 43;
+    assert(value == 43);
+
+    auto failure = try_invoke([] () -> const int& { throw std::runtime_error("alpha"); });
+    static_assert(std::is_same<decltype(failure), expected<std::reference_wrapper<const int>, std::exception_ptr>>::value, "");
+    assert(!failure);
+}
+
+void invoke_rvalue_reference()
+{
+    std::string value = "alpha";
+    auto result = try_invoke([&value] () -> std::string&& { return std::move(value); });
+    static_assert(std::is_same<decltype(result), expected<std::string, std::exception_ptr>>::value, "");
+    assert(*result == "alpha");
+}
+
+void run()
+{
+    invoke_value();
+    invoke_exception();
+    invoke_member();
+    invoke_void();
+    invoke_lvalue_reference();
+    invoke_rvalue_reference();
+}
+
+} // namespace try_invoke_suite
+
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    expected_suite::run();
+    try_invoke_suite::run();
+    return 0;
+}
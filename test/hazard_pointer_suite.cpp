@@ -0,0 +1,374 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "test_assert.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <lean/atomic.hpp>
+#include <lean/epoch.hpp>
+#include <lean/hazard_pointer.hpp>
+
+//-----------------------------------------------------------------------------
+
+struct node
+{
+    node(int value) : value(value) { ++alive; }
+    ~node() { value = -1; --alive; }
+
+    int value;
+
+    static std::atomic<int> alive;
+};
+
+std::atomic<int> node::alive{ 0 };
+
+//-----------------------------------------------------------------------------
+
+namespace hazard_pointer_suite
+{
+
+using namespace lean::v1;
+
+void api_retire_reclaim()
+{
+    hazard_pointer_domain domain;
+    domain.retire(new node(1));
+    domain.retire(new node(2));
+    assert(node::alive == 2);
+    assert(domain.reclaim() == 2);
+    assert(node::alive == 0);
+}
+
+void api_retire_destructor()
+{
+    {
+        hazard_pointer_domain domain;
+        domain.retire(new node(1));
+        assert(node::alive == 1);
+    }
+    assert(node::alive == 0);
+}
+
+void api_retire_deleter()
+{
+    static int deleted = 0;
+    int value = 0;
+    hazard_pointer_domain domain;
+    domain.retire(&value, [] (void *) { ++deleted; });
+    domain.reclaim();
+    assert(deleted == 1);
+}
+
+void api_retire_batch()
+{
+    // Threshold is the batch size plus the slots of each thread
+    constexpr int threshold = 4 + hazard_pointer_domain::slot_count;
+    hazard_pointer_domain domain(4);
+    for (int i = 0; i < threshold - 1; ++i)
+    {
+        domain.retire(new node(i));
+    }
+    assert(node::alive == threshold - 1);
+    domain.retire(new node(threshold));
+    assert(node::alive == 0);
+}
+
+void api_retire_batch_threads()
+{
+    // Another thread adds its slots to the threshold
+    constexpr int threshold = 4 + 2 * hazard_pointer_domain::slot_count;
+    hazard_pointer_domain domain(4);
+    // Register the calling thread first so the other thread gets its own record
+    domain.reclaim();
+    std::thread([&domain] { domain.make_hazard_pointer(); }).join();
+    for (int i = 0; i < threshold - 1; ++i)
+    {
+        domain.retire(new node(i));
+    }
+    assert(node::alive == threshold - 1);
+    domain.retire(new node(threshold));
+    assert(node::alive == 0);
+}
+
+void api_protect()
+{
+    hazard_pointer_domain domain;
+    std::atomic<node *> shared{ new node(42) };
+    auto hazard = domain.make_hazard_pointer();
+    assert(!hazard.empty());
+    auto current = hazard.protect(shared);
+    assert(current == shared.load());
+
+    shared.store(new node(43));
+    domain.retire(current);
+    assert(domain.reclaim() == 0);
+    assert(current->value == 42);
+
+    hazard.reset_protection();
+    assert(domain.reclaim() == 1);
+    delete shared.load();
+}
+
+void api_protect_atomic()
+{
+    hazard_pointer_domain domain;
+    lean::atomic<node *> shared{ new node(42) };
+    auto hazard = domain.make_hazard_pointer();
+    auto current = hazard.protect(shared);
+    assert(current->value == 42);
+    hazard.reset_protection();
+    delete current;
+}
+
+void api_try_protect()
+{
+    hazard_pointer_domain domain;
+    node *first = new node(1);
+    node *second = new node(2);
+    std::atomic<node *> shared{ first };
+    auto hazard = domain.make_hazard_pointer();
+
+    node *current = first;
+    assert(hazard.try_protect(current, shared));
+    assert(current == first);
+
+    shared.store(second);
+    current = first;
+    assert(!hazard.try_protect(current, shared));
+    assert(current == second);
+
+    delete first;
+    delete second;
+}
+
+void api_move()
+{
+    hazard_pointer_domain domain;
+    auto object = new node(42);
+    std::atomic<node *> shared{ object };
+    {
+        auto hazard = domain.make_hazard_pointer();
+        hazard.protect(shared);
+        auto other = std::move(hazard);
+        assert(hazard.empty());
+        domain.retire(object);
+        assert(domain.reclaim() == 0);
+    }
+    assert(domain.reclaim() == 1);
+}
+
+void api_slots_exhausted()
+{
+    hazard_pointer_domain domain;
+    std::vector<hazard_pointer_domain::hazard_pointer> hazards;
+    for (std::size_t i = 0; i < hazard_pointer_domain::slot_count; ++i)
+    {
+        hazards.push_back(domain.make_hazard_pointer());
+    }
+    assert_throw_with(domain.make_hazard_pointer(), std::length_error);
+    hazards.pop_back();
+    assert_nothrow(domain.make_hazard_pointer());
+}
+
+void run()
+{
+    api_retire_reclaim();
+    api_retire_destructor();
+    api_retire_deleter();
+    api_retire_batch();
+    api_retire_batch_threads();
+    api_protect();
+    api_protect_atomic();
+    api_try_protect();
+    api_move();
+    api_slots_exhausted();
+}
+
+} // namespace hazard_pointer_suite
+
+//-----------------------------------------------------------------------------
+
+namespace hazard_pointer_thread_suite
+{
+
+using namespace lean::v1;
+
+void reader_writer_stress()
+{
+    constexpr int readers = 4;
+    constexpr int iterations = 10000;
+
+    hazard_pointer_domain domain(16);
+    std::atomic<node *> shared{ new node(0) };
+    std::atomic<bool> done{ false };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < readers; ++i)
+    {
+        threads.emplace_back(
+            [&] {
+                auto hazard = domain.make_hazard_pointer();
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    auto current = hazard.protect(shared);
+                    assert(current->value >= 0);
+                    hazard.reset_protection();
+                }
+            });
+    }
+
+    for (int i = 1; i <= iterations; ++i)
+    {
+        auto old = shared.exchange(new node(i), std::memory_order_acq_rel);
+        domain.retire(old);
+    }
+    done = true;
+    for (auto& thread : threads)
+        thread.join();
+
+    domain.reclaim();
+    assert(node::alive == 1);
+    delete shared.load();
+}
+
+void domain_destroyed_before_thread_exit()
+{
+    // The thread keeps a registry entry for the destroyed domain
+    std::atomic<int> step{ 0 };
+    auto domain = new hazard_pointer_domain;
+    std::thread thread(
+        [&] {
+            {
+                auto hazard = domain->make_hazard_pointer();
+            }
+            step = 1;
+            while (step.load() != 2)
+                std::this_thread::yield();
+            // Possibly at the address of the destroyed domain
+            hazard_pointer_domain other;
+            auto hazard = other.make_hazard_pointer();
+            assert(!hazard.empty());
+        });
+    while (step.load() != 1)
+        std::this_thread::yield();
+    delete domain;
+    step = 2;
+    thread.join();
+}
+
+void run()
+{
+    reader_writer_stress();
+    domain_destroyed_before_thread_exit();
+}
+
+} // namespace hazard_pointer_thread_suite
+
+//-----------------------------------------------------------------------------
+
+namespace stalled_reader_suite
+{
+
+using namespace lean::v1;
+
+constexpr int batch_size = 16;
+constexpr int iterations = 1000;
+
+// The stalled reader holds on to the first object and never releases it
+// while the writer replaces and retires objects.
+
+template <typename Domain, typename Reader>
+int unreclaimed_objects(Domain& domain, Reader reader)
+{
+    std::atomic<node *> shared{ new node(0) };
+    std::atomic<bool> stalled{ false };
+    std::atomic<bool> done{ false };
+
+    std::thread thread(
+        [&] {
+            reader(domain, shared, stalled, done);
+        });
+    while (!stalled)
+        std::this_thread::yield();
+
+    for (int i = 1; i <= iterations; ++i)
+    {
+        domain.retire(shared.exchange(new node(i)));
+    }
+    domain.reclaim();
+    const int result = node::alive - 1;
+
+    done = true;
+    thread.join();
+    domain.reclaim();
+    delete shared.load();
+    return result;
+}
+
+void stalled_hazard_pointer()
+{
+    hazard_pointer_domain domain(batch_size);
+    auto unreclaimed = unreclaimed_objects(
+        domain,
+        [] (hazard_pointer_domain& domain,
+            std::atomic<node *>& shared,
+            std::atomic<bool>& stalled,
+            std::atomic<bool>& done) {
+            auto hazard = domain.make_hazard_pointer();
+            hazard.protect(shared);
+            stalled = true;
+            while (!done)
+                std::this_thread::yield();
+        });
+    // Only the protected object is kept
+    assert(unreclaimed == 1);
+    assert(node::alive == 0);
+}
+
+void stalled_epoch()
+{
+#if LEAN_CXX >= LEAN_LIB_ATOMIC_WAIT
+    epoch_domain domain(batch_size);
+    auto unreclaimed = unreclaimed_objects(
+        domain,
+        [] (epoch_domain& domain,
+            std::atomic<node *>&,
+            std::atomic<bool>& stalled,
+            std::atomic<bool>& done) {
+            auto guard = domain.pin();
+            stalled = true;
+            while (!done)
+                std::this_thread::yield();
+        });
+    // All retired objects are kept
+    assert(unreclaimed == iterations);
+    domain.synchronize();
+    assert(node::alive == 0);
+#endif
+}
+
+void run()
+{
+    stalled_hazard_pointer();
+    stalled_epoch();
+}
+
+} // namespace stalled_reader_suite
+
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    hazard_pointer_suite::run();
+    hazard_pointer_thread_suite::run();
+    stalled_reader_suite::run();
+    return 0;
+}
@@ -0,0 +1,227 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "test_assert.hpp"
+#include <thread>
+#include <vector>
+#include <lean/intrusive_ptr.hpp>
+
+//-----------------------------------------------------------------------------
+
+template <typename Policy>
+struct counted : lean::ref_counted<counted<Policy>, Policy>
+{
+    using base = lean::ref_counted<counted<Policy>, Policy>;
+
+    counted(int value = 0) : value(value) { ++alive; }
+    counted(const counted& other) : base(other), value(other.value) { ++alive; }
+    counted& operator=(const counted&) = default;
+    virtual ~counted() { --alive; }
+
+    int value;
+
+    static int alive;
+};
+
+template <typename Policy>
+int counted<Policy>::alive = 0;
+
+using shared_type = counted<lean::thread_safe>;
+using local_type = counted<lean::thread_unsafe>;
+
+struct derived : shared_type
+{
+    derived(int value) : shared_type(value) {}
+};
+
+//-----------------------------------------------------------------------------
+
+namespace intrusive_ptr_suite
+{
+
+using namespace lean::v1;
+
+static_assert(sizeof(intrusive_ptr<shared_type>) == sizeof(void *), "");
+static_assert(std::is_nothrow_copy_constructible<intrusive_ptr<shared_type>>::value, "");
+static_assert(std::is_nothrow_move_constructible<intrusive_ptr<shared_type>>::value, "");
+static_assert(std::is_convertible<intrusive_ptr<derived>, intrusive_ptr<shared_type>>::value, "");
+static_assert(!std::is_convertible<intrusive_ptr<shared_type>, intrusive_ptr<derived>>::value, "");
+static_assert(lean::is_trivially_relocatable<intrusive_ptr<shared_type>>::value, "");
+
+void api_ctor_default()
+{
+    intrusive_ptr<shared_type> data;
+    assert(!data);
+    assert(data == nullptr);
+    assert(data.get() == nullptr);
+}
+
+void api_ctor_pointer()
+{
+    {
+        intrusive_ptr<shared_type> data(new shared_type(42));
+        assert(data);
+        assert(data->value == 42);
+        assert((*data).value == 42);
+        assert(data->use_count() == 1);
+        assert(shared_type::alive == 1);
+    }
+    assert(shared_type::alive == 0);
+}
+
+void api_ctor_copy()
+{
+    auto data = make_intrusive<shared_type>(42);
+    {
+        auto copy = data;
+        assert(copy == data);
+        assert(data->use_count() == 2);
+    }
+    assert(data->use_count() == 1);
+}
+
+void api_ctor_move()
+{
+    auto data = make_intrusive<shared_type>(42);
+    auto copy = std::move(data);
+    assert(!data);
+    assert(copy->use_count() == 1);
+}
+
+void api_ctor_convert()
+{
+    {
+        intrusive_ptr<shared_type> data = make_intrusive<derived>(42);
+        assert(data->value == 42);
+        assert(data->use_count() == 1);
+    }
+    assert(shared_type::alive == 0);
+}
+
+void api_assign()
+{
+    auto alpha = make_intrusive<shared_type>(1);
+    auto bravo = make_intrusive<shared_type>(2);
+    alpha = bravo;
+    assert(shared_type::alive == 1);
+    assert(alpha->use_count() == 2);
+    alpha = alpha;
+    assert(alpha->use_count() == 2);
+    bravo = nullptr;
+    assert(alpha->use_count() == 1);
+    alpha = make_intrusive<derived>(3);
+    assert(alpha->value == 3);
+    assert(shared_type::alive == 1);
+}
+
+void api_reset()
+{
+    auto data = make_intrusive<shared_type>(42);
+    data.reset(new shared_type(43));
+    assert(data->value == 43);
+    assert(shared_type::alive == 1);
+    data.reset();
+    assert(!data);
+    assert(shared_type::alive == 0);
+}
+
+void api_detach()
+{
+    auto data = make_intrusive<shared_type>(42);
+    auto raw = data.detach();
+    assert(!data);
+    assert(raw->use_count() == 1);
+    intrusive_ptr<shared_type> adopted(raw, false);
+    assert(adopted->use_count() == 1);
+}
+
+void api_copy_object()
+{
+    auto data = make_intrusive<shared_type>(42);
+    auto copy = make_intrusive<shared_type>(*data);
+    assert(copy->use_count() == 1);
+    *copy = *data;
+    assert(copy->use_count() == 1);
+    assert(data->use_count() == 1);
+}
+
+void api_thread_unsafe()
+{
+    {
+        auto data = make_intrusive<local_type>(42);
+        auto copy = data;
+        assert(data->use_count() == 2);
+    }
+    assert(local_type::alive == 0);
+}
+
+void run()
+{
+    api_ctor_default();
+    api_ctor_pointer();
+    api_ctor_copy();
+    api_ctor_move();
+    api_ctor_convert();
+    api_assign();
+    api_reset();
+    api_detach();
+    api_copy_object();
+    api_thread_unsafe();
+}
+
+} // namespace intrusive_ptr_suite
+
+//-----------------------------------------------------------------------------
+
+namespace intrusive_ptr_thread_suite
+{
+
+using namespace lean::v1;
+
+void copy_destroy_stress()
+{
+    constexpr int threads = 4;
+    constexpr int iterations = 10000;
+
+    auto data = make_intrusive<shared_type>(42);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i)
+    {
+        workers.emplace_back(
+            [data] {
+                for (int j = 0; j < iterations; ++j)
+                {
+                    auto copy = data;
+                    assert(copy->value == 42);
+                }
+            });
+    }
+    for (auto& worker : workers)
+        worker.join();
+    assert(data->use_count() == 1);
+    data.reset();
+    assert(shared_type::alive == 0);
+}
+
+void run()
+{
+    copy_destroy_stress();
+}
+
+} // namespace intrusive_ptr_thread_suite
+
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    intrusive_ptr_suite::run();
+    intrusive_ptr_thread_suite::run();
+    return 0;
+}
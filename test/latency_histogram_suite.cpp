@@ -0,0 +1,289 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "test_assert.hpp"
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+#include <lean/latency_histogram.hpp>
+
+//-----------------------------------------------------------------------------
+
+namespace bucket_suite
+{
+
+void bucket_exact()
+{
+    // Small values have their own bucket
+    for (std::uint64_t value = 0; value < 2 * lean::latency_histogram::sub_bucket_count; ++value)
+    {
+        auto index = lean::latency_histogram::bucket_index(value);
+        assert(index == value);
+        assert(lean::latency_histogram::bucket_lower(index) == value);
+        assert(lean::latency_histogram::bucket_upper(index) == value);
+    }
+}
+
+void bucket_contains()
+{
+    const std::uint64_t values[] = {
+        32, 33, 34, 35, 63, 64, 65, 100, 1000, 4095, 4096, 123456789,
+        std::uint64_t(1) << 40,
+        (std::uint64_t(1) << 40) - 1,
+        std::numeric_limits<std::uint64_t>::max()
+    };
+    for (auto value : values)
+    {
+        auto index = lean::latency_histogram::bucket_index(value);
+        assert(index < lean::latency_histogram::bucket_count);
+        auto lower = lean::latency_histogram::bucket_lower(index);
+        auto upper = lean::latency_histogram::bucket_upper(index);
+        assert(lower <= value);
+        assert(value <= upper);
+        // Relative error below 1/16
+        assert((upper - lower) <= lower / lean::latency_histogram::sub_bucket_count);
+    }
+    assert(lean::latency_histogram::bucket_index(std::numeric_limits<std::uint64_t>::max()) == lean::latency_histogram::bucket_count - 1);
+}
+
+void bucket_adjacent()
+{
+    // Buckets cover all values without gaps
+    for (std::size_t index = 1; index < lean::latency_histogram::bucket_count; ++index)
+    {
+        assert(lean::latency_histogram::bucket_lower(index) == lean::latency_histogram::bucket_upper(index - 1) + 1);
+    }
+}
+
+void run()
+{
+    bucket_exact();
+    bucket_contains();
+    bucket_adjacent();
+}
+
+} // namespace bucket_suite
+
+//-----------------------------------------------------------------------------
+
+namespace record_suite
+{
+
+void record_empty()
+{
+    lean::latency_histogram histogram;
+    assert(histogram.count() == 0);
+    assert(histogram.min() == 0);
+    assert(histogram.max() == 0);
+    assert(histogram.percentile(50.0) == 0);
+}
+
+void record_values()
+{
+    lean::latency_histogram histogram;
+    for (std::uint64_t value = 1; value <= 10; ++value)
+        histogram.record(value);
+    assert(histogram.count() == 10);
+    assert(histogram.min() == 1);
+    assert(histogram.max() == 10);
+    assert(histogram.percentile(0.0) == 1);
+    assert(histogram.percentile(10.0) == 1);
+    assert(histogram.percentile(50.0) == 5);
+    assert(histogram.percentile(90.0) == 9);
+    assert(histogram.percentile(99.0) == 10);
+    assert(histogram.percentile(100.0) == 10);
+}
+
+void record_count()
+{
+    lean::latency_histogram histogram;
+    histogram.record(1000, 99);
+    histogram.record(1000000);
+    assert(histogram.count() == 100);
+    auto p50 = histogram.percentile(50.0);
+    assert(p50 >= 1000);
+    assert(p50 < 1000 + 1000 / 16);
+    assert(histogram.percentile(99.0) == p50);
+    assert(histogram.percentile(99.9) >= 1000000);
+}
+
+void record_duration()
+{
+    lean::latency_histogram histogram;
+    histogram.record(std::chrono::microseconds(2));
+    histogram.record(std::chrono::nanoseconds(-5));
+    assert(histogram.count() == 2);
+    assert(histogram.min() == 0);
+    assert(histogram.max() >= 2000);
+}
+
+void record_reset()
+{
+    lean::latency_histogram histogram;
+    histogram.record(42);
+    histogram.reset();
+    assert(histogram.count() == 0);
+}
+
+void threaded_record()
+{
+    constexpr unsigned int thread_count = 4;
+    constexpr std::uint64_t count = 10000;
+    lean::latency_histogram histogram;
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back(
+            [&histogram] {
+                for (std::uint64_t value = 0; value < count; ++value)
+                    histogram.record(value);
+            });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    assert(histogram.count() == thread_count * count);
+}
+
+void run()
+{
+    record_empty();
+    record_values();
+    record_count();
+    record_duration();
+    record_reset();
+    threaded_record();
+}
+
+} // namespace record_suite
+
+//-----------------------------------------------------------------------------
+
+namespace merge_suite
+{
+
+void merge_histograms()
+{
+    lean::latency_histogram first;
+    lean::latency_histogram second;
+    first.record(1);
+    first.record(100);
+    second.record(100);
+    second.record(10000);
+
+    first.merge(second);
+    assert(first.count() == 4);
+    assert(first.min() == 1);
+    assert(first.max() >= 10000);
+    assert(second.count() == 2);
+}
+
+void copy_histogram()
+{
+    lean::latency_histogram histogram;
+    histogram.record(7);
+    lean::latency_histogram copy(histogram);
+    histogram.record(8);
+    assert(copy.count() == 1);
+    copy = histogram;
+    assert(copy.count() == 2);
+}
+
+void run()
+{
+    merge_histograms();
+    copy_histogram();
+}
+
+} // namespace merge_suite
+
+//-----------------------------------------------------------------------------
+
+namespace serialize_suite
+{
+
+void serialize_empty()
+{
+    lean::latency_histogram histogram;
+    auto data = histogram.serialize();
+    assert(data.size() == 2);
+
+    lean::latency_histogram other;
+    other.record(1);
+    assert(other.deserialize(data.data(), data.size()));
+    assert(other.count() == 0);
+}
+
+void serialize_roundtrip()
+{
+    lean::latency_histogram histogram;
+    histogram.record(0);
+    histogram.record(3, 2);
+    histogram.record(1000, 300);
+    histogram.record(std::numeric_limits<std::uint64_t>::max());
+    auto data = histogram.serialize();
+    // Version, precision, and gap and count for four buckets
+    assert(data.size() == 2 + 2 + 2 + 3 + 3);
+
+    lean::latency_histogram other;
+    assert(other.deserialize(data.data(), data.size()));
+    assert(other.count() == histogram.count());
+    assert(other.min() == 0);
+    assert(other.max() == std::numeric_limits<std::uint64_t>::max());
+    assert(other.percentile(50.0) == histogram.percentile(50.0));
+    assert(other.serialize() == data);
+}
+
+void deserialize_invalid()
+{
+    lean::latency_histogram histogram;
+    histogram.record(5);
+    auto data = histogram.serialize();
+
+    lean::latency_histogram other;
+    assert(!other.deserialize(data.data(), 1));
+
+    auto wrong_version = data;
+    wrong_version[0] = 0;
+    assert(!other.deserialize(wrong_version.data(), wrong_version.size()));
+
+    auto truncated = data;
+    truncated.pop_back();
+    assert(!other.deserialize(truncated.data(), truncated.size()));
+
+    // Bucket index beyond the last bucket
+    std::vector<std::uint8_t> overflow = { data[0], data[1], 0xFF, 0x7F, 0x01 };
+    other.record(1);
+    assert(!other.deserialize(overflow.data(), overflow.size()));
+    assert(other.count() == 0);
+}
+
+void run()
+{
+    serialize_empty();
+    serialize_roundtrip();
+    deserialize_invalid();
+}
+
+} // namespace serialize_suite
+
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    bucket_suite::run();
+    record_suite::run();
+    merge_suite::run();
+    serialize_suite::run();
+    return 0;
+}
@@ -9,7 +9,11 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "test_assert.hpp"
+#include "test_allocation.hpp"
+#include <stdexcept>
+#include <string>
 #include <lean/memory.hpp>
+#include <lean/new.hpp>
 
 //-----------------------------------------------------------------------------
 
@@ -118,6 +122,294 @@ void run()
 
 //-----------------------------------------------------------------------------
 
+namespace uninitialized_suite
+{
+
+using namespace lean::v1;
+
+struct counted
+{
+    counted() : value(-1) { ++alive; }
+    counted(int value) : value(value) { ++alive; }
+    counted(const counted& other) : value(other.value) { if (value < 0) throw value; ++alive; }
+    counted(counted&& other) : value(other.value) { other.value = 0; ++alive; }
+    ~counted() { --alive; }
+
+    int value;
+    static int alive;
+};
+
+int counted::alive = 0;
+
+struct throwing_default
+{
+    throwing_default() { if (++created == 3) throw created; ++alive; }
+    ~throwing_default() { --alive; }
+
+    static int created;
+    static int alive;
+};
+
+int throwing_default::created = 0;
+int throwing_default::alive = 0;
+
+void copy_int()
+{
+    const int source[] = { 1, 2, 3, 4 };
+    int target[4] = {};
+    assert(uninitialized_copy_n(source, 4, target) == target + 4);
+    assert(target[0] == 1);
+    assert(target[3] == 4);
+    assert(uninitialized_copy_n(source, 0, target) == target);
+}
+
+void copy_counted()
+{
+    counted::alive = 0;
+    {
+        counted source[] = { 1, 2, 3 };
+        inplace_storage<3 * sizeof(counted), alignof(counted)> target;
+        auto last = uninitialized_copy_n(&source[0], 3, target.data<counted>());
+        assert(last == target.data<counted>() + 3);
+        assert(counted::alive == 6);
+        assert(target.data<counted>()[2].value == 3);
+        destroy_n(target.data<counted>(), 3);
+        assert(counted::alive == 3);
+    }
+    assert(counted::alive == 0);
+}
+
+void copy_throw()
+{
+    counted::alive = 0;
+    {
+        counted source[] = { 1, 2, -3 };
+        inplace_storage<3 * sizeof(counted), alignof(counted)> target;
+        assert_throw(uninitialized_copy_n(&source[0], 3, target.data<counted>()));
+        assert(counted::alive == 3);
+    }
+    assert(counted::alive == 0);
+}
+
+void move_int()
+{
+    int source[] = { 1, 2, 3, 4 };
+    int target[4] = {};
+    assert(uninitialized_move_n(source, 4, target) == target + 4);
+    assert(target[0] == 1);
+    assert(target[3] == 4);
+}
+
+void move_counted()
+{
+    counted::alive = 0;
+    {
+        counted source[] = { 1, 2, 3 };
+        inplace_storage<3 * sizeof(counted), alignof(counted)> target;
+        auto last = uninitialized_move_n(&source[0], 3, target.data<counted>());
+        assert(last == target.data<counted>() + 3);
+        assert(counted::alive == 6);
+        assert(source[0].value == 0);
+        assert(target.data<counted>()[0].value == 1);
+        destroy_n(target.data<counted>(), 3);
+    }
+    assert(counted::alive == 0);
+}
+
+void value_construct_int()
+{
+    int target[4] = { 1, 2, 3, 4 };
+    assert(uninitialized_value_construct_n(target, 4) == target + 4);
+    assert(target[0] == 0);
+    assert(target[3] == 0);
+}
+
+void value_construct_pointer()
+{
+    int value = 42;
+    int *target[2] = { &value, &value };
+    uninitialized_value_construct_n(target, 2);
+    assert(target[0] == nullptr);
+    assert(target[1] == nullptr);
+}
+
+void value_construct_counted()
+{
+    counted::alive = 0;
+    inplace_storage<3 * sizeof(counted), alignof(counted)> target;
+    auto last = uninitialized_value_construct_n(target.data<counted>(), 3);
+    assert(last == target.data<counted>() + 3);
+    assert(counted::alive == 3);
+    assert(target.data<counted>()[1].value == -1);
+    assert(destroy_n(target.data<counted>(), 3) == last);
+    assert(counted::alive == 0);
+}
+
+void value_construct_throw()
+{
+    throwing_default::created = 0;
+    throwing_default::alive = 0;
+    inplace_storage<4 * sizeof(throwing_default), alignof(throwing_default)> target;
+    assert_throw(uninitialized_value_construct_n(target.data<throwing_default>(), 4));
+    assert(throwing_default::alive == 0);
+}
+
+void destroy_int()
+{
+    int target[4] = {};
+    assert(destroy_n(target, 4) == target + 4);
+}
+
+void run()
+{
+    copy_int();
+    copy_counted();
+    copy_throw();
+    move_int();
+    move_counted();
+    value_construct_int();
+    value_construct_pointer();
+    value_construct_counted();
+    value_construct_throw();
+    destroy_int();
+}
+
+} // namespace uninitialized_suite
+
+//-----------------------------------------------------------------------------
+
+namespace relocate_suite
+{
+
+using namespace lean::v1;
+
+struct tracked
+{
+    tracked(int value) : value(value) { ++alive; }
+    tracked(tracked&& other) : value(other.value) { other.value = -1; ++alive; }
+    ~tracked() { --alive; }
+
+    int value;
+    static int alive;
+};
+
+int tracked::alive = 0;
+
+struct throwing_move
+{
+    throwing_move(int value) : value(value) { ++alive; }
+    throwing_move(throwing_move&& other) : value(other.value) { if (value < 0) throw value; ++alive; }
+    ~throwing_move() { --alive; }
+
+    int value;
+    static int alive;
+};
+
+int throwing_move::alive = 0;
+
+static_assert(lean::is_trivially_relocatable<std::unique_ptr<int>>::value, "");
+static_assert(!lean::is_trivially_relocatable<tracked>::value, "");
+
+void relocate_int()
+{
+    int source = 42;
+    int target = 0;
+    assert(relocate_at(&source, &target) == &target);
+    assert(target == 42);
+}
+
+void relocate_unique_ptr()
+{
+    using type = std::unique_ptr<int>;
+    inplace_value<type> source;
+    inplace_value<type> target;
+    construct_at(source.data(), new int(42));
+    relocate_at(source.data(), target.data());
+    assert(**target.data() == 42);
+    destroy_at(target.data());
+}
+
+void relocate_tracked()
+{
+    tracked::alive = 0;
+    inplace_value<tracked> source;
+    inplace_value<tracked> target;
+    construct_at(source.data(), 42);
+    relocate_at(source.data(), target.data());
+    assert(target.data()->value == 42);
+    assert(tracked::alive == 1);
+    destroy_at(target.data());
+    assert(tracked::alive == 0);
+}
+
+void relocate_n_int()
+{
+    int source[] = { 1, 2, 3, 4 };
+    int target[4] = {};
+    assert(uninitialized_relocate_n(source, 4, target) == target + 4);
+    assert(target[0] == 1);
+    assert(target[3] == 4);
+}
+
+void relocate_n_overlap()
+{
+    // Erase first element by relocating the rest one position down
+    int data[] = { 1, 2, 3, 4 };
+    assert(uninitialized_relocate_n(data + 1, 3, data) == data + 3);
+    assert(data[0] == 2);
+    assert(data[1] == 3);
+    assert(data[2] == 4);
+}
+
+void relocate_n_tracked()
+{
+    tracked::alive = 0;
+    inplace_storage<4 * sizeof(tracked), alignof(tracked)> source;
+    inplace_storage<4 * sizeof(tracked), alignof(tracked)> target;
+    auto first = source.data<tracked>();
+    for (int i = 0; i < 4; ++i)
+        construct_at(first + i, i);
+    auto last = uninitialized_relocate_n(first, 4, target.data<tracked>());
+    assert(last == target.data<tracked>() + 4);
+    assert(tracked::alive == 4);
+    for (auto cursor = target.data<tracked>(); cursor != last; ++cursor)
+    {
+        assert(cursor->value == cursor - target.data<tracked>());
+        destroy_at(cursor);
+    }
+    assert(tracked::alive == 0);
+}
+
+void relocate_n_throw()
+{
+    throwing_move::alive = 0;
+    inplace_storage<4 * sizeof(throwing_move), alignof(throwing_move)> source;
+    inplace_storage<4 * sizeof(throwing_move), alignof(throwing_move)> target;
+    auto first = source.data<throwing_move>();
+    construct_at(first + 0, 0);
+    construct_at(first + 1, 1);
+    construct_at(first + 2, -1);
+    construct_at(first + 3, 3);
+    assert(throwing_move::alive == 4);
+    assert_throw(uninitialized_relocate_n(first, 4, target.data<throwing_move>()));
+    assert(throwing_move::alive == 0);
+}
+
+void run()
+{
+    relocate_int();
+    relocate_unique_ptr();
+    relocate_tracked();
+    relocate_n_int();
+    relocate_n_overlap();
+    relocate_n_tracked();
+    relocate_n_throw();
+}
+
+} // namespace relocate_suite
+
+//-----------------------------------------------------------------------------
+
 namespace inplace_storage_suite
 {
 
@@ -160,9 +452,48 @@ void api_construct()
     }
 }
 
+static_assert(noexcept(std::declval<inplace_storage<sizeof(int)>&>().at<int, unchecked>(0)), "");
+static_assert(!noexcept(std::declval<inplace_storage<sizeof(int)>&>().at<int, checked>(0)), "");
+static_assert(noexcept(std::declval<inplace_storage<sizeof(int)>&>().at<int>(0)) == !is_checked_policy<default_policy>::value, "");
+
+void api_at()
+{
+    inplace_storage<4 * sizeof(int), alignof(int)> storage;
+    for (std::size_t index = 0; index < 4; ++index)
+        storage.at<int, unchecked>(index) = int(index);
+    assert((storage.at<int, checked>(3) == 3));
+    assert(storage.at<int>(3) == 3);
+    assert(storage.data<int>()[2] == 2);
+    const auto& cstorage = storage;
+    assert((cstorage.at<int, checked>(1) == 1));
+    assert((cstorage.at<int, unchecked>(1) == 1));
+    assert_throw_with((storage.at<int, checked>(4)), \
+                      std::out_of_range);
+    assert_throw_with((cstorage.at<int, checked>(4)), \
+                      std::out_of_range);
+}
+
+void api_data_offset()
+{
+    inplace_storage<2 * sizeof(int), alignof(int)> storage;
+    *storage.data<int, unchecked>(sizeof(int)) = 42;
+    assert((*storage.data<int, checked>(sizeof(int)) == 42));
+    assert((storage.data<char, checked>(2 * sizeof(int) - 1) == reinterpret_cast<char *>(storage.data<int>()) + 2 * sizeof(int) - 1));
+    const auto& cstorage = storage;
+    assert((*cstorage.data<int, checked>(sizeof(int)) == 42));
+    assert_throw_with((storage.data<int, checked>(sizeof(int) + 1)), \
+                      std::out_of_range);
+    assert_throw_with((storage.data<int, checked>(1)), \
+                      std::invalid_argument);
+    assert_throw_with((cstorage.data<char, checked>(2 * sizeof(int))), \
+                      std::out_of_range);
+}
+
 void run()
 {
     api_construct();
+    api_at();
+    api_data_offset();
 }
 
 } // namespace inplace_storage_suite
@@ -296,6 +627,11 @@ static_assert(std::is_same<typename inplace_union<int>::value_type, int>(), "");
 static_assert(std::is_same<typename inplace_union<char, int>::value_type, int>(), "");
 static_assert(std::is_same<typename inplace_union<char, int, double>::value_type, double>(), "");
 
+struct alignas(1) bytes { char data[2 * sizeof(double)]; };
+
+static_assert(std::is_same<typename inplace_union<bytes, double>::value_type, bytes>(), "");
+static_assert(alignof(inplace_union<bytes, double>) == alignof(double), "");
+
 void api_construct_default()
 {
     {
@@ -322,6 +658,16 @@ void api_construct_default()
     }
 }
 
+void api_construct_aligned()
+{
+    {
+        inplace_union<bytes, double> storage;
+        construct_at(storage.data<double>(), 42.);
+        assert(*storage.data<double>() == 42.);
+        destroy_at(storage.data<double>());
+    }
+}
+
 void api_construct_value()
 {
     {
@@ -334,6 +680,7 @@ void api_construct_value()
 void run()
 {
     api_construct_default();
+    api_construct_aligned();
     api_construct_value();
 }
 
@@ -341,11 +688,169 @@ void run()
 
 //-----------------------------------------------------------------------------
 
+namespace cache_padded_suite
+{
+
+using namespace lean::v1;
+
+struct tracked
+{
+    tracked(int value) : value(value) { ++alive; }
+    ~tracked() { --alive; }
+
+    int value;
+    static int alive;
+};
+
+int tracked::alive = 0;
+
+static_assert(alignof(cache_padded<char>) == hardware_destructive_interference_size, "");
+static_assert(sizeof(cache_padded<char>) == hardware_destructive_interference_size, "");
+static_assert(sizeof(cache_padded<char[hardware_destructive_interference_size + 1]>) == 2 * hardware_destructive_interference_size, "");
+static_assert(!std::is_copy_constructible<cache_padded<int>>(), "not copyable");
+static_assert(!std::is_move_constructible<cache_padded<int>>(), "not movable");
+
+void api_construct()
+{
+    {
+        cache_padded<int> value;
+        assert(*value == 0);
+    }
+    {
+        cache_padded<int> value(42);
+        assert(value.get() == 42);
+        *value = 43;
+        assert(value.get() == 43);
+    }
+    {
+        const cache_padded<const int> value(42);
+        assert(*value == 42);
+    }
+}
+
+void api_lifetime()
+{
+    tracked::alive = 0;
+    {
+        cache_padded<tracked> value(42);
+        assert(value->value == 42);
+        assert(tracked::alive == 1);
+    }
+    assert(tracked::alive == 0);
+}
+
+void api_array()
+{
+    cache_padded<int> values[4];
+    for (int i = 0; i < 4; ++i)
+        *values[i] = i;
+    auto distance = reinterpret_cast<const char *>(&values[1].get()) - reinterpret_cast<const char *>(&values[0].get());
+    assert(std::size_t(distance) == hardware_destructive_interference_size);
+    assert(*values[3] == 3);
+}
+
+void run()
+{
+    api_construct();
+    api_lifetime();
+    api_array();
+}
+
+} // namespace cache_padded_suite
+
+//-----------------------------------------------------------------------------
+
+namespace allocation_suite
+{
+
+using namespace lean::v1;
+
+struct alignas(64) overaligned
+{
+    int value;
+};
+
+void inplace_no_allocations()
+{
+    expect_no_allocations
+    {
+        inplace_storage<4 * sizeof(int), alignof(int)> storage;
+        storage.at<int, checked>(3) = 42;
+        assert((*storage.data<int, checked>(3 * sizeof(int)) == 42));
+
+        inplace_value<int> value(42);
+        destroy_at(value.data());
+
+        inplace_union<char, int, double> alternatives;
+        construct_at(alternatives.data<double>(), 1.0);
+        destroy_at(alternatives.data<double>());
+
+        cache_padded<int> padded;
+        *padded = 42;
+    }
+}
+
+void uninitialized_no_allocations()
+{
+    expect_no_allocations
+    {
+        const int source[4] = { 1, 2, 3, 4 };
+        inplace_value<int[4]> target;
+        uninitialized_copy_n(source, 4, *target.data());
+        assert((*target.data())[3] == 4);
+        destroy_n(*target.data(), 4);
+    }
+}
+
+void relocate_no_allocations()
+{
+    std::string text(64, 'A');
+    inplace_value<std::string> source;
+    inplace_value<std::string> target;
+    construct_at(source.data(), std::move(text));
+
+    expect_no_allocations
+    {
+        relocate_at(source.data(), target.data());
+    }
+    assert(target.data()->size() == 64);
+    destroy_at(target.data());
+}
+
+void aligned_new_allocates_once()
+{
+    test_allocation::scope tracking;
+    auto pointer = detail::aligned_new<overaligned>();
+    assert(reinterpret_cast<std::uintptr_t>(pointer) % alignof(overaligned) == 0);
+    detail::aligned_delete(pointer);
+    auto result = tracking.get();
+    assert(result.allocations == 1);
+    assert(result.deallocations == 1);
+    assert(result.peak_bytes >= std::ptrdiff_t(sizeof(overaligned)));
+    assert(result.current_bytes == 0);
+}
+
+void run()
+{
+    inplace_no_allocations();
+    uninitialized_no_allocations();
+    relocate_no_allocations();
+    aligned_new_allocates_once();
+}
+
+} // namespace allocation_suite
+
+//-----------------------------------------------------------------------------
+
 int main()
 {
     construct_suite::run();
+    uninitialized_suite::run();
+    relocate_suite::run();
     inplace_storage_suite::run();
     inplace_value_suite::run();
     inplace_union_suite::run();
+    cache_padded_suite::run();
+    allocation_suite::run();
     return 0;
 }
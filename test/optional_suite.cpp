@@ -0,0 +1,351 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "test_assert.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <lean/optional.hpp>
+
+//-----------------------------------------------------------------------------
+
+struct counted
+{
+    counted() { ++constructed; }
+    counted(const counted&) { ++constructed; }
+    counted(counted&&) { ++constructed; }
+    counted& operator=(const counted&) = default;
+    counted& operator=(counted&&) = default;
+    ~counted() { ++destroyed; }
+
+    static int constructed;
+    static int destroyed;
+};
+
+int counted::constructed = 0;
+int counted::destroyed = 0;
+
+using index_type = lean::optional<std::int32_t, lean::optional_sentinel<std::int32_t, -1>>;
+using pointer_type = lean::optional<int *, lean::optional_sentinel<int *, nullptr>>;
+
+struct handle
+{
+    int value;
+};
+
+namespace lean
+{
+
+// Opt-in sentinel for all optional<handle>
+template <>
+struct optional_traits<handle>
+{
+    static constexpr handle sentinel() noexcept { return { -1 }; }
+};
+
+} // namespace lean
+
+constexpr bool operator==(const handle& lhs, const handle& rhs) noexcept
+{
+    return lhs.value == rhs.value;
+}
+
+//-----------------------------------------------------------------------------
+
+namespace optional_traits_suite
+{
+
+using namespace lean::v1;
+
+static_assert(sizeof(optional<std::int32_t>) == 2 * sizeof(std::int32_t), "");
+static_assert(sizeof(index_type) == sizeof(std::int32_t), "");
+static_assert(sizeof(pointer_type) == sizeof(int *), "");
+static_assert(sizeof(optional<handle>) == sizeof(handle), "");
+static_assert(alignof(optional<double>) == alignof(double), "");
+
+// Triviality propagation
+static_assert(std::is_trivially_copyable<optional<int>>::value, "");
+static_assert(std::is_trivially_destructible<optional<int>>::value, "");
+static_assert(std::is_trivially_copyable<index_type>::value, "");
+static_assert(std::is_trivially_destructible<index_type>::value, "");
+static_assert(!std::is_trivially_copyable<optional<std::string>>::value, "");
+static_assert(!std::is_trivially_destructible<optional<std::string>>::value, "");
+static_assert(!std::is_trivially_copyable<optional<counted>>::value, "");
+
+static_assert(lean::is_trivially_relocatable<optional<int>>::value, "");
+static_assert(lean::is_trivially_relocatable<optional<std::unique_ptr<int>>>::value, "");
+static_assert(!lean::is_trivially_relocatable<optional<counted>>::value, "");
+
+// Copy and move propagation
+static_assert(std::is_copy_constructible<optional<std::string>>::value, "");
+static_assert(!std::is_copy_constructible<optional<std::unique_ptr<int>>>::value, "");
+static_assert(!std::is_copy_assignable<optional<std::unique_ptr<int>>>::value, "");
+static_assert(std::is_move_constructible<optional<std::unique_ptr<int>>>::value, "");
+static_assert(std::is_move_assignable<optional<std::unique_ptr<int>>>::value, "");
+
+} // namespace optional_traits_suite
+
+//-----------------------------------------------------------------------------
+
+namespace optional_suite
+{
+
+using namespace lean::v1;
+
+void api_ctor_default()
+{
+    optional<int> data;
+    assert(!data);
+    assert(!data.has_value());
+    assert(data == nullopt);
+}
+
+void api_ctor_nullopt()
+{
+    optional<std::string> data(nullopt);
+    assert(!data.has_value());
+}
+
+void api_ctor_value()
+{
+    {
+        optional<int> data(42);
+        assert(data.has_value());
+        assert(*data == 42);
+    }
+    {
+        optional<std::string> data("alpha");
+        assert(data.has_value());
+        assert(*data == "alpha");
+        assert(data->size() == 5);
+    }
+}
+
+void api_ctor_inplace()
+{
+    optional<std::string> data(lean::in_place, 3, 'x');
+    assert(*data == "xxx");
+}
+
+void api_ctor_copy()
+{
+    optional<std::string> data("alpha");
+    optional<std::string> copy(data);
+    assert(*data == "alpha");
+    assert(*copy == "alpha");
+
+    optional<std::string> empty;
+    optional<std::string> empty_copy(empty);
+    assert(!empty_copy);
+}
+
+void api_ctor_move()
+{
+    optional<std::unique_ptr<int>> data(std::unique_ptr<int>(new int(42)));
+    optional<std::unique_ptr<int>> copy(std::move(data));
+    assert(**copy == 42);
+}
+
+void api_assign()
+{
+    optional<std::string> data;
+    data = std::string("alpha");
+    assert(*data == "alpha");
+    data = "bravo";
+    assert(*data == "bravo");
+    data = nullopt;
+    assert(!data);
+
+    optional<std::string> other("charlie");
+    data = other;
+    assert(*data == "charlie");
+    data = optional<std::string>();
+    assert(!data);
+}
+
+void api_emplace()
+{
+    optional<std::string> data("alpha");
+    auto& value = data.emplace(3, 'x');
+    assert(value == "xxx");
+    assert(*data == "xxx");
+}
+
+void api_reset()
+{
+    optional<int> data(42);
+    data.reset();
+    assert(!data);
+}
+
+void api_value()
+{
+    optional<int> data(42);
+    assert(data.value() == 42);
+    data.reset();
+    assert_throw_with(data.value(), bad_optional_access);
+
+    const optional<int> cdata{};
+    assert_throw_with(cdata.value(), bad_optional_access);
+}
+
+void api_value_or()
+{
+    optional<std::string> data;
+    assert(data.value_or("alpha") == "alpha");
+    data = "bravo";
+    assert(data.value_or("alpha") == "bravo");
+    assert(std::move(data).value_or("alpha") == "bravo");
+}
+
+void api_swap()
+{
+    optional<std::string> alpha("alpha");
+    optional<std::string> empty;
+    alpha.swap(empty);
+    assert(!alpha);
+    assert(*empty == "alpha");
+}
+
+void api_compare()
+{
+    optional<int> alpha(42);
+    optional<int> bravo(42);
+    optional<int> charlie(43);
+    optional<int> empty;
+    assert(alpha == bravo);
+    assert(alpha != charlie);
+    assert(alpha != empty);
+    assert(empty == optional<int>());
+    assert(alpha == 42);
+    assert(43 == charlie);
+    assert(empty != 42);
+    assert(nullopt == empty);
+    assert(alpha != nullopt);
+}
+
+void api_lifetime()
+{
+    counted::constructed = 0;
+    counted::destroyed = 0;
+    {
+        optional<counted> data;
+        assert(counted::constructed == 0);
+        data.emplace();
+        assert(counted::constructed == 1);
+        optional<counted> copy(data);
+        assert(counted::constructed == 2);
+        data.reset();
+        assert(counted::destroyed == 1);
+    }
+    assert(counted::constructed == counted::destroyed);
+}
+
+void api_make_optional()
+{
+    auto data = make_optional(42);
+    static_assert(std::is_same<decltype(data), optional<int>>::value, "");
+    assert(*data == 42);
+}
+
+void run()
+{
+    api_ctor_default();
+    api_ctor_nullopt();
+    api_ctor_value();
+    api_ctor_inplace();
+    api_ctor_copy();
+    api_ctor_move();
+    api_assign();
+    api_emplace();
+    api_reset();
+    api_value();
+    api_value_or();
+    api_swap();
+    api_compare();
+    api_lifetime();
+    api_make_optional();
+}
+
+} // namespace optional_suite
+
+//-----------------------------------------------------------------------------
+
+namespace optional_sentinel_suite
+{
+
+using namespace lean::v1;
+
+void sentinel_integer()
+{
+    index_type data;
+    assert(!data);
+    data = 0;
+    assert(data.has_value());
+    assert(*data == 0);
+    data = 42;
+    assert(*data == 42);
+    data.reset();
+    assert(!data);
+    assert_throw_with(data.value(), bad_optional_access);
+
+    // Sentinel value is the empty state
+    data = -1;
+    assert(!data);
+}
+
+void sentinel_pointer()
+{
+    int value = 42;
+    pointer_type data;
+    assert(!data);
+    data = &value;
+    assert(**data == 42);
+    data = nullopt;
+    assert(!data);
+}
+
+void sentinel_traits()
+{
+    optional<handle> data;
+    assert(!data);
+    data = handle{ 42 };
+    assert(data->value == 42);
+}
+
+void sentinel_array()
+{
+    std::vector<index_type> indices(4);
+    assert(!indices[0]);
+    indices[1] = 1;
+    auto copy = indices;
+    assert(!copy[0]);
+    assert(*copy[1] == 1);
+}
+
+void run()
+{
+    sentinel_integer();
+    sentinel_pointer();
+    sentinel_traits();
+    sentinel_array();
+}
+
+} // namespace optional_sentinel_suite
+
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    optional_suite::run();
+    optional_sentinel_suite::run();
+    return 0;
+}
@@ -0,0 +1,239 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "test_allocation.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+// Counters must be usable before and after static initialization, so they
+// are trivial thread-local data.
+thread_local test_allocation::statistics counters{};
+
+// Every block is preceded by a header with the original pointer and the
+// requested size, so deallocation knows the size without sized delete.
+struct header
+{
+    void *base;
+    std::size_t size;
+};
+
+constexpr std::size_t minimum_alignment = alignof(std::max_align_t) < sizeof(header)
+    ? sizeof(header)
+    : alignof(std::max_align_t);
+
+void *allocate(std::size_t size, std::size_t alignment) noexcept
+{
+    if (alignment < minimum_alignment)
+        alignment = minimum_alignment;
+    void *base = std::malloc(size + sizeof(header) + alignment);
+    if (!base)
+        return nullptr;
+    auto address = reinterpret_cast<std::uintptr_t>(base) + sizeof(header);
+    address = (address + alignment - 1) & ~std::uintptr_t(alignment - 1);
+    auto block = reinterpret_cast<header *>(address) - 1;
+    block->base = base;
+    block->size = size;
+
+    ++counters.allocations;
+    counters.bytes += size;
+    counters.current_bytes += std::ptrdiff_t(size);
+    if (counters.current_bytes > counters.peak_bytes)
+        counters.peak_bytes = counters.current_bytes;
+    return reinterpret_cast<void *>(address);
+}
+
+void deallocate(void *pointer) noexcept
+{
+    if (!pointer)
+        return;
+    auto block = static_cast<header *>(pointer) - 1;
+    ++counters.deallocations;
+    counters.current_bytes -= std::ptrdiff_t(block->size);
+    std::free(block->base);
+}
+
+void *allocate_or_throw(std::size_t size, std::size_t alignment)
+{
+    void *pointer = allocate(size, alignment);
+    if (!pointer)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+} // anonymous namespace
+
+namespace test_allocation
+{
+
+statistics snapshot() noexcept
+{
+    return counters;
+}
+
+scope::scope() noexcept
+    : start(counters),
+      outer_peak(counters.peak_bytes)
+{
+    // Peak is tracked from the current level within the scope
+    counters.peak_bytes = counters.current_bytes;
+}
+
+scope::~scope()
+{
+    if (outer_peak > counters.peak_bytes)
+        counters.peak_bytes = outer_peak;
+}
+
+statistics scope::get() const noexcept
+{
+    statistics result;
+    result.allocations = counters.allocations - start.allocations;
+    result.deallocations = counters.deallocations - start.deallocations;
+    result.bytes = counters.bytes - start.bytes;
+    result.current_bytes = counters.current_bytes - start.current_bytes;
+    result.peak_bytes = counters.peak_bytes - start.current_bytes;
+    return result;
+}
+
+void expectation::check() noexcept
+{
+    done = true;
+    const auto result = tracking.get();
+    const bool within_budget = (result.allocations <= budget);
+    const bool within_peak = (peak_budget < 0) || (result.peak_bytes <= peak_budget);
+    if (!within_budget || !within_peak)
+    {
+        std::fprintf(stderr,
+                     "%s:%d: %zu allocations (budget %zu), peak %td bytes (budget %td)\n",
+                     file, line,
+                     result.allocations, budget,
+                     result.peak_bytes, peak_budget);
+    }
+    assert(within_budget);
+    assert(within_peak);
+}
+
+} // namespace test_allocation
+
+//-----------------------------------------------------------------------------
+// Replacement functions
+
+void *operator new(std::size_t size)
+{
+    return allocate_or_throw(size, 0);
+}
+
+void *operator new[](std::size_t size)
+{
+    return allocate_or_throw(size, 0);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size, 0);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size, 0);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer);
+}
+
+#if __cpp_sized_deallocation >= 201309L
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+#endif
+
+#if __cpp_aligned_new >= 201606L
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, std::size_t(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, std::size_t(alignment));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, std::size_t(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate(size, std::size_t(alignment));
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer);
+}
+
+#endif
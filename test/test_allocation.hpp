@@ -0,0 +1,114 @@
+#ifndef LEAN_TEST_ALLOCATION_HPP
+#define LEAN_TEST_ALLOCATION_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Allocation tracking for tests
+//
+// Linking test-allocation replaces the global operator new and delete,
+// including the nothrow, array and aligned forms, with versions that count
+// allocations made by the calling thread.
+//
+//   expect_no_allocations
+//   {
+//       lean::unique_any any(42);
+//   }
+//
+//   expect_allocations(1)
+//   {
+//       lean::unique_any any(std::string("alpha"));
+//   }
+//
+// The block is executed once, and the assertion fails if the allocations
+// made by the block exceed the budget.
+
+#undef NDEBUG
+#include <cassert>
+#include <cstddef>
+
+namespace test_allocation
+{
+
+struct statistics
+{
+    // Number of allocations and deallocations
+    std::size_t allocations;
+    std::size_t deallocations;
+    // Number of requested bytes
+    std::size_t bytes;
+    // Bytes currently allocated
+    std::ptrdiff_t current_bytes;
+    // Highest current_bytes
+    std::ptrdiff_t peak_bytes;
+};
+
+//! @brief Returns statistics for the calling thread.
+
+statistics snapshot() noexcept;
+
+//! @brief Statistics for allocations during the lifetime of the scope.
+//!
+//! Peak bytes is measured relative to the bytes allocated when the scope was
+//! created.
+
+class scope
+{
+public:
+    scope() noexcept;
+    ~scope();
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+
+    statistics get() const noexcept;
+
+private:
+    statistics start;
+    std::ptrdiff_t outer_peak;
+};
+
+// Used by the expect macros to execute a block once and check its budget
+
+class expectation
+{
+public:
+    expectation(std::size_t budget, std::ptrdiff_t peak_budget, const char *file, int line) noexcept
+        : budget(budget),
+          peak_budget(peak_budget),
+          file(file),
+          line(line)
+    {
+    }
+
+    bool pending() const noexcept { return !done; }
+
+    void check() noexcept;
+
+private:
+    scope tracking;
+    const std::size_t budget;
+    const std::ptrdiff_t peak_budget;
+    const char *file;
+    const int line;
+    bool done = false;
+};
+
+} // namespace test_allocation
+
+#define expect_allocations_and_peak(count, peak) \
+    for (::test_allocation::expectation lean_test_expectation((count), (peak), __FILE__, __LINE__); \
+         lean_test_expectation.pending(); \
+         lean_test_expectation.check())
+
+#define expect_allocations(count) expect_allocations_and_peak(count, -1)
+#define expect_no_allocations expect_allocations_and_peak(0, 0)
+
+#endif // LEAN_TEST_ALLOCATION_HPP
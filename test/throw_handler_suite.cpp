@@ -0,0 +1,227 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Compiled without exceptions
+
+#undef NDEBUG
+#include <cassert>
+#include <csetjmp>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include <lean/any.hpp>
+#include <lean/atomic.hpp>
+#include <lean/epoch.hpp>
+#include <lean/expected.hpp>
+#include <lean/hazard_pointer.hpp>
+#include <lean/intrusive_ptr.hpp>
+#include <lean/memory.hpp>
+#include <lean/new.hpp>
+#include <lean/optional.hpp>
+#include <lean/throw.hpp>
+#include <lean/variant.hpp>
+
+static_assert(LEAN_NO_EXCEPTIONS, "Exceptions must be disabled");
+
+//-----------------------------------------------------------------------------
+
+namespace v1_throw_handler_suite
+{
+
+struct parse_error
+{
+    int line;
+    int column;
+};
+
+struct empty_error {};
+
+struct counted_error
+{
+    explicit counted_error(int) { ++constructed; }
+
+    static int constructed;
+};
+
+int counted_error::constructed = 0;
+
+std::jmp_buf environment;
+const void *handled_type = nullptr;
+parse_error handled_error = {};
+bool handled_what = false;
+bool handled_message = false;
+
+void recording_visitor(const void *exception, const char *what)
+{
+    if (handled_type == lean::throw_type_id<parse_error>())
+    {
+        handled_error = *static_cast<const parse_error *>(exception);
+    }
+    handled_what = (what != nullptr);
+}
+
+void recording_handler(const lean::throw_context& context)
+{
+    handled_type = context.type;
+    lean::throw_visit(context, recording_visitor);
+    std::longjmp(environment, 1);
+}
+
+// Inspects the arguments without constructing the exception
+void arguments_handler(const lean::throw_context& context)
+{
+    handled_type = context.type;
+    handled_error = {};
+    handled_message = false;
+    assert(lean::throw_arguments<>(context) == nullptr);
+    if (auto arguments = lean::throw_arguments<int, int>(context))
+    {
+        handled_error.line = std::get<0>(*arguments);
+        handled_error.column = std::get<1>(*arguments);
+    }
+    if (auto arguments = lean::throw_arguments<const char *>(context))
+    {
+        handled_message = (std::strcmp(std::get<0>(*arguments), "warp core failure") == 0);
+    }
+    std::longjmp(environment, 1);
+}
+
+void exiting_visitor(const void *, const char *what)
+{
+    assert(what != nullptr);
+    std::exit(EXIT_SUCCESS);
+}
+
+void exiting_handler(const lean::throw_context& context)
+{
+    assert(context.type == lean::throw_type_id<lean::bad_optional_access>());
+    lean::throw_visit(context, exiting_visitor);
+}
+
+void type_id_unique()
+{
+    static_assert(lean::throw_type_id<parse_error>() == lean::throw_type_id<parse_error>(), "");
+    assert(lean::throw_type_id<parse_error>() != lean::throw_type_id<empty_error>());
+    assert((lean::throw_arguments_id<int, int>() != lean::throw_arguments_id<int>()));
+}
+
+void handler_default()
+{
+    assert(lean::get_throw_handler() != nullptr);
+    auto old = lean::set_throw_handler(recording_handler);
+    assert(lean::get_throw_handler() == recording_handler);
+    assert(lean::set_throw_handler(old) == recording_handler);
+    assert(lean::get_throw_handler() == old);
+}
+
+void handle_with_arguments()
+{
+    lean::set_throw_handler(recording_handler);
+    if (setjmp(environment) == 0)
+    {
+        lean::throw_exception<parse_error>(12, 34);
+        assert(false);
+    }
+    assert(handled_type == lean::throw_type_id<parse_error>());
+    assert(handled_error.line == 12);
+    assert(handled_error.column == 34);
+    assert(!handled_what);
+}
+
+void handle_without_arguments()
+{
+    lean::set_throw_handler(recording_handler);
+    if (setjmp(environment) == 0)
+    {
+        lean::throw_exception<empty_error>();
+        assert(false);
+    }
+    assert(handled_type == lean::throw_type_id<empty_error>());
+    assert(!handled_what);
+}
+
+void inspect_arguments()
+{
+    lean::set_throw_handler(arguments_handler);
+    if (setjmp(environment) == 0)
+    {
+        lean::throw_exception<parse_error>(56, 78);
+        assert(false);
+    }
+    assert(handled_type == lean::throw_type_id<parse_error>());
+    assert(handled_error.line == 56);
+    assert(handled_error.column == 78);
+    assert(!handled_message);
+}
+
+void inspect_message()
+{
+    lean::set_throw_handler(arguments_handler);
+    if (setjmp(environment) == 0)
+    {
+        lean::throw_exception<std::runtime_error>("warp core failure");
+        assert(false);
+    }
+    assert(handled_type == lean::throw_type_id<std::runtime_error>());
+    assert(handled_message);
+}
+
+void inspect_without_construction()
+{
+    lean::set_throw_handler(arguments_handler);
+    counted_error::constructed = 0;
+    if (setjmp(environment) == 0)
+    {
+        lean::throw_exception<counted_error>(1);
+        assert(false);
+    }
+    assert(handled_type == lean::throw_type_id<counted_error>());
+    assert(counted_error::constructed == 0);
+
+    lean::set_throw_handler(recording_handler);
+    if (setjmp(environment) == 0)
+    {
+        lean::throw_exception<counted_error>(1);
+        assert(false);
+    }
+    assert(counted_error::constructed == 1);
+}
+
+void run()
+{
+    type_id_unique();
+    handler_default();
+    handle_with_arguments();
+    handle_without_arguments();
+    inspect_arguments();
+    inspect_message();
+    inspect_without_construction();
+}
+
+// Must be last because the handler terminates the program
+void handle_library_failure()
+{
+    lean::set_throw_handler(exiting_handler);
+    lean::optional<int> data;
+    (void)data.value();
+    assert(false);
+}
+
+} // namespace v1_throw_handler_suite
+
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    v1_throw_handler_suite::run();
+    v1_throw_handler_suite::handle_library_failure();
+    return EXIT_FAILURE;
+}
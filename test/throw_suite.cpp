@@ -10,7 +10,9 @@
 
 #include "test_assert.hpp"
 #include <cstdarg>
+#include <cstring>
 #include <stdexcept>
+#include <string>
 #include <system_error>
 #include <lean/throw.hpp>
 
@@ -162,9 +164,97 @@ void run()
 
 //-----------------------------------------------------------------------------
 
+namespace v1_throw_lazy_suite
+{
+
+int format_count = 0;
+
+std::string format_range(int value, const char *name)
+{
+    ++format_count;
+    return std::string(name) + " " + std::to_string(value) + " out of range";
+}
+
+void lazy_catch_base()
+{
+    assert_throw_with(lean::v1::throw_lazy_exception<std::out_of_range>(format_range, 42, "index"), \
+                      std::out_of_range);
+}
+
+void lazy_discarded()
+{
+    format_count = 0;
+    try
+    {
+        lean::v1::throw_lazy_exception<std::out_of_range>(format_range, 42, "index");
+    }
+    catch (const std::out_of_range&)
+    {
+    }
+    assert(format_count == 0);
+}
+
+void lazy_what()
+{
+    format_count = 0;
+    try
+    {
+        lean::v1::throw_lazy_exception<std::out_of_range>(format_range, 42, "index");
+    }
+    catch (const std::exception& error)
+    {
+        assert(std::strcmp(error.what(), "index 42 out of range") == 0);
+        assert(std::strcmp(error.what(), "index 42 out of range") == 0);
+    }
+    assert(format_count == 1);
+}
+
+void lazy_lambda()
+{
+    const std::string name = "size";
+    try
+    {
+        lean::v1::throw_lazy_exception<std::length_error>(
+            [] (const std::string& name, std::size_t size) { return name + " " + std::to_string(size); },
+            name,
+            std::size_t(7));
+    }
+    catch (const std::length_error& error)
+    {
+        assert(std::strcmp(error.what(), "size 7") == 0);
+    }
+}
+
+void lazy_failed_format()
+{
+    try
+    {
+        lean::v1::throw_lazy_exception<std::runtime_error>(
+            [] () -> std::string { throw std::bad_alloc(); });
+    }
+    catch (const std::runtime_error& error)
+    {
+        assert(std::strcmp(error.what(), "") == 0);
+    }
+}
+
+void run()
+{
+    lazy_catch_base();
+    lazy_discarded();
+    lazy_what();
+    lazy_lambda();
+    lazy_failed_format();
+}
+
+} // namespace v1_throw_lazy_suite
+
+//-----------------------------------------------------------------------------
+
 int main()
 {
     v1_throw_suite::run();
     v1_throw_traits_suite::run();
+    v1_throw_lazy_suite::run();
     return 0;
 }
@@ -0,0 +1,340 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "test_assert.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <lean/trace_buffer.hpp>
+
+#if LEAN_CXX >= LEAN_LIB_ATOMIC_WAIT
+
+//-----------------------------------------------------------------------------
+
+namespace record_suite
+{
+
+void drain_empty()
+{
+    lean::trace_buffer buffer;
+    std::size_t count = buffer.drain([] (const lean::trace_record&) { assert(false); });
+    assert(count == 0);
+}
+
+void record_fields()
+{
+    lean::trace_buffer buffer;
+    auto before = lean::trace_buffer::now();
+    assert(buffer.begin(1, 2, 3));
+    assert(buffer.end(1));
+    assert(buffer.instant(4, 5));
+
+    std::vector<lean::trace_record> records;
+    std::size_t count = buffer.drain([&records] (const lean::trace_record& item) {
+        records.push_back(item);
+    });
+    assert(count == 3);
+    assert(records.size() == 3);
+    assert(records[0].event == 1);
+    assert(records[0].phase == lean::trace_phase::begin);
+    assert(records[0].payload[0] == 2);
+    assert(records[0].payload[1] == 3);
+    assert(records[0].timestamp >= before);
+    assert(records[1].event == 1);
+    assert(records[1].phase == lean::trace_phase::end);
+    assert(records[1].timestamp >= records[0].timestamp);
+    assert(records[2].event == 4);
+    assert(records[2].phase == lean::trace_phase::instant);
+    assert(records[2].payload[0] == 5);
+    assert(records[2].payload[1] == 0);
+    assert(records[0].thread == records[2].thread);
+}
+
+void record_full()
+{
+    // Capacity is rounded up to 4
+    lean::trace_buffer buffer(3);
+    for (std::uint32_t event = 0; event < 6; ++event)
+    {
+        assert(buffer.instant(event) == (event < 4));
+    }
+    assert(buffer.dropped() == 2);
+
+    std::uint32_t expected = 0;
+    std::size_t count = buffer.drain([&expected] (const lean::trace_record& item) {
+        assert(item.event == expected++);
+    });
+    assert(count == 4);
+
+    // Drained records free the ring
+    assert(buffer.instant(6));
+    assert(buffer.drain([] (const lean::trace_record&) {}) == 1);
+}
+
+void record_wrap()
+{
+    lean::trace_buffer buffer(4);
+    std::uint32_t expected = 0;
+    for (std::uint32_t event = 0; event < 10; ++event)
+    {
+        assert(buffer.instant(event));
+        buffer.drain([&expected] (const lean::trace_record& item) {
+            assert(item.event == expected++);
+        });
+    }
+    assert(expected == 10);
+    assert(buffer.dropped() == 0);
+}
+
+void run()
+{
+    drain_empty();
+    record_fields();
+    record_full();
+    record_wrap();
+}
+
+} // namespace record_suite
+
+//-----------------------------------------------------------------------------
+
+namespace thread_suite
+{
+
+void threaded_record()
+{
+    constexpr unsigned int thread_count = 4;
+    constexpr std::uint64_t count = 10000;
+    lean::trace_buffer buffer(256);
+    std::atomic<unsigned int> done{ 0 };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back(
+            [&buffer, &done, i] {
+                for (std::uint64_t sequence = 0; sequence < count; ++sequence)
+                {
+                    buffer.instant(7, sequence, i);
+                }
+                done.fetch_add(1);
+            });
+    }
+
+    // Records from each thread arrive in order. The ring of an exited
+    // thread may be reused, so threads are identified by the payload.
+    std::vector<std::uint64_t> last(thread_count, 0);
+    std::vector<bool> seen(thread_count, false);
+    std::uint64_t total = 0;
+    auto check = [&] (const lean::trace_record& item) {
+        assert(item.event == 7);
+        assert(item.thread < thread_count);
+        auto producer = item.payload[1];
+        assert(producer < thread_count);
+        if (seen[producer])
+            assert(item.payload[0] > last[producer]);
+        seen[producer] = true;
+        last[producer] = item.payload[0];
+    };
+    while (done.load() < thread_count)
+    {
+        total += buffer.drain(check);
+    }
+    for (auto& thread : threads)
+        thread.join();
+    total += buffer.drain(check);
+
+    assert(total + buffer.dropped() == thread_count * count);
+}
+
+void thread_exit_reuse()
+{
+    lean::trace_buffer buffer;
+    std::thread first([&buffer] { buffer.instant(1); });
+    first.join();
+    std::thread second([&buffer] { buffer.instant(2); });
+    second.join();
+
+    // The ring of the exited thread is reused, but the new thread is
+    // identified separately
+    std::vector<lean::trace_record> records;
+    buffer.drain([&records] (const lean::trace_record& item) {
+        records.push_back(item);
+    });
+    assert(records.size() == 2);
+    assert(records[0].event == 1);
+    assert(records[1].event == 2);
+    assert(records[0].thread != records[1].thread);
+}
+
+void buffer_destroyed_before_thread()
+{
+    // The producer outlives the buffer and then uses a new buffer, so its
+    // thread-local entry for the destroyed buffer must not be touched.
+    auto buffer = new lean::trace_buffer;
+    std::atomic<int> stage{ 0 };
+    std::thread producer(
+        [&buffer, &stage] {
+            buffer->instant(1);
+            stage.store(1);
+            while (stage.load() != 2)
+                std::this_thread::yield();
+            lean::trace_buffer replacement;
+            replacement.instant(2);
+            std::size_t count = replacement.drain([] (const lean::trace_record& item) {
+                assert(item.event == 2);
+            });
+            assert(count == 1);
+        });
+    while (stage.load() != 1)
+        std::this_thread::yield();
+    delete buffer;
+    buffer = nullptr;
+    stage.store(2);
+    producer.join();
+}
+
+void run()
+{
+    threaded_record();
+    thread_exit_reuse();
+    buffer_destroyed_before_thread();
+}
+
+} // namespace thread_suite
+
+//-----------------------------------------------------------------------------
+
+namespace file_suite
+{
+
+const char *event_name(std::uint32_t event)
+{
+    return (event == 1) ? "parse" : nullptr;
+}
+
+std::string read_all(std::FILE *file)
+{
+    std::rewind(file);
+    std::string result;
+    char buffer[256];
+    std::size_t size;
+    while ((size = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+        result.append(buffer, size);
+    return result;
+}
+
+void collect_and_convert()
+{
+    std::FILE *trace = std::tmpfile();
+    assert(trace);
+    lean::trace_buffer buffer;
+    {
+        lean::trace_collector collector(buffer, trace, std::chrono::milliseconds(1));
+        buffer.begin(1, 42);
+        buffer.end(1);
+        buffer.instant(2, 3, 4);
+    }
+    std::rewind(trace);
+
+    std::FILE *json = std::tmpfile();
+    assert(json);
+    assert(lean::write_chrome_trace(trace, json, event_name));
+    auto text = read_all(json);
+    assert(text.find("{\"traceEvents\":[") == 0);
+    assert(text.find("\"name\":\"parse\",\"ph\":\"B\"") != std::string::npos);
+    assert(text.find("\"name\":\"parse\",\"ph\":\"E\"") != std::string::npos);
+    assert(text.find("\"name\":\"2\",\"ph\":\"i\"") != std::string::npos);
+    assert(text.find("\"args\":{\"payload0\":42,\"payload1\":0}") != std::string::npos);
+    assert(text.find("\"args\":{\"payload0\":3,\"payload1\":4}") != std::string::npos);
+    assert(text.rfind("]}\n") == text.size() - 3);
+
+    std::fclose(json);
+    std::fclose(trace);
+}
+
+const char *quoted_name(std::uint32_t event)
+{
+    switch (event)
+    {
+    case 1:
+        return "say \"hi\"";
+    case 2:
+        return "C:\\temp";
+    default:
+        return "tab\tline\n";
+    }
+}
+
+void convert_escaped()
+{
+    std::FILE *trace = std::tmpfile();
+    assert(trace);
+    lean::trace_buffer buffer;
+    {
+        lean::trace_collector collector(buffer, trace, std::chrono::milliseconds(1));
+        buffer.instant(1);
+        buffer.instant(2);
+        buffer.instant(3);
+    }
+    std::rewind(trace);
+
+    std::FILE *json = std::tmpfile();
+    assert(json);
+    assert(lean::write_chrome_trace(trace, json, quoted_name));
+    auto text = read_all(json);
+    assert(text.find("\"name\":\"say \\\"hi\\\"\",") != std::string::npos);
+    assert(text.find("\"name\":\"C:\\\\temp\",") != std::string::npos);
+    assert(text.find("\"name\":\"tab\\u0009line\\u000a\",") != std::string::npos);
+
+    std::fclose(json);
+    std::fclose(trace);
+}
+
+void convert_invalid()
+{
+    std::FILE *input = std::tmpfile();
+    assert(input);
+    std::fputs("not a trace file", input);
+    std::rewind(input);
+    std::FILE *output = std::tmpfile();
+    assert(output);
+    assert(!lean::write_chrome_trace(input, output));
+    std::fclose(output);
+    std::fclose(input);
+}
+
+void run()
+{
+    collect_and_convert();
+    convert_escaped();
+    convert_invalid();
+}
+
+} // namespace file_suite
+
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    record_suite::run();
+    thread_suite::run();
+    file_suite::run();
+    return 0;
+}
+
+#else
+
+int main () { return 0; }
+
+#endif
@@ -10,6 +10,7 @@
 
 #include "test_assert.hpp"
 #include <lean/type_traits.hpp>
+#include <lean/utility.hpp>
 
 //-----------------------------------------------------------------------------
 
@@ -408,6 +409,9 @@ static_assert(std::is_same<lean::type_element_t<0, bool&>, bool&>(), "");
 static_assert(std::is_same<lean::type_element_t<0, bool&&>, bool&&>(), "");
 static_assert(std::is_same<lean::type_element_t<0, const bool&>, const bool&>(), "");
 
+static_assert(std::is_same<lean::type_element_t<1, bool, bool, int>, bool>(), "");
+static_assert(std::is_same<lean::type_element_t<2, bool, bool, int>, int>(), "");
+
 } // namespace type_element_suite
 
 //-----------------------------------------------------------------------------
@@ -429,6 +433,18 @@ static_assert(lean::type_sizeof<int[2]>() != sizeof(int[1]), "");
 
 //-----------------------------------------------------------------------------
 
+namespace type_alignof_suite
+{
+
+static_assert(lean::type_alignof<char>() == alignof(char), "");
+static_assert(lean::type_alignof<int>() == alignof(int), "");
+static_assert(lean::type_alignof<double>() == alignof(double), "");
+static_assert(lean::type_alignof<int[2]>() == alignof(int), "");
+
+} // namespace type_alignof_suite
+
+//-----------------------------------------------------------------------------
+
 namespace type_predicate_min_suite
 {
 
@@ -511,6 +527,25 @@ static_assert( lean::type_contains<const int&&, int&, int&&, const int, const in
 
 } // namespace type_contains_suite
 
+//-----------------------------------------------------------------------------
+
+namespace type_find_suite
+{
+
+static_assert(lean::type_find<bool>() == 0, "");
+static_assert(lean::type_find<bool, bool>() == 0, "");
+static_assert(lean::type_find<bool, bool, int>() == 0, "");
+static_assert(lean::type_find<bool, int, bool>() == 1, "");
+static_assert(lean::type_find<bool, bool, bool>() == 0, "");
+
+static_assert(lean::type_find<float, bool>() == 1, "");
+static_assert(lean::type_find<float, bool, int>() == 2, "");
+
+static_assert(lean::type_find<int, int&, int&&, const int, int>() == 3, "");
+static_assert(lean::type_find<const int&, int&, int&&, const int, const int&>() == 3, "");
+
+} // namespace type_find_suite
+
 
 //-----------------------------------------------------------------------------
 
@@ -582,10 +617,55 @@ static_assert(lean::type_find_max<constant<1>, constant<2>, constant<3>>() == 2,
 static_assert(lean::type_find_max<constant<2>, constant<3>, constant<1>>() == 1, "");
 static_assert(lean::type_find_max<constant<3>, constant<1>, constant<2>>() == 0, "");
 
+// Index after the accumulated type has changed
+static_assert(lean::type_find_max_with<lean::type_sizeof, int[4], int[1], int[6], int[2], int[1]>() == 2, "");
+static_assert(lean::type_find_max<constant<1>, constant<2>, constant<0>, constant<3>, constant<0>>() == 3, "");
+
+// Across the unrolled folding steps
+static_assert(lean::type_find_max<constant<0>, constant<1>, constant<2>, constant<3>, constant<4>,
+                                  constant<9>, constant<6>, constant<7>, constant<8>, constant<5>>() == 5, "");
+static_assert(lean::type_find_max<constant<0>, constant<1>, constant<2>, constant<3>, constant<4>,
+                                  constant<5>, constant<6>, constant<7>, constant<8>, constant<9>>() == 9, "");
+
 } // namespace type_max_suite
 
 //-----------------------------------------------------------------------------
 
+namespace large_pack_suite
+{
+
+// Exceeds the default template instantiation depth of recursive algorithms
+
+constexpr std::size_t size = 1000;
+
+template <typename>
+struct large_pack;
+
+template <std::size_t... Ints>
+struct large_pack<lean::index_sequence<Ints...>>
+{
+    static constexpr bool contains_first = lean::type_contains<constant<0>, constant<Ints>...>::value;
+    static constexpr bool contains_last = lean::type_contains<constant<size - 1>, constant<Ints>...>::value;
+    static constexpr bool contains_other = lean::type_contains<constant<size>, constant<Ints>...>::value;
+
+    using last_type = lean::type_element_t<size - 1, constant<Ints>...>;
+    using max_type = lean::type_max_t<constant<Ints>...>;
+    static constexpr std::size_t max_index = lean::type_find_max<constant<Ints>...>::value;
+};
+
+using pack = large_pack<lean::make_index_sequence<size>>;
+
+static_assert(pack::contains_first, "");
+static_assert(pack::contains_last, "");
+static_assert(!pack::contains_other, "");
+static_assert(std::is_same<pack::last_type, constant<size - 1>>(), "");
+static_assert(std::is_same<pack::max_type, constant<size - 1>>(), "");
+static_assert(pack::max_index == size - 1, "");
+
+} // namespace large_pack_suite
+
+//-----------------------------------------------------------------------------
+
 namespace is_complete_suite
 {
 
@@ -671,6 +751,37 @@ static_assert(!lean::is_mutable_reference<const nontrivial(&&)[4]>::value, "no")
 
 //-----------------------------------------------------------------------------
 
+struct relocatable
+{
+    relocatable(relocatable&&) {}
+    ~relocatable() {}
+};
+
+namespace lean
+{
+
+template <>
+struct is_trivially_relocatable<relocatable> : std::true_type {};
+
+} // namespace lean
+
+namespace is_trivially_relocatable_suite
+{
+
+static_assert( lean::is_trivially_relocatable<int>::value, "yes");
+static_assert( lean::is_trivially_relocatable<const int>::value, "yes");
+static_assert( lean::is_trivially_relocatable<int *>::value, "yes");
+static_assert( lean::is_trivially_relocatable<trivial>::value, "yes");
+static_assert(!lean::is_trivially_relocatable<nontrivial>::value, "no");
+static_assert(!lean::is_trivially_relocatable<void>::value, "no");
+
+static_assert( lean::is_trivially_relocatable<relocatable>::value, "yes");
+static_assert( lean::is_trivially_relocatable<const relocatable>::value, "yes");
+
+} // namespace is_trivially_relocatable_suite
+
+//-----------------------------------------------------------------------------
+
 namespace decay_forward_suite
 {
 
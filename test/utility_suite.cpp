@@ -145,6 +145,24 @@ static_assert(std::is_same<lean::make_integer_sequence<int, 1>, lean::integer_se
 static_assert(std::is_same<lean::make_integer_sequence<int, 2>, lean::integer_sequence<int, 0, 1>>::value, "");
 static_assert(std::is_same<lean::make_integer_sequence<int, 3>, lean::integer_sequence<int, 0, 1, 2>>::value, "");
 static_assert(std::is_same<lean::make_integer_sequence<int, 4>, lean::integer_sequence<int, 0, 1, 2, 3>>::value, "");
+static_assert(std::is_same<lean::make_integer_sequence<int, 9>, lean::integer_sequence<int, 0, 1, 2, 3, 4, 5, 6, 7, 8>>::value, "");
+static_assert(std::is_same<lean::make_integer_sequence<unsigned char, 3>, lean::integer_sequence<unsigned char, 0, 1, 2>>::value, "");
+
+#if !(__cpp_lib_integer_sequence >= 201304L)
+
+// Fallback is also checked when a compiler builtin is used
+
+template <int N>
+using fallback_sequence = typename lean::detail::make_integer_sequence<std::integral_constant<int, N>>::type;
+
+static_assert(std::is_same<fallback_sequence<0>, lean::integer_sequence<int>>::value, "");
+static_assert(std::is_same<fallback_sequence<1>, lean::integer_sequence<int, 0>>::value, "");
+static_assert(std::is_same<fallback_sequence<7>, lean::integer_sequence<int, 0, 1, 2, 3, 4, 5, 6>>::value, "");
+static_assert(std::is_same<fallback_sequence<8>, lean::integer_sequence<int, 0, 1, 2, 3, 4, 5, 6, 7>>::value, "");
+static_assert(std::is_same<fallback_sequence<17>, lean::integer_sequence<int, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16>>::value, "");
+static_assert(std::is_same<fallback_sequence<4097>, lean::make_integer_sequence<int, 4097>>::value, "");
+
+#endif
 
 } // namespace integer_sequence_suite
 
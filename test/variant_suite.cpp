@@ -0,0 +1,452 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "test_assert.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#include <lean/variant.hpp>
+
+//-----------------------------------------------------------------------------
+
+struct counted
+{
+    counted() { ++constructed; }
+    counted(const counted&) { ++constructed; }
+    counted(counted&&) { ++constructed; }
+    counted& operator=(const counted&) = default;
+    counted& operator=(counted&&) = default;
+    ~counted() { ++destroyed; }
+
+    bool operator==(const counted&) const { return true; }
+
+    static int constructed;
+    static int destroyed;
+};
+
+int counted::constructed = 0;
+int counted::destroyed = 0;
+
+struct throwing
+{
+    throwing() { throw 0; }
+};
+
+template <int N>
+struct message
+{
+    int value;
+};
+
+//-----------------------------------------------------------------------------
+
+namespace variant_traits_suite
+{
+
+using namespace lean::v1;
+
+static_assert(variant_size<variant<int>>::value == 1, "");
+static_assert(variant_size<variant<int, float>>::value == 2, "");
+static_assert(variant_size<const variant<int, float>>::value == 2, "");
+
+static_assert(std::is_same<variant_alternative_t<0, variant<int, float>>, int>::value, "");
+static_assert(std::is_same<variant_alternative_t<1, variant<int, float>>, float>::value, "");
+static_assert(std::is_same<variant_alternative_t<1, const variant<int, float>>, const float>::value, "");
+
+// Smallest discriminator
+static_assert(sizeof(variant<char>) == 2 * sizeof(char), "");
+static_assert(sizeof(variant<char, bool>) == 2 * sizeof(char), "");
+static_assert(sizeof(variant<int, char>) == 2 * sizeof(int), "");
+static_assert(sizeof(variant<double, char>) == 2 * sizeof(double), "");
+
+// Same layout as a hand-written recursive union with a discriminator
+
+template <typename... Types>
+union recursive_union;
+
+template <typename T>
+union recursive_union<T>
+{
+    recursive_union() {}
+    ~recursive_union() {}
+    T head;
+};
+
+template <typename T, typename... Tail>
+union recursive_union<T, Tail...>
+{
+    recursive_union() {}
+    ~recursive_union() {}
+    T head;
+    recursive_union<Tail...> tail;
+};
+
+template <typename... Types>
+struct recursive_variant
+{
+    recursive_union<Types...> storage;
+    unsigned char index;
+};
+
+struct alignas(32) overaligned
+{
+    char data[40];
+};
+
+template <typename... Types>
+struct same_layout
+    : std::integral_constant<bool,
+                             sizeof(variant<Types...>) == sizeof(recursive_variant<Types...>) &&
+                             alignof(variant<Types...>) == alignof(recursive_variant<Types...>)>
+{
+};
+
+static_assert(same_layout<char>::value, "");
+static_assert(same_layout<int, char>::value, "");
+static_assert(same_layout<char, double, short>::value, "");
+static_assert(same_layout<int, std::string>::value, "");
+static_assert(same_layout<std::unique_ptr<int>, std::vector<int>, bool>::value, "");
+static_assert(same_layout<message<0>, message<1>, message<2>, message<3>>::value, "");
+static_assert(same_layout<char, overaligned>::value, "");
+
+// Triviality propagation
+static_assert(std::is_trivially_copyable<variant<int, float>>::value, "");
+static_assert(std::is_trivially_destructible<variant<int, float>>::value, "");
+static_assert(!std::is_trivially_copyable<variant<int, std::string>>::value, "");
+static_assert(!std::is_trivially_destructible<variant<int, std::string>>::value, "");
+static_assert(!std::is_trivially_copyable<variant<int, counted>>::value, "");
+
+static_assert(lean::is_trivially_relocatable<variant<int, float>>::value, "");
+static_assert(lean::is_trivially_relocatable<variant<int, std::unique_ptr<int>>>::value, "");
+static_assert(!lean::is_trivially_relocatable<variant<int, counted>>::value, "");
+
+// Copy and move propagation
+static_assert(std::is_copy_constructible<variant<int, std::string>>::value, "");
+static_assert(std::is_move_constructible<variant<int, std::string>>::value, "");
+static_assert(!std::is_copy_constructible<variant<int, std::unique_ptr<int>>>::value, "");
+static_assert(!std::is_copy_assignable<variant<int, std::unique_ptr<int>>>::value, "");
+static_assert(std::is_move_constructible<variant<int, std::unique_ptr<int>>>::value, "");
+static_assert(std::is_move_assignable<variant<int, std::unique_ptr<int>>>::value, "");
+
+static_assert(std::is_default_constructible<variant<int, throwing>>::value, "");
+
+} // namespace variant_traits_suite
+
+//-----------------------------------------------------------------------------
+
+namespace variant_suite
+{
+
+using namespace lean::v1;
+
+void api_ctor_default()
+{
+    variant<int, float> data;
+    assert(data.index() == 0);
+    assert(holds_alternative<int>(data));
+    assert(get<int>(data) == 0);
+}
+
+void api_ctor_value()
+{
+    {
+        variant<int, float> data(42);
+        assert(data.index() == 0);
+        assert(get<0>(data) == 42);
+    }
+    {
+        variant<int, float> data(3.0f);
+        assert(data.index() == 1);
+        assert(get<1>(data) == 3.0f);
+    }
+    {
+        std::string text = "alpha";
+        variant<int, std::string> data(text);
+        assert(data.index() == 1);
+        assert(get<std::string>(data) == "alpha");
+    }
+}
+
+void api_ctor_inplace()
+{
+#if defined(LEAN_HAS_IN_PLACE_TYPE)
+    variant<int, std::string> data(lean::in_place_type<std::string>, "alpha");
+    assert(data.index() == 1);
+    assert(get<std::string>(data) == "alpha");
+#endif
+}
+
+void api_ctor_copy()
+{
+    variant<int, std::string> data(std::string("alpha"));
+    variant<int, std::string> copy(data);
+    assert(copy.index() == 1);
+    assert(get<std::string>(data) == "alpha");
+    assert(get<std::string>(copy) == "alpha");
+}
+
+void api_ctor_move()
+{
+    variant<int, std::unique_ptr<int>> data(std::unique_ptr<int>(new int(42)));
+    variant<int, std::unique_ptr<int>> copy(std::move(data));
+    assert(copy.index() == 1);
+    assert(*get<1>(copy) == 42);
+}
+
+void api_assign_value()
+{
+    variant<int, std::string> data;
+    assert(data.index() == 0);
+    data = std::string("alpha");
+    assert(data.index() == 1);
+    data = std::string("bravo");
+    assert(get<1>(data) == "bravo");
+    data = 42;
+    assert(data.index() == 0);
+    assert(get<0>(data) == 42);
+}
+
+void api_assign_copy()
+{
+    variant<int, std::string> data(std::string("alpha"));
+    variant<int, std::string> copy(42);
+    copy = data;
+    assert(copy.index() == 1);
+    assert(get<1>(copy) == "alpha");
+    copy = variant<int, std::string>(43);
+    assert(copy.index() == 0);
+    assert(get<0>(copy) == 43);
+}
+
+void api_emplace()
+{
+    variant<int, std::string> data;
+    auto& text = data.emplace<std::string>("alpha");
+    assert(text == "alpha");
+    assert(data.index() == 1);
+    auto& number = data.emplace<0>(42);
+    assert(number == 42);
+    assert(data.index() == 0);
+}
+
+void api_emplace_parentheses()
+{
+    // Arguments are not captured by the initializer-list constructor
+    variant<int, std::vector<int>> data;
+    auto& by_type = data.emplace<std::vector<int>>(3, 1);
+    assert(by_type.size() == 3);
+    assert(by_type == std::vector<int>(3, 1));
+    data.emplace<0>(42);
+    auto& by_index = data.emplace<1>(2, 7);
+    assert(by_index == std::vector<int>(2, 7));
+#if defined(LEAN_HAS_IN_PLACE_TYPE)
+    variant<int, std::vector<int>> other(lean::in_place_type<std::vector<int>>, 3, 1);
+    assert(get<1>(other) == std::vector<int>(3, 1));
+#endif
+}
+
+void api_emplace_throw()
+{
+    variant<int, throwing> data;
+    assert_throw(data.emplace<throwing>());
+    assert(data.valueless_by_exception());
+    assert(data.index() == variant_npos);
+    assert_throw_with(get<0>(data), bad_variant_access);
+}
+
+void api_lifetime()
+{
+    counted::constructed = 0;
+    counted::destroyed = 0;
+    {
+        variant<int, counted> data;
+        data.emplace<counted>();
+        assert(counted::constructed == 1);
+        variant<int, counted> copy(data);
+        assert(counted::constructed == 2);
+        data = 42;
+        assert(counted::destroyed == 1);
+    }
+    assert(counted::constructed == counted::destroyed);
+}
+
+void api_get()
+{
+    variant<int, float> data(42);
+    assert(get<0>(data) == 42);
+    assert_throw_with(get<1>(data), bad_variant_access);
+    assert_throw_with(get<float>(data), bad_variant_access);
+
+    const variant<int, float>& cdata = data;
+    assert(get<int>(cdata) == 42);
+}
+
+void api_get_if()
+{
+    variant<int, float> data(42);
+    assert(get_if<0>(&data) != nullptr);
+    assert(*get_if<0>(&data) == 42);
+    assert(get_if<1>(&data) == nullptr);
+    assert(get_if<int>(&data) != nullptr);
+    assert(get_if<float>(&data) == nullptr);
+
+    variant<int, float> *none = nullptr;
+    assert(get_if<int>(none) == nullptr);
+}
+
+void api_swap()
+{
+    variant<int, std::string> alpha(42);
+    variant<int, std::string> bravo(std::string("bravo"));
+    alpha.swap(bravo);
+    assert(get<std::string>(alpha) == "bravo");
+    assert(get<int>(bravo) == 42);
+}
+
+void api_compare()
+{
+    variant<int, float> alpha(42);
+    variant<int, float> bravo(42);
+    variant<int, float> charlie(42.0f);
+    assert(alpha == bravo);
+    assert(alpha != charlie);
+}
+
+void run()
+{
+    api_ctor_default();
+    api_ctor_value();
+    api_ctor_inplace();
+    api_ctor_copy();
+    api_ctor_move();
+    api_assign_value();
+    api_assign_copy();
+    api_emplace();
+    api_emplace_parentheses();
+    api_emplace_throw();
+    api_lifetime();
+    api_get();
+    api_get_if();
+    api_swap();
+    api_compare();
+}
+
+} // namespace variant_suite
+
+//-----------------------------------------------------------------------------
+
+namespace visit_suite
+{
+
+using namespace lean::v1;
+
+struct index_visitor
+{
+    int operator()(int) const { return 0; }
+    int operator()(float) const { return 1; }
+    int operator()(const std::string&) const { return 2; }
+};
+
+struct reference_visitor
+{
+    int operator()(int&) const { return 0; }
+    int operator()(const int&) const { return 1; }
+    int operator()(int&&) const { return 2; }
+};
+
+struct message_visitor
+{
+    template <int N>
+    int operator()(const message<N>& msg) const { return N + msg.value; }
+};
+
+void visit_value()
+{
+    variant<int, float, std::string> data;
+    assert(visit(index_visitor{}, data) == 0);
+    data = 1.0f;
+    assert(visit(index_visitor{}, data) == 1);
+    data = std::string("alpha");
+    assert(visit(index_visitor{}, data) == 2);
+}
+
+void visit_reference()
+{
+    variant<int> data;
+    const variant<int>& cdata = data;
+    assert(visit(reference_visitor{}, data) == 0);
+    assert(visit(reference_visitor{}, cdata) == 1);
+    assert(visit(reference_visitor{}, std::move(data)) == 2);
+}
+
+void visit_mutate()
+{
+    struct increment
+    {
+        void operator()(int& value) const { ++value; }
+        void operator()(std::string& value) const { value += "!"; }
+    };
+
+    variant<int, std::string> data(42);
+    visit(increment{}, data);
+    assert(get<int>(data) == 43);
+}
+
+void visit_valueless()
+{
+    variant<int, throwing> data;
+    assert_throw(data.emplace<throwing>());
+    struct visitor
+    {
+        void operator()(int) const {}
+        void operator()(const throwing&) const {}
+    };
+    assert_throw_with(visit(visitor{}, data), bad_variant_access);
+}
+
+void visit_many()
+{
+    using type = variant<message<0>, message<1>, message<2>, message<3>, message<4>,
+                         message<5>, message<6>, message<7>, message<8>, message<9>,
+                         message<10>, message<11>, message<12>, message<13>, message<14>,
+                         message<15>, message<16>, message<17>, message<18>, message<19>,
+                         message<20>, message<21>, message<22>, message<23>, message<24>,
+                         message<25>, message<26>, message<27>, message<28>, message<29>>;
+    static_assert(sizeof(type) == 2 * sizeof(int), "");
+    static_assert(std::is_trivially_copyable<type>::value, "");
+
+    type data;
+    assert(visit(message_visitor{}, data) == 0);
+    data = message<17>{ 100 };
+    assert(data.index() == 17);
+    assert(visit(message_visitor{}, data) == 117);
+    data.emplace<29>(message<29>{ 200 });
+    assert(visit(message_visitor{}, data) == 229);
+}
+
+void run()
+{
+    visit_value();
+    visit_reference();
+    visit_mutate();
+    visit_valueless();
+    visit_many();
+}
+
+} // namespace visit_suite
+
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    variant_suite::run();
+    visit_suite::run();
+    return 0;
+}
@@ -0,0 +1,280 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2021 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "test_assert.hpp"
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <lean/wait_statistics.hpp>
+
+#if LEAN_CXX >= LEAN_LIB_ATOMIC_WAIT && defined(LEAN_DETAIL_LINUX_FUTEX_HPP) && LEAN_WAIT_STATISTICS
+
+//-----------------------------------------------------------------------------
+
+namespace counters_suite
+{
+
+void counters_empty()
+{
+    lean::wait_counters counters("empty");
+    auto result = counters.snapshot();
+    assert(std::strcmp(result.name, "empty") == 0);
+    assert(result.waits == 0);
+    assert(result.wait_syscalls == 0);
+    assert(result.p99_wait_nanoseconds == 0);
+    assert(result.notifies == 0);
+}
+
+void counters_registered()
+{
+    lean::wait_counters counters("registered");
+    bool found = false;
+    for (const auto& item : lean::snapshot_wait_statistics())
+    {
+        if (std::strcmp(item.name, "registered") == 0)
+            found = true;
+    }
+    assert(found);
+}
+
+void counters_unregistered()
+{
+    {
+        lean::wait_counters counters("unregistered");
+    }
+    for (const auto& item : lean::snapshot_wait_statistics())
+    {
+        assert(std::strcmp(item.name, "unregistered") != 0);
+    }
+}
+
+void run()
+{
+    counters_empty();
+    counters_registered();
+    counters_unregistered();
+}
+
+} // namespace counters_suite
+
+//-----------------------------------------------------------------------------
+
+namespace notify_suite
+{
+
+void notify_without_waiter()
+{
+    lean::wait_counters counters("notify");
+    lean::atomic<int> shared{ 0 };
+    shared.set_wait_counters(counters);
+
+    shared.notify_one();
+    shared.notify_all();
+
+    auto result = counters.snapshot();
+    assert(result.notifies == 2);
+    assert(result.notifies_without_waiters == 2);
+    assert(result.wake_syscalls == 0);
+}
+
+void notify_global()
+{
+    auto& counters = lean::wait_counters::global();
+    auto before = counters.snapshot().notifies;
+    lean::atomic<int> shared{ 0 };
+
+    shared.notify_one();
+
+    assert(counters.snapshot().notifies == before + 1);
+}
+
+void notify_scope()
+{
+    lean::wait_counters attached("attached");
+    lean::wait_counters outer("outer");
+    lean::wait_counters inner("inner");
+    lean::atomic<int> shared{ 0 };
+    shared.set_wait_counters(attached);
+    {
+        lean::wait_scope outer_scope(outer);
+        shared.notify_one();
+        {
+            lean::wait_scope inner_scope(inner);
+            shared.notify_one();
+        }
+        shared.notify_one();
+    }
+    shared.notify_one();
+
+    assert(attached.snapshot().notifies == 1);
+    assert(outer.snapshot().notifies == 2);
+    assert(inner.snapshot().notifies == 1);
+}
+
+void run()
+{
+    notify_without_waiter();
+    notify_global();
+    notify_scope();
+}
+
+} // namespace notify_suite
+
+//-----------------------------------------------------------------------------
+
+namespace wait_suite
+{
+
+void wait_ready()
+{
+    // Value already changed, so the futex is not used
+    lean::wait_counters counters("ready");
+    lean::atomic<int> shared{ 1 };
+    shared.set_wait_counters(counters);
+
+    shared.wait(0);
+
+    assert(counters.snapshot().waits == 0);
+}
+
+void threaded_ping_pong()
+{
+    constexpr int rounds = 1000;
+    lean::wait_counters counters("ping_pong");
+    lean::atomic<int> shared{ 0 };
+    shared.set_wait_counters(counters);
+
+    std::thread thread(
+        [&] {
+            for (int turn = 1; turn < 2 * rounds; turn += 2)
+            {
+                shared.wait(turn - 1);
+                shared.store(turn + 1);
+                shared.notify_one();
+            }
+        });
+
+    for (int turn = 0; turn < 2 * rounds; turn += 2)
+    {
+        shared.store(turn + 1);
+        shared.notify_one();
+        shared.wait(turn + 1);
+    }
+    thread.join();
+
+    auto result = counters.snapshot();
+    assert(result.notifies == 2 * rounds);
+    assert(result.wake_syscalls + result.notifies_without_waiters == result.notifies);
+    assert(result.waits <= 2 * rounds);
+    assert(result.spurious_wakeups <= result.wait_syscalls);
+    assert(result.max_wait_nanoseconds <= result.wait_nanoseconds);
+    assert(counters.wait_durations().count() == result.waits);
+    assert(result.p50_wait_nanoseconds <= result.p99_wait_nanoseconds);
+}
+
+void threaded_wait_blocked()
+{
+    lean::wait_counters counters("blocked");
+    lean::atomic<int> shared{ 0 };
+    shared.set_wait_counters(counters);
+
+    std::thread thread(
+        [&] {
+            shared.wait(0);
+        });
+    // Give the waiter time to block
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    shared.store(1);
+    shared.notify_one();
+    thread.join();
+
+    auto result = counters.snapshot();
+    assert(result.notifies == 1);
+    if (result.waits == 1)
+    {
+        assert(result.wait_syscalls >= 1);
+        assert(result.wait_nanoseconds > 0);
+        assert(result.max_wait_nanoseconds == result.wait_nanoseconds);
+        // Percentiles are bucket upper bounds
+        assert(result.p50_wait_nanoseconds >= result.wait_nanoseconds);
+        assert(result.p99_wait_nanoseconds == result.p50_wait_nanoseconds);
+    }
+}
+
+void run()
+{
+    wait_ready();
+    threaded_ping_pong();
+    threaded_wait_blocked();
+}
+
+} // namespace wait_suite
+
+//-----------------------------------------------------------------------------
+
+namespace report_suite
+{
+
+void dump_named()
+{
+    lean::wait_counters counters("dumped");
+    std::FILE *output = std::tmpfile();
+    assert(output);
+
+    lean::dump_wait_statistics(output);
+
+    std::rewind(output);
+    char buffer[256];
+    bool found = false;
+    while (std::fgets(buffer, sizeof(buffer), output))
+    {
+        if (std::strncmp(buffer, "dumped: waits=0 ", 16) == 0)
+            found = true;
+    }
+    assert(found);
+    std::fclose(output);
+}
+
+void reporter_final_dump()
+{
+    lean::wait_counters counters("reported");
+    std::FILE *output = std::tmpfile();
+    assert(output);
+    {
+        lean::wait_statistics_reporter reporter(std::chrono::milliseconds(1), output);
+    }
+    assert(std::ftell(output) > 0);
+    std::fclose(output);
+}
+
+void run()
+{
+    dump_named();
+    reporter_final_dump();
+}
+
+} // namespace report_suite
+
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    counters_suite::run();
+    notify_suite::run();
+    wait_suite::run();
+    report_suite::run();
+    return 0;
+}
+
+#else
+
+int main () { return 0; }
+
+#endif